@@ -0,0 +1,68 @@
+-- Headless benchmarks, one console app per source file in src/. They print their timings and need no window or GL context:
+--   bin/Release/Benchmarks/BVHBenchmark
+local function benchmark(name)
+
+	project(name)
+
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+    targetdir "%{wks.location}/bin/%{cfg.buildcfg}/Benchmarks"
+	objdir "%{wks.location}/obj/%{cfg.buildcfg}/Benchmarks/%{prj.name}"
+
+	files {
+		"src/" .. name .. ".cpp",
+		"src/Benchmark.h"
+	}
+	
+	includedirs {
+		"%{wks.location}/Engine/include",
+        "%{wks.location}/Engine/include/vendor",
+		"%{wks.location}/Engine/vendor/assimp/include",
+        "%{wks.location}/Engine/vendor/maths",
+		"%{wks.location}/Engine/vendor/stb_image/include",
+		"%{wks.location}/Engine/vendor"
+	}
+	
+	libdirs {
+		"%{wks.location}/bin/Debug"
+	}
+	
+	links {
+		"GameEngine",
+		"GL",
+		"glfw",
+		"GLEW",
+		"openal",
+		"freetype",
+		"assimp",
+		"pthread",
+		"yaml-cpp",
+		"lua",
+		"mono-2.0",
+		"dl",
+		"box2d"
+	}
+	
+	filter "configurations:Debug"
+        defines "ENGINE_DEBUG"
+        runtime "Release"
+        symbols "On"
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "On"
+
+	filter {}
+
+end
+
+benchmark "BVHBenchmark"
+benchmark "JobSystemBenchmark"
+benchmark "MeshCacheBenchmark"
+benchmark "LightClusterBenchmark"
+benchmark "ComponentBenchmark"
+benchmark "SpawnBenchmark"
+benchmark "ColdStartBenchmark"
+benchmark "TransformBenchmark"
\ No newline at end of file
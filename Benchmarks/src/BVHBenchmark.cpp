@@ -0,0 +1,183 @@
+#include "Benchmark.h"
+
+#include <scene/BoundingVolumeHierarchy.h>
+#include <renderer/Frustum.h>
+#include <maths/math.h>
+
+#include <cstdlib>
+#include <random>
+
+using namespace Engine;
+
+// Boxes of 0.5 to 2 units scattered through a cube that grows with the count, so density stays the same
+static std::vector<AABB> makeBoxes(uint32_t count, std::mt19937& random)
+{
+    float extent = 10.f * std::cbrt(static_cast<float>(count));
+
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> size(0.25f, 1.f);
+
+    std::vector<AABB> boxes(count);
+
+    for (auto& box : boxes)
+    {
+        math::vec3 center(position(random), position(random), position(random));
+        math::vec3 half(size(random), size(random), size(random));
+
+        box.expand(math::vec3(center.x - half.x, center.y - half.y, center.z - half.z));
+        box.expand(math::vec3(center.x + half.x, center.y + half.y, center.z + half.z));
+    }
+
+    return boxes;
+}
+
+// The tree never dereferences its objects, so indices stand in for game objects
+static GameObject* toObject(uint32_t index)
+{
+    return reinterpret_cast<GameObject*>(static_cast<uintptr_t>(index) + 1);
+}
+
+// Compares the tree against testing every box, for the queries Renderer3D and the editor make each frame:
+//   BVHBenchmark [largest object count]
+int main(int argc, char** argv)
+{
+    uint32_t maxCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+
+    std::mt19937 random(42);
+
+    for (uint32_t count = 10000; count <= maxCount; count *= 10)
+    {
+        std::cout << "\n" << count << " objects\n";
+
+        std::vector<AABB> boxes = makeBoxes(count, random);
+        float extent = 10.f * std::cbrt(static_cast<float>(count));
+
+        BoundingVolumeHierarchy tree;
+        std::vector<uint32_t> proxies(count);
+
+        Benchmark::run("build (incremental insert)", 1, [&]()
+        {
+            tree = BoundingVolumeHierarchy();
+
+            for (uint32_t i = 0; i < count; i++)
+            {
+                proxies[i] = tree.insert(boxes[i], toObject(i));
+            }
+        });
+
+        std::vector<GameObject*> visible;
+
+        // A camera at the edge of the scene looking across it, seeing a fraction of the objects up to 'far'.
+        // Returns false if the tree and brute force disagree, in which case the timings mean nothing.
+        auto compareFrustum = [&](const std::string& name, float far)
+        {
+            math::mat4 projection = math::perspective(static_cast<float>(math::radians(60.f)), 16.f / 9.f, 0.1f, far);
+            math::mat4 view = math::lookAt(math::vec3(0.f, 0.f, extent), math::vec3(0.f), math::vec3(0.f, 1.f, 0.f));
+            Frustum frustum = Frustum::fromMatrix(projection * view);
+
+            uint32_t bruteVisible = 0;
+
+            double brute = Benchmark::run(name + ", brute force", 10, [&]()
+            {
+                bruteVisible = 0;
+
+                for (const auto& box : boxes)
+                {
+                    bruteVisible += frustum.intersects(box);
+                }
+
+                Benchmark::sink += bruteVisible;
+            });
+
+            double bvh = Benchmark::run(name + ", tree", 10, [&]()
+            {
+                visible.clear();
+                tree.queryFrustum(frustum, visible);
+
+                Benchmark::sink += visible.size();
+            });
+
+            Benchmark::speedup(name + " speedup (" + std::to_string(bruteVisible) + " visible)", brute, bvh);
+
+            if (visible.size() != bruteVisible)
+            {
+                std::cout << "Mismatch: the tree found " << visible.size() << " objects, brute force " << bruteVisible << "\n";
+                return false;
+            }
+
+            return true;
+        };
+
+        if (!compareFrustum("frustum, whole scene depth", extent * 2.f) || !compareFrustum("frustum, 100 unit draw distance", 100.f))
+        {
+            return 1;
+        }
+
+        // Overlap queries around a few hundred points, like gameplay sphere checks
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::vector<BoundingSphere> spheres(256);
+
+        for (auto& sphere : spheres)
+        {
+            sphere.center = math::vec3(position(random), position(random), position(random));
+            sphere.radius = 10.f;
+        }
+
+        double brute = Benchmark::run("256 sphere queries, brute force", 5, [&]()
+        {
+            for (const auto& sphere : spheres)
+            {
+                for (const auto& box : boxes)
+                {
+                    math::vec3 closest(std::max(box.min.x, std::min(sphere.center.x, box.max.x)),
+                                       std::max(box.min.y, std::min(sphere.center.y, box.max.y)),
+                                       std::max(box.min.z, std::min(sphere.center.z, box.max.z)));
+
+                    float x = closest.x - sphere.center.x, y = closest.y - sphere.center.y, z = closest.z - sphere.center.z;
+                    Benchmark::sink += x * x + y * y + z * z <= sphere.radius * sphere.radius;
+                }
+            }
+        });
+
+        double bvh = Benchmark::run("256 sphere queries, tree", 5, [&]()
+        {
+            for (const auto& sphere : spheres)
+            {
+                visible.clear();
+                tree.querySphere(sphere, visible);
+
+                Benchmark::sink += visible.size();
+            }
+        });
+
+        Benchmark::speedup("sphere query speedup", brute, bvh);
+
+        // Picking: the closest box along a ray, which brute force can only find by testing all of them
+        Benchmark::run("256 ray casts, tree", 5, [&]()
+        {
+            for (const auto& sphere : spheres)
+            {
+                math::vec3 direction = math::normalize(math::vec3(-sphere.center.x, -sphere.center.y, extent - sphere.center.z));
+                Benchmark::sink += reinterpret_cast<uintptr_t>(tree.raycast(sphere.center, direction, extent * 4.f));
+            }
+        });
+
+        // A tenth of the objects moving a little each frame, most of them staying inside their fat boxes
+        std::uniform_real_distribution<float> step(-0.2f, 0.2f);
+
+        Benchmark::run("move 10% of the objects", 5, [&]()
+        {
+            for (uint32_t i = 0; i < count; i += 10)
+            {
+                math::vec3 offset(step(random), step(random), step(random));
+
+                boxes[i].min = math::vec3(boxes[i].min.x + offset.x, boxes[i].min.y + offset.y, boxes[i].min.z + offset.z);
+                boxes[i].max = math::vec3(boxes[i].max.x + offset.x, boxes[i].max.y + offset.y, boxes[i].max.z + offset.z);
+
+                Benchmark::sink += tree.move(proxies[i], boxes[i]);
+            }
+        });
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <util/Timer.h>
+
+// Shared by the benchmarks in this directory. Each one is a console app printing a line per measurement.
+namespace Benchmark
+{
+
+// Results are added to this, so the work producing them isn't optimized away
+inline volatile uint64_t sink = 0;
+
+// Runs 'function' 'runs' times after one warm up run, calling 'setup' untimed before each. Prints and returns the
+// median time in milliseconds.
+template<typename S, typename F>
+double run(const std::string& name, uint32_t runs, S&& setup, F&& function)
+{
+    setup();
+    function();
+
+    std::vector<double> times;
+    times.reserve(runs);
+
+    for (uint32_t i = 0; i < runs; i++)
+    {
+        setup();
+
+        Engine::Timer timer;
+        function();
+        times.push_back(timer.getMillis());
+    }
+
+    std::sort(times.begin(), times.end());
+    double median = times[times.size() / 2];
+
+    std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(3)
+              << " median " << std::setw(10) << median << "ms  min " << std::setw(10) << times.front() << "ms\n";
+
+    return median;
+}
+
+template<typename F>
+double run(const std::string& name, uint32_t runs, F&& function)
+{
+    return run(name, runs, []() {}, std::forward<F>(function));
+}
+
+// Prints how much faster 'time' is than 'baseline'
+inline void speedup(const std::string& name, double baseline, double time)
+{
+    std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(2)
+              << " " << baseline / std::max(time, 1e-6) << "x\n";
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "Benchmark.h"
+
+#include <util/io/FileSystem.h>
+#include <util/io/PackArchive.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include <unistd.h>
+
+using namespace Engine;
+
+// Evicts every file from the page cache, so reads hit the disk as on a fresh boot. Linux only, and needs root.
+static bool dropCaches()
+{
+    // Only clean pages are dropped, the files just written would otherwise stay cached
+    sync();
+
+    std::ofstream file("/proc/sys/vm/drop_caches");
+    file << "3\n";
+    file.flush();
+
+    return static_cast<bool>(file);
+}
+
+// Half text-like files, which compress, and half noise, which doesn't, of 4 to 64KB each
+static std::vector<PackSource> generateFiles(const std::filesystem::path& directory, uint32_t count)
+{
+    std::mt19937 random(42);
+    std::uniform_int_distribution<uint32_t> size(4 * 1024, 64 * 1024);
+
+    const char* words[] = { "vertex ", "uniform ", "material: ", "0.500000 ", "texture ", "\n", "  - ", "float " };
+    std::vector<PackSource> files;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        std::string name = "assets/" + std::to_string(i % 16) + "/file" + std::to_string(i) + (i % 2 ? ".bin" : ".txt");
+        std::filesystem::path path = directory / name;
+
+        std::filesystem::create_directories(path.parent_path());
+
+        std::string data;
+        uint32_t length = size(random);
+
+        while (data.size() < length)
+        {
+            data += i % 2 ? static_cast<char>(random()) : *words[random() % 8];
+            data += i % 2 ? "" : words[random() % 8];
+        }
+
+        std::ofstream(path, std::ios::binary).write(data.data(), data.size());
+        files.push_back({ name, path.string() });
+    }
+
+    return files;
+}
+
+// Reading every asset at startup from loose files against one mounted archive. Pass --cold, as root, to drop the page
+// cache before every run, otherwise both read from memory and only the per file overhead is compared.
+//   ColdStartBenchmark [--cold] [asset directory...]
+// Without directories, a few thousand generated files stand in for a game's assets.
+int main(int argc, char** argv)
+{
+    bool cold = false;
+    std::vector<std::string> directories;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--cold") == 0)
+        {
+            cold = true;
+        }
+        else
+        {
+            directories.push_back(argv[i]);
+        }
+    }
+
+    std::filesystem::path temporary = std::filesystem::temp_directory_path() / "ColdStartBenchmark";
+    std::filesystem::remove_all(temporary);
+    std::filesystem::create_directories(temporary);
+
+    std::vector<PackSource> files;
+
+    if (directories.empty())
+    {
+        files = generateFiles(temporary, 4000);
+    }
+
+    for (const auto& directory : directories)
+    {
+        std::error_code error;
+
+        for (auto& file : std::filesystem::recursive_directory_iterator(directory, error))
+        {
+            if (file.is_regular_file(error))
+            {
+                files.push_back({ file.path().generic_string(), file.path().string() });
+            }
+        }
+    }
+
+    std::string archive = (temporary / "assets.pak").string();
+    PackStatistics statistics;
+
+    if (files.empty() || !PackArchive::build(archive, files, &statistics))
+    {
+        std::cout << "Could not pack the assets\n";
+        return 1;
+    }
+
+    std::cout << statistics.files << " files, " << statistics.size << " bytes, " << statistics.storedSize << " bytes packed\n";
+
+    if (cold && !dropCaches())
+    {
+        std::cout << "Could not drop the page cache, timing warm reads instead\n";
+        cold = false;
+    }
+
+    FileView view;
+
+    // The view's archive is let go as well, pages still mapped aren't dropped from the cache
+    auto setup = [cold, &view]()
+    {
+        FileSystem::unmountAll();
+        view = FileView();
+
+        if (cold)
+        {
+            dropCaches();
+        }
+    };
+
+    std::string mode = cold ? "cold" : "warm";
+
+    // Touches every page, as using the data would, views into the archive are only read from disk then
+    auto use = [&view]()
+    {
+        for (size_t i = 0; i < view.size; i += 4096)
+        {
+            Benchmark::sink += view.data[i];
+        }
+    };
+
+    // Loose files are read from their own paths, the archive's copies under the paths they were packed as
+    double loose = Benchmark::run("read every file, loose, " + mode, 5, setup, [&]()
+    {
+        for (const auto& file : files)
+        {
+            FileSystem::readView(file.filePath, view);
+            use();
+        }
+    });
+
+    double packed = Benchmark::run("mount and read every file, archive, " + mode, 5, setup, [&]()
+    {
+        FileSystem::mount(archive);
+
+        for (const auto& file : files)
+        {
+            if (!FileSystem::readView(file.archivePath, view))
+            {
+                std::cout << "Missing from the archive: " << file.archivePath << "\n";
+            }
+
+            use();
+        }
+    });
+
+    Benchmark::speedup("  speedup", loose, packed);
+
+    FileSystem::unmountAll();
+    std::filesystem::remove_all(temporary);
+
+    return 0;
+}
\ No newline at end of file
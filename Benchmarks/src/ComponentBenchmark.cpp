@@ -0,0 +1,219 @@
+#include "Benchmark.h"
+
+#include <scene/GameObject.h>
+#include <scene/SceneView.h>
+#include <util/Transform.h>
+
+#include <cstdlib>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace Engine;
+
+// Plain data components, so the timings are of reaching the components rather than of the work done on them
+class Body : public GameComponent
+{
+public:
+    float position[3] = {};
+    float velocity[3] = {};
+};
+
+class Health : public GameComponent
+{
+public:
+    float value = 100.f;
+    float regeneration = 0.f;
+};
+
+// The layout components had before the pools: allocated one by one and found by hashing their typeid
+struct MapObject
+{
+    std::unordered_map<std::type_index, GameComponent*> components;
+    std::vector<MapObject*> children;
+
+    ~MapObject()
+    {
+        for (auto& [type, component] : components)
+        {
+            delete component;
+        }
+
+        for (auto child : children)
+        {
+            delete child;
+        }
+    }
+
+    template<typename T>
+    T* getComponent()
+    {
+        auto it = components.find(typeid(T));
+        return it != components.end() ? static_cast<T*>(it->second) : nullptr;
+    }
+};
+
+static void step(Body& body, float delta)
+{
+    for (uint32_t axis = 0; axis < 3; axis++)
+    {
+        body.position[axis] += body.velocity[axis] * delta;
+    }
+}
+
+static void step(Body& body, Health& health, float delta)
+{
+    step(body, delta);
+    health.value += health.regeneration * delta;
+}
+
+// Walks the hierarchy the way Scene's render and update passes did
+static void recurse(MapObject* object, float delta)
+{
+    Body* body = object->getComponent<Body>();
+    Health* health = object->getComponent<Health>();
+
+    if (body && health)
+    {
+        step(*body, *health, delta);
+    }
+
+    for (auto child : object->children)
+    {
+        recurse(child, delta);
+    }
+}
+
+static void recurse(GameObject* object, float delta)
+{
+    Body* body = object->getComponent<Body>();
+    Health* health = object->getComponent<Health>();
+
+    if (body && health)
+    {
+        step(*body, *health, delta);
+    }
+
+    for (auto child : object->getChildren())
+    {
+        recurse(child, delta);
+    }
+}
+
+// Iterating components in the pools against the map of pointers each game object used to hold. Every object has a
+// Body, half of them a Health too. Objects are created in a shuffled order, as a scene edited over time creates them.
+//   ComponentBenchmark [largest object count]
+int main(int argc, char** argv)
+{
+    uint32_t maxCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    constexpr float DELTA = 1.f / 60.f;
+
+    std::mt19937 random(42);
+
+    for (uint32_t count = 1000; count <= maxCount; count *= 10)
+    {
+        std::cout << "\n" << count << " objects\n";
+
+        // Decides which objects get a Health and their velocities, so neither follows the creation order
+        std::vector<uint32_t> order(count);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            order[i] = i;
+        }
+
+        std::shuffle(order.begin(), order.end(), random);
+
+        MapObject* mapRoot = new MapObject();
+        std::vector<MapObject*> mapObjects;
+
+        GameObject root;
+        std::vector<GameObject*> objects;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            // Any earlier object can be the parent, so the hierarchy is several levels deep rather than a flat list
+            uint32_t parent = i > 0 ? random() % i : 0;
+            bool hasHealth = order[i] % 2 == 0;
+
+            MapObject* mapObject = new MapObject();
+            (i > 0 ? mapObjects[parent] : mapRoot)->children.push_back(mapObject);
+            mapObjects.push_back(mapObject);
+
+            GameObject* object = (i > 0 ? objects[parent] : &root)->createChild();
+            objects.push_back(object);
+
+            // createChild() gives every object a Transform, so the maps hold one as well
+            mapObject->components[typeid(Transform)] = new GameComponent();
+
+            Body* mapBody = new Body();
+            Body* body = object->createComponent<Body>();
+
+            mapBody->velocity[0] = body->velocity[0] = static_cast<float>(order[i]);
+            mapObject->components[typeid(Body)] = mapBody;
+
+            if (hasHealth)
+            {
+                Health* mapHealth = new Health();
+                Health* health = object->createComponent<Health>();
+
+                mapHealth->regeneration = health->regeneration = 1.f;
+                mapObject->components[typeid(Health)] = mapHealth;
+            }
+        }
+
+        double baseline = Benchmark::run("hierarchy walk, map of pointers", 10, [&]()
+        {
+            recurse(mapRoot, DELTA);
+        });
+
+        double walk = Benchmark::run("hierarchy walk, pools", 10, [&]()
+        {
+            recurse(&root, DELTA);
+        });
+
+        Benchmark::speedup("  speedup", baseline, walk);
+
+        auto& view = root.getStorage().view<Body, Health>();
+
+        double viewed = Benchmark::run("SceneView<Body, Health>", 10, [&]()
+        {
+            for (auto object : view)
+            {
+                step(*object->getComponent<Body>(), *object->getComponent<Health>(), DELTA);
+            }
+        });
+
+        Benchmark::speedup("  speedup", baseline, viewed);
+
+        // A system touching a single component type never needs the game objects at all
+        double pooled = Benchmark::run("Body pool in memory order", 10, [&]()
+        {
+            root.getStorage().each<Body>([](Body& body)
+            {
+                step(body, DELTA);
+            });
+        });
+
+        Benchmark::speedup("  speedup", baseline, pooled);
+
+        float sum = 0.f;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            sum += objects[i]->getComponent<Body>()->position[0] - mapObjects[i]->getComponent<Body>()->position[0];
+        }
+
+        Benchmark::sink += static_cast<uint64_t>(sum);
+
+        // Children keep their storage alive, so the root's storage is only freed once they are gone
+        while (!root.getChildren().empty())
+        {
+            root.removeChild(root.getChildren().back());
+        }
+
+        delete mapRoot;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "Benchmark.h"
+
+#include <core/JobSystem.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace Engine;
+
+using Clock = std::chrono::steady_clock;
+
+// Stands in for a small piece of real work, roughly 'iterations' multiply-adds
+static float work(uint32_t seed, uint32_t iterations)
+{
+    float value = static_cast<float>(seed);
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        value = value * 0.999f + 1.f;
+    }
+
+    return value;
+}
+
+// Job throughput for empty and small jobs, parallelFor scaling against a plain loop, and the latency from queueing a
+// job to it starting on an idle worker:
+//   JobSystemBenchmark [worker count]
+int main(int argc, char** argv)
+{
+    auto jobs = JobSystem::getInstance();
+    jobs->initialize(argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 0);
+
+    std::cout << jobs->getThreadCount() << " threads\n";
+
+    constexpr uint32_t JOB_COUNT = 100000;
+
+    // Each job writes its own result, so the jobs don't contend for anything but the queues
+    std::vector<float> results(JOB_COUNT);
+
+    for (uint32_t iterations : { 0u, 100u, 1000u })
+    {
+        double time = Benchmark::run(std::to_string(JOB_COUNT) + " jobs of " + std::to_string(iterations) + " iterations", 5, [&]()
+        {
+            JobCounter counter;
+
+            for (uint32_t i = 0; i < JOB_COUNT; i++)
+            {
+                jobs->execute([&results, i, iterations]() { results[i] = work(i, iterations); }, &counter);
+            }
+
+            jobs->wait(counter);
+        });
+
+        std::cout << "  " << JOB_COUNT / time / 1000.0 << " million jobs per second\n";
+    }
+
+    // Jobs queued from inside jobs, as systems fanning out work do, spread across the workers' own queues
+    Benchmark::run("100 jobs queueing 1000 jobs each", 5, [&]()
+    {
+        JobCounter counter;
+
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            jobs->execute([&counter, &results, jobs, i]()
+            {
+                for (uint32_t j = 0; j < 1000; j++)
+                {
+                    uint32_t index = i * 1000 + j;
+                    jobs->execute([&results, index]() { results[index] = work(index, 100); }, &counter);
+                }
+            }, &counter);
+        }
+
+        jobs->wait(counter);
+    });
+
+    // A chain of dependent jobs never occupies a worker while it waits
+    Benchmark::run("chain of 1000 dependent jobs", 5, [&]()
+    {
+        std::vector<JobCounter> counters(1000);
+
+        jobs->execute([&results]() { results[0] = 0.f; }, &counters[0]);
+
+        for (uint32_t i = 1; i < counters.size(); i++)
+        {
+            jobs->executeAfter(counters[i - 1], [&results, i]() { results[i] = results[i - 1] + 1.f; }, &counters[i]);
+        }
+
+        jobs->wait(counters.back());
+    });
+
+    constexpr uint32_t ELEMENT_COUNT = 1 << 20;
+    std::vector<float> values(ELEMENT_COUNT);
+
+    double serial = Benchmark::run("loop over 1M elements", 5, [&]()
+    {
+        for (uint32_t i = 0; i < ELEMENT_COUNT; i++)
+        {
+            values[i] = work(i, 64);
+        }
+    });
+
+    for (uint32_t batchSize : { 256u, 4096u, 65536u })
+    {
+        double parallel = Benchmark::run("parallelFor over 1M elements, batches of " + std::to_string(batchSize), 5, [&]()
+        {
+            jobs->parallelFor(ELEMENT_COUNT, batchSize, [&values](uint32_t i) { values[i] = work(i, 64); });
+        });
+
+        Benchmark::speedup("  speedup", serial, parallel);
+    }
+
+    // Latency: time from execute() to a worker starting the job, with the workers asleep in between. The main thread
+    // polls the counter rather than wait(), which would run the job itself.
+    std::vector<double> latencies;
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+        JobCounter counter;
+        Clock::time_point queued = Clock::now();
+        Clock::time_point started;
+
+        jobs->execute([&started]() { started = Clock::now(); }, &counter);
+
+        while (!counter.isDone())
+        {
+        }
+
+        latencies.push_back(std::chrono::duration<double, std::micro>(started - queued).count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "latency from execute() to start: median " << latencies[latencies.size() / 2] << "us, 99th percentile "
+              << latencies[latencies.size() * 99 / 100] << "us\n";
+
+    Benchmark::sink += static_cast<uint64_t>(results[JOB_COUNT - 1] + values[ELEMENT_COUNT - 1]);
+
+    jobs->finalize();
+    return 0;
+}
\ No newline at end of file
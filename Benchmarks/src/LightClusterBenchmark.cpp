@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+#include <renderer/LightClusters.h>
+#include <renderer/Lighting.h>
+#include <core/JobSystem.h>
+#include <maths/math.h>
+
+#include <cstdlib>
+#include <random>
+
+using namespace Engine;
+
+// Lights of 2 to 20 units radius scattered through the view, as far as 'depth' in front of the camera
+static std::vector<PointLightData> makeLights(uint32_t count, float depth, std::mt19937& random)
+{
+    std::uniform_real_distribution<float> side(-depth * 0.5f, depth * 0.5f);
+    std::uniform_real_distribution<float> distance(-depth, 0.f);
+    std::uniform_real_distribution<float> radius(2.f, 20.f);
+
+    std::vector<PointLightData> lights(count);
+
+    for (auto& light : lights)
+    {
+        light.position = math::vec3(side(random), side(random) * 0.25f, distance(random));
+        light.intensity = 1.f;
+        light.radiance = math::vec3(1.f);
+        light.radius = radius(random);
+    }
+
+    return lights;
+}
+
+// Times LightClusters::assign(), the per frame step of clustered shading, serially and across the job system. The
+// parallel result must match the serial one exactly.
+//   LightClusterBenchmark [worker count]
+int main(int argc, char** argv)
+{
+    constexpr float FAR = 500.f;
+
+    math::mat4 projection = math::perspective(static_cast<float>(math::radians(60.f)), 16.f / 9.f, 0.1f, FAR);
+    math::mat4 view = math::lookAt(math::vec3(0.f), math::vec3(0.f, 0.f, -1.f), math::vec3(0.f, 1.f, 0.f));
+
+    LightClusters serial;
+    LightClusters parallel;
+
+    // build() skips unchanged projections, so every run alternates between two
+    math::mat4 other = math::perspective(static_cast<float>(math::radians(61.f)), 16.f / 9.f, 0.1f, FAR);
+    bool flip = false;
+
+    Benchmark::run("build the cluster grid", 20, [&]()
+    {
+        flip = !flip;
+        serial.build(flip ? other : projection);
+    });
+
+    serial.build(projection);
+    parallel.build(projection);
+
+    std::mt19937 random(42);
+    std::vector<std::vector<PointLightData>> scenes;
+    std::vector<double> serialTimes;
+
+    // Without workers, parallelFor() runs the slices on the calling thread
+    for (uint32_t count : { 64u, 256u, 1024u, 4096u })
+    {
+        scenes.push_back(makeLights(count, FAR, random));
+
+        serialTimes.push_back(Benchmark::run("assign " + std::to_string(count) + " lights, serial", 10, [&]()
+        {
+            serial.assign(scenes.back(), view);
+        }));
+
+        std::cout << "  " << serial.getLightIndices().size() << " light indices, "
+                  << static_cast<double>(serial.getLightIndices().size()) / LightClusters::CLUSTER_COUNT << " per cluster\n";
+    }
+
+    auto jobs = JobSystem::getInstance();
+    jobs->initialize(argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 0);
+
+    std::cout << jobs->getThreadCount() << " threads\n";
+
+    for (uint32_t i = 0; i < scenes.size(); i++)
+    {
+        const auto& lights = scenes[i];
+
+        double time = Benchmark::run("assign " + std::to_string(lights.size()) + " lights, job system", 10, [&]()
+        {
+            parallel.assign(lights, view);
+        });
+
+        Benchmark::speedup("  speedup", serialTimes[i], time);
+
+        serial.assign(lights, view);
+
+        bool same = serial.getLightIndices() == parallel.getLightIndices();
+
+        for (uint32_t cluster = 0; same && cluster < LightClusters::CLUSTER_COUNT; cluster++)
+        {
+            same = serial.getRanges()[cluster].offset == parallel.getRanges()[cluster].offset &&
+                   serial.getRanges()[cluster].count == parallel.getRanges()[cluster].count;
+        }
+
+        if (!same)
+        {
+            std::cout << "Mismatch: the job system assigned " << lights.size() << " lights differently\n";
+            jobs->finalize();
+            return 1;
+        }
+
+        Benchmark::sink += parallel.getLightIndices().size();
+    }
+
+    jobs->finalize();
+    return 0;
+}
\ No newline at end of file
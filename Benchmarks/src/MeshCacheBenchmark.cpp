@@ -0,0 +1,90 @@
+#include "Benchmark.h"
+
+#include <renderer/ModelLoader.h>
+#include <renderer/MeshCache.h>
+
+#include <cstdio>
+
+using namespace Engine;
+
+// Adds up every vertex and index of the cache, as uploading them would read them
+static uint64_t touch(const MeshCache& cache)
+{
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0; i < cache.getSubmeshCount(); i++)
+    {
+        const MeshCacheSubmesh& submesh = cache.getSubmesh(i);
+        const ModelVertex* vertices = cache.getVertices(submesh);
+        const uint32_t* indices = cache.getIndices(submesh);
+
+        for (uint32_t vertex = 0; vertex < submesh.vertexCount; vertex++)
+        {
+            sum += static_cast<uint64_t>(vertices[vertex].position.x);
+        }
+
+        for (uint32_t index = 0; index < submesh.indexCount; index++)
+        {
+            sum += indices[index];
+        }
+    }
+
+    return sum;
+}
+
+// Loading a model's meshes through Assimp against mapping the cooked file, without creating any GL meshes. The cooked
+// file is left next to the model, as the first load in the engine would leave it. Mapped timings are with the file in
+// the page cache:
+//   MeshCacheBenchmark [model path, Sandbox/assets/Donut.obj by default]
+int main(int argc, char** argv)
+{
+    std::string path = argc > 1 ? argv[1] : "Sandbox/assets/Donut.obj";
+    std::string cookedPath = MeshCache::getCookedPath(path);
+
+    std::remove(cookedPath.c_str());
+    Reference<MeshCache> cache = ModelLoader::loadMeshCache(path);
+
+    if (!cache)
+    {
+        std::cout << "Could not load " << path << "\n";
+        return 1;
+    }
+
+    uint64_t vertexCount = 0, indexCount = 0;
+
+    for (uint32_t i = 0; i < cache->getSubmeshCount(); i++)
+    {
+        vertexCount += cache->getSubmesh(i).vertexCount;
+        indexCount += cache->getSubmesh(i).indexCount;
+    }
+
+    std::cout << path << ": " << cache->getSubmeshCount() << " meshes, " << vertexCount << " vertices, " << indexCount << " indices\n";
+
+    // Removing the cooked file first makes every load import the model and cook it again
+    double imported = Benchmark::run("import with Assimp and cook", 5, [&]()
+    {
+        std::remove(cookedPath.c_str());
+        cache = ModelLoader::loadMeshCache(path);
+
+        Benchmark::sink += touch(*cache);
+    });
+
+    double mapped = Benchmark::run("map the cooked file", 20, [&]()
+    {
+        cache = ModelLoader::loadMeshCache(path);
+
+        Benchmark::sink += cache->getSubmeshCount();
+    });
+
+    double read = Benchmark::run("map the cooked file and read every vertex", 20, [&]()
+    {
+        cache = ModelLoader::loadMeshCache(path);
+
+        Benchmark::sink += touch(*cache);
+    });
+
+    Benchmark::speedup("speedup of mapping", imported, mapped);
+    Benchmark::speedup("speedup of mapping and reading", imported, read);
+
+    return 0;
+}
\ No newline at end of file
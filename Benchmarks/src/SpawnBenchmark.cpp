@@ -0,0 +1,208 @@
+#include "Benchmark.h"
+
+#include <scene/GameObject.h>
+#include <util/Transform.h>
+
+#include <cstdlib>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace Engine;
+
+class Projectile : public GameComponent
+{
+public:
+    float velocity[3] = {};
+    float lifetime = 1.f;
+};
+
+// How objects were allocated before the pool: each one and each of its components on its own with new
+struct HeapObject
+{
+    std::unordered_map<std::type_index, GameComponent*> components;
+    std::vector<HeapObject*> children;
+    HeapObject* parent = nullptr;
+
+    ~HeapObject()
+    {
+        for (auto& [type, component] : components)
+        {
+            delete component;
+        }
+    }
+};
+
+// Spawns and despawns objects under a fixed set of parents, the way bullets or particles come and go in a game,
+// against allocating every object and component on the heap. Handles to despawned objects must stop resolving.
+//   SpawnBenchmark [object count]
+int main(int argc, char** argv)
+{
+    uint32_t count = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    constexpr uint32_t GROUP_COUNT = 256;
+
+    GameObject root;
+    std::vector<GameObject*> groups;
+
+    HeapObject heapRoot;
+    std::vector<HeapObject*> heapGroups;
+
+    for (uint32_t i = 0; i < GROUP_COUNT; i++)
+    {
+        groups.push_back(root.createChild());
+
+        heapGroups.push_back(new HeapObject());
+        heapGroups.back()->parent = &heapRoot;
+        heapRoot.children.push_back(heapGroups.back());
+    }
+
+    auto spawn = [&](uint32_t i)
+    {
+        GameObject* object = groups[i % GROUP_COUNT]->createChild();
+        object->createComponent<Projectile>()->velocity[0] = static_cast<float>(i);
+        return object;
+    };
+
+    auto spawnHeap = [&](uint32_t i)
+    {
+        HeapObject* object = new HeapObject();
+        object->parent = heapGroups[i % GROUP_COUNT];
+        object->parent->children.push_back(object);
+
+        object->components[typeid(Transform)] = new Transform();
+        Projectile* projectile = new Projectile();
+        projectile->velocity[0] = static_cast<float>(i);
+        object->components[typeid(Projectile)] = projectile;
+
+        return object;
+    };
+
+    auto despawnHeap = [](HeapObject* object)
+    {
+        auto& siblings = object->parent->children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), object));
+        delete object;
+    };
+
+    std::cout << count << " objects under " << GROUP_COUNT << " parents\n";
+
+    std::vector<GameObject*> objects(count);
+    std::vector<HeapObject*> heapObjects(count);
+
+    // Everything at once, like loading a level and unloading it again. The pool reuses its slots after the first run.
+    double heapWave = Benchmark::run("spawn and despawn all, heap", 5, [&]()
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            heapObjects[i] = spawnHeap(i);
+        }
+
+        for (uint32_t i = count; i-- > 0;)
+        {
+            despawnHeap(heapObjects[i]);
+        }
+    });
+
+    double wave = Benchmark::run("spawn and despawn all, pool", 5, [&]()
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            objects[i] = spawn(i);
+        }
+
+        for (uint32_t i = count; i-- > 0;)
+        {
+            objects[i]->getParent()->removeChild(objects[i]);
+        }
+    });
+
+    Benchmark::speedup("  speedup", heapWave, wave);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        heapObjects[i] = spawnHeap(i);
+        objects[i] = spawn(i);
+    }
+
+    // A tenth of the objects replaced every frame, picked at random
+    std::mt19937 random(42);
+    std::vector<uint32_t> picks(count / 10);
+
+    auto pick = [&]()
+    {
+        for (auto& index : picks)
+        {
+            index = random() % count;
+        }
+    };
+
+    double heapChurn = Benchmark::run("replace 10% of the objects, heap", 20, [&]()
+    {
+        pick();
+
+        for (uint32_t index : picks)
+        {
+            despawnHeap(heapObjects[index]);
+            heapObjects[index] = spawnHeap(index);
+        }
+    });
+
+    std::vector<GameObjectHandle> stale;
+
+    double churn = Benchmark::run("replace 10% of the objects, pool", 20, [&]()
+    {
+        pick();
+        stale.clear();
+
+        for (uint32_t index : picks)
+        {
+            stale.push_back(objects[index]->getHandle());
+
+            objects[index]->getParent()->removeChild(objects[index]);
+            objects[index] = spawn(index);
+        }
+    });
+
+    Benchmark::speedup("  speedup", heapChurn, churn);
+
+    // Despawned slots were handed out again, which must not revive the handles to the objects that held them
+    GameObjectPool& pool = root.getStorage().getObjects();
+
+    for (const auto& handle : stale)
+    {
+        if (pool.get(handle))
+        {
+            std::cout << "A handle to a despawned object still resolved\n";
+            return 1;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pool.get(objects[i]->getHandle()) != objects[i])
+        {
+            std::cout << "A handle to a live object did not resolve to it\n";
+            return 1;
+        }
+    }
+
+    Benchmark::sink += pool.getCount();
+
+    // Children keep the storage they live in alive, so the hierarchy is taken apart before the root goes
+    while (!root.getChildren().empty())
+    {
+        root.removeChild(root.getChildren().back());
+    }
+
+    for (auto group : heapGroups)
+    {
+        for (auto object : group->children)
+        {
+            delete object;
+        }
+
+        delete group;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include <scene/GameObject.h>
+#include <util/Transform.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+using namespace Engine;
+
+// Per frame cost of GameObject::updateTransforms() for a hierarchy that doesn't move, one whose root moves, and one
+// where a few scattered leaves move. A static hierarchy should cost next to nothing, however large:
+//   TransformBenchmark [object count]
+int main(int argc, char** argv)
+{
+    uint32_t count = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+
+    std::mt19937 random(42);
+
+    // A chain 'count' levels deep, and a fan-out of a hundred children per object, four levels deep. The chain is
+    // capped, as updateTransforms() recurses once per level.
+    uint32_t chainLength = std::min(count, 10000u);
+
+    struct Shape
+    {
+        std::string name;
+        GameObject root;
+        GameObject* top = nullptr; // The object the others hang from, the one that moves
+        std::vector<GameObject*> leaves;
+    };
+
+    std::vector<Shape> shapes(2);
+
+    shapes[0].name = "chain of " + std::to_string(chainLength);
+    shapes[0].top = shapes[0].root.createChild();
+
+    GameObject* link = shapes[0].top;
+
+    for (uint32_t i = 1; i < chainLength; i++)
+    {
+        link = link->createChild();
+        link->getComponent<Transform>()->setTranslation(0.f, 1.f, 0.f);
+    }
+
+    shapes[0].leaves.push_back(link);
+
+    shapes[1].name = "fan-out of " + std::to_string(count);
+    shapes[1].top = shapes[1].root.createChild();
+
+    std::vector<GameObject*> level = { shapes[1].top };
+    uint32_t created = 1;
+
+    while (created < count)
+    {
+        std::vector<GameObject*> next;
+
+        for (uint32_t i = 0; i < level.size() * 100 && created < count; i++, created++)
+        {
+            GameObject* child = level[i / 100]->createChild();
+            child->getComponent<Transform>()->setTranslation(static_cast<float>(i % 100), 0.f, 0.f);
+            next.push_back(child);
+        }
+
+        level = std::move(next);
+    }
+
+    shapes[1].leaves = level;
+
+    for (auto& shape : shapes)
+    {
+        std::cout << "\n" << shape.name << "\n";
+
+        // Settles the matrices of the freshly built hierarchy
+        shape.root.updateTransforms();
+
+        Benchmark::run("static", 100, [&]()
+        {
+            shape.root.updateTransforms();
+        });
+
+        float offset = 0.f;
+
+        Benchmark::run("moving root", 20, [&]()
+        {
+            offset += 0.01f;
+            shape.top->getComponent<Transform>()->setTranslation(offset, 0.f, 0.f);
+            shape.root.updateTransforms();
+        });
+
+        std::uniform_int_distribution<size_t> leaf(0, shape.leaves.size() - 1);
+        uint32_t moved = std::max(static_cast<uint32_t>(shape.leaves.size() / 100), 1u);
+
+        Benchmark::run(std::to_string(moved) + " scattered leaves moving", 100, [&]()
+        {
+            offset += 0.01f;
+
+            for (uint32_t i = 0; i < moved; i++)
+            {
+                shape.leaves[leaf(random)]->getComponent<Transform>()->setTranslation(offset, 0.f, 0.f);
+            }
+
+            shape.root.updateTransforms();
+        });
+
+        Benchmark::sink += static_cast<uint64_t>(shape.leaves.back()->getComponent<Transform>()->getWorldTranslation().x);
+
+        // Children keep their storage alive, so the hierarchy is taken apart before its root goes
+        while (!shape.root.getChildren().empty())
+        {
+            shape.root.removeChild(shape.root.getChildren().back());
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -202,6 +202,8 @@ void EditorLayer::onImGuiRender()
     ImVec2 viewportPanelSize = ImGui::GetContentRegionAvail();
 	m_viewportSize = { viewportPanelSize.x, viewportPanelSize.y };
 
+    ImVec2 viewportOrigin = ImGui::GetCursorScreenPos();
+
     if (!m_playingScene)
     {
         ImGui::Image(reinterpret_cast<void*>(m_finalBuffer->getColorAttachment()), ImVec2{m_viewportSize.x, m_viewportSize.y}, ImVec2{0, 1}, ImVec2{1, 0});
@@ -259,6 +261,13 @@ void EditorLayer::onImGuiRender()
             }
         }
 
+        // Alt + left click is used by the editor camera
+        if (m_viewportHovered && ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !ImGuizmo::IsOver() && !Keyboard::isPressed(Keyboard::Key::LeftAlt))
+        {
+            ImVec2 mouse = ImGui::GetMousePos();
+            pickGameObject(math::vec2(mouse.x - viewportOrigin.x, mouse.y - viewportOrigin.y));
+        }
+
     }
 
     ImGui::End();
@@ -287,6 +296,28 @@ void EditorLayer::onImGuiRender()
     ImGui::PopStyleVar();
 }
 
+void EditorLayer::pickGameObject(const math::vec2& position)
+{
+    if (m_viewportSize.x <= 0 || m_viewportSize.y <= 0)
+    {
+        return;
+    }
+
+    float x = position.x / m_viewportSize.x * 2.f - 1.f;
+    float y = 1.f - position.y / m_viewportSize.y * 2.f;
+
+    // Unproject the cursor onto the near and far planes
+    math::mat4 inverse = math::inverse<float>(m_editorCamera.getProjectionMatrix() * m_editorCamera.getViewMatrix());
+    math::vec4 nearPoint = inverse * math::vec4(x, y, -1.f, 1.f);
+    math::vec4 farPoint = inverse * math::vec4(x, y, 1.f, 1.f);
+
+    math::vec3 origin(nearPoint.x / nearPoint.w, nearPoint.y / nearPoint.w, nearPoint.z / nearPoint.w);
+    math::vec3 end(farPoint.x / farPoint.w, farPoint.y / farPoint.w, farPoint.z / farPoint.w);
+
+    GameObject* object = m_scene->getSpatialIndex().raycast(origin, end - origin);
+    m_sceneHeirarchyPanel.setSelectedGameObject(object);
+}
+
 void EditorLayer::onDetach()
 {
 
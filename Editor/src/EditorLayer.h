@@ -35,6 +35,9 @@ public:
 private:
     void drawMenuBar();
 
+    // Selects the closest object under a point in the viewport (relative to its top left corner)
+    void pickGameObject(const math::vec2& position);
+
 private:
     Reference<Scene> m_scene;
     Reference<Framebuffer> m_framebuffer;
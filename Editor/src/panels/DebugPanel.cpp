@@ -1,10 +1,42 @@
 #include "DebugPanel.h"
 
 #include <imgui/imgui.h>
+#include <renderer/RenderCommand.h>
+#include <renderer/Renderer3D.h>
+#include <renderer/Assets.h>
+#include <renderer/Model.h>
+#include <scene/Scene.h>
 
 namespace Engine
 {
 
+namespace Utils
+{
+    template<typename T>
+    void assetStatistics_(const char* name)
+    {
+        AssetStatistics statistics = Assets::getStatistics<T>();
+
+        float cpu = statistics.memory.cpu / (1024.f * 1024.f);
+        float gpu = statistics.memory.gpu / (1024.f * 1024.f);
+
+        if (statistics.budget > 0)
+        {
+            ImGui::Text("%s: %u/%u resident, %.1f MB CPU, %.1f MB GPU of %.1f MB", name, statistics.resident, statistics.assets,
+                        cpu, gpu, statistics.budget / (1024.f * 1024.f));
+        }
+        else
+        {
+            ImGui::Text("%s: %u/%u resident, %.1f MB CPU, %.1f MB GPU", name, statistics.resident, statistics.assets, cpu, gpu);
+        }
+
+        if (statistics.evicted > 0 || statistics.reloaded > 0)
+        {
+            ImGui::Text("    %u evicted, %u reloaded", statistics.evicted, statistics.reloaded);
+        }
+    }
+}
+
 DebugPanel::DebugPanel()
 {
 
@@ -14,6 +46,37 @@ void DebugPanel::onImGuiRender()
 {
     ImGui::Begin("Debug");
 
+    const Statistics& statistics = RenderCommand::getStatistics();
+    ImGui::Text("Draw calls: %llu (%llu draws)", (unsigned long long)statistics.drawCalls, (unsigned long long)statistics.draws);
+
+    RendererStateStatistics state = RenderCommand::getStateStatistics();
+    ImGui::Text("State changes: %u issued, %u filtered", state.issued, state.filtered);
+
+    // Only filled while the scene runs, the editor updates the scene without its systems
+    if (m_context)
+    {
+        SystemScheduler& systems = m_context->getSystems();
+        ImGui::Text("Systems: %u stages", systems.getStageCount());
+
+        for (const SystemTiming& timing : systems.getTimings())
+        {
+            ImGui::Text("    %s: stage %u, %.3fms update, %.3fms sync", timing.system->getName().c_str(), timing.stage,
+                        timing.millis, timing.syncMillis);
+        }
+    }
+
+    const CullingStatistics& culling = Renderer3D::getCullingStatistics();
+    ImGui::Text("Meshes: %u visible, %u culled", culling.visible, culling.culled);
+    ImGui::Text("Shadow casters: %u visible, %u culled", culling.shadowVisible, culling.shadowCulled);
+
+    ImGui::Separator();
+
+    Utils::assetStatistics_<Texture2D>("Textures");
+    Utils::assetStatistics_<Mesh>("Meshes");
+    Utils::assetStatistics_<Model>("Models");
+    Utils::assetStatistics_<Material>("Materials");
+    Utils::assetStatistics_<Shader>("Shaders");
+
     ImGui::End();
 }
 
@@ -51,12 +51,13 @@ void MaterialsPanel::textureSelect(Reference<Texture2D>& texture)
     {
         for (auto& textureAsset : Assets::getCache<Texture2D>())
         {
-            ImGui::PushID(textureAsset.second.get());
+            ImGui::PushID(textureAsset.getKey().c_str());
 
-            bool isSelected = texture ? texture->getId() == textureAsset.second->getId() : false;
-            if (ImGui::Selectable(textureAsset.second->name.c_str(), isSelected))
+            // Evicted textures are only loaded again once picked
+            bool isSelected = texture && texture == textureAsset.getResident();
+            if (ImGui::Selectable(textureAsset.getKey().c_str(), isSelected))
             {
-                texture = textureAsset.second;
+                texture = textureAsset.get();
             }
 
             if (isSelected)
@@ -86,11 +87,12 @@ void MaterialsPanel::onImGuiRender()
     {
         for (auto& asset : Assets::getCache<Material>())
         {
-            ImGui::PushID(asset.first.c_str());
+            ImGui::PushID(asset.getKey().c_str());
 
-            if (ImGui::TreeNode(asset.second->name.c_str()))
+            auto material = asset.get();
+
+            if (ImGui::TreeNode(material->name.c_str()))
             {
-                auto& material = asset.second;
 
                 char buf[128];
                 strcpy(buf, material->name.c_str());
@@ -110,14 +112,16 @@ void MaterialsPanel::onImGuiRender()
 
                 if (ImGui::BeginCombo("##Shader", currentShader.c_str()))
                 {
-                    for (auto& shader : Assets::getCache<Shader>())
+                    for (auto& shaderAsset : Assets::getCache<Shader>())
                     {
-                        ImGui::PushID(shader.second.get());
+                        auto shader = shaderAsset.get();
+
+                        ImGui::PushID(shader.get());
 
-                        bool isSelected = material->shader ? material->shader->getId() == shader.second->getId() : false;
-                        if (ImGui::Selectable(shader.second->name.c_str(), isSelected))
+                        bool isSelected = material->shader ? material->shader->getId() == shader->getId() : false;
+                        if (ImGui::Selectable(shader->name.c_str(), isSelected))
                         {
-                            material->shader = shader.second;
+                            material->shader = shader;
                         }
 
                         if (isSelected)
@@ -143,8 +147,9 @@ void MaterialsPanel::onImGuiRender()
 
                     ImGui::NextColumn();
 
-                    ImGuiColorEditFlags flags = ImGuiColorEditFlags_NoInputs;
-                    ImGui::ColorEdit3("##Color", &material->albedoColor.x, flags);
+                    // Alpha below one makes the material transparent
+                    ImGuiColorEditFlags flags = ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_AlphaBar | ImGuiColorEditFlags_AlphaPreviewHalf;
+                    ImGui::ColorEdit4("##Color", &material->albedoColor.x, flags);
                     ImGui::NextColumn();
 
                     ImGui::PopID();
@@ -246,26 +251,28 @@ void MaterialsPanel::onImGuiRender()
 
     if (ImGui::CollapsingHeader("Shaders"))
     {
-        for (auto& shader : Assets::getCache<Shader>().getInternalList())
+        for (auto& shaderAsset : Assets::getCache<Shader>())
         {
-            bool opened = ImGui::TreeNodeEx(shader.second->name.c_str());
+            auto shader = shaderAsset.get();
+
+            bool opened = ImGui::TreeNodeEx(shader->name.c_str());
 
             if (opened)
             {
-                ImGui::PushID(&shader.second);
+                ImGui::PushID(&shaderAsset);
 
                 char buf[128];
-                strcpy(buf, shader.second->name.c_str());
+                strcpy(buf, shader->name.c_str());
 
                 ImGui::Text("Name");
                 ImGui::SameLine();
 
                 if (ImGui::InputText("##Name", buf, 128, ImGuiInputTextFlags_EnterReturnsTrue))
                 {
-                    shader.second->name = std::string(buf);
+                    shader->name = std::string(buf);
                 }
 
-                shaderSelect(shader.second);
+                shaderSelect(shaderAsset);
 
                 ImGui::PopID();
 
@@ -299,15 +306,16 @@ void MaterialsPanel::onImGuiRender()
     {
         std::string oldName = "";
         std::string newName = "";
-        for (auto& texture : Assets::getCache<Texture2D>().getInternalList())
+        for (auto& texture : Assets::getCache<Texture2D>())
         {
-            bool opened = ImGui::TreeNodeEx(texture.second->name.c_str());
+            // Listed by key, so evicted textures are only loaded again when expanded
+            bool opened = ImGui::TreeNodeEx(texture.getKey().c_str());
 
             if (ImGui::BeginPopupContextItem())
             {
                 if (ImGui::MenuItem("Delete Texture"))
                 {
-                    deletedTexture = texture.first;
+                    deletedTexture = texture.getKey();
                 }
 
                 ImGui::EndPopup();
@@ -316,28 +324,26 @@ void MaterialsPanel::onImGuiRender()
             if (opened)
             {
                 char buf[128];
-                strcpy(buf, texture.second->name.c_str());
+                strcpy(buf, texture.getKey().c_str());
 
                 ImGui::Text("Name");
                 ImGui::SameLine();
 
                 if (ImGui::InputText("##Name", buf, 128, ImGuiInputTextFlags_EnterReturnsTrue))
                 {
-                    oldName = texture.first;
+                    oldName = texture.getKey();
                     newName = buf;
                 }
 
-                ImGui::Image(reinterpret_cast<void*>(texture.second->getId()), ImVec2{30, 30}, ImVec2{0, 1}, ImVec2{1, 0});
+                ImGui::Image(reinterpret_cast<void*>(texture.get()->getId()), ImVec2{30, 30}, ImVec2{0, 1}, ImVec2{1, 0});
                 ImGui::TreePop();
             }
         }
 
-        if (oldName != "")
+        if (oldName != "" && !Assets::exists<Texture2D>(newName))
         {
-            auto pair = Assets::getCache<Texture2D>().getInternalList().extract(oldName);
-            pair.mapped()->name = newName;
-            pair.key() = newName;
-            Assets::getCache<Texture2D>().getInternalList().insert(std::move(pair));
+            Assets::get<Texture2D>(oldName)->name = newName;
+            Assets::rename<Texture2D>(oldName, newName);
         }
 
         if (ImGui::Button("Create Texture"))
@@ -345,16 +351,19 @@ void MaterialsPanel::onImGuiRender()
             FileDialog::open("createTexture");   
         }
 
-        if (FileDialog::selectFile("createTexture", "Choose texture...", ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".pic"))
+        if (FileDialog::selectFile("createTexture", "Choose texture...", ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".pic", ".ktx2", ".dds"))
         {
             if (!FileDialog::display())
             {
                 if (FileDialog::madeSelection())
                 {
-                    Reference<Texture2D> texture = Texture2D::create(FileDialog::getSelection());
-                    texture->name = "New Texture";
-                    texture->uuid = Utils::genUUID();
-                    Assets::add<Texture2D>(texture->name, texture);
+                    // Decoded in the background, the texture shows up in the list once it is ready
+                    Assets::loadAsync<Texture2D>(FileDialog::getSelection(), [](const Reference<Texture2D>& texture)
+                    {
+                        texture->name = "New Texture";
+                        texture->uuid = Utils::genUUID();
+                        Assets::add<Texture2D>(texture->name, texture);
+                    });
                 }
             }
         }
@@ -368,7 +377,7 @@ void MaterialsPanel::onImGuiRender()
     ImGui::End();
 }
 
-void MaterialsPanel::shaderSelect(Reference<Shader>& shader)
+void MaterialsPanel::shaderSelect(AssetEntry<Shader>& shader)
 {
     if (ImGui::Button("Load"))
     {
@@ -381,7 +390,7 @@ void MaterialsPanel::shaderSelect(Reference<Shader>& shader)
         {
             if (FileDialog::madeSelection())
             {
-                shader = Shader::createFromFile(FileDialog::getSelection());
+                shader.set(Shader::createFromFile(FileDialog::getSelection()));
             }
         }
     }
@@ -5,6 +5,7 @@
 #include <scene/EditorCamera.h>
 #include <renderer/Model.h>
 #include <renderer/Lighting.h>
+#include <renderer/Assets.h>
 
 namespace Engine
 {
@@ -27,7 +28,7 @@ private:
     void renderMaterialPreview(const Reference<Material>& material);
 
     void textureSelect(Reference<Texture2D>& texture);
-    void shaderSelect(Reference<Shader>& shader);
+    void shaderSelect(AssetEntry<Shader>& shader);
 
 private:
     Scene* m_context = nullptr;
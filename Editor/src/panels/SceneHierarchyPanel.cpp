@@ -42,7 +42,7 @@ void SceneHierarchyPanel::recurseTree(GameObject& object)
 
     if (ImGui::IsItemClicked())
     {
-        m_selection = &object;
+        setSelectedGameObject(&object);
     }
     
     bool deleted = false;
@@ -64,7 +64,7 @@ void SceneHierarchyPanel::recurseTree(GameObject& object)
 
     if (deleted)
     {
-        m_selection = nullptr;
+        setSelectedGameObject(nullptr);
         m_deletedGameObject = &object;
     }
 
@@ -97,7 +97,7 @@ void SceneHierarchyPanel::onImGuiRender()
             {
                 auto object = m_context->createGameObject("New Game Object");
                 object->createComponent<Transform>();
-                m_selection = object;
+                setSelectedGameObject(object);
             }
 
             if (ImGui::MenuItem("Camera"))
@@ -112,7 +112,7 @@ void SceneHierarchyPanel::onImGuiRender()
                 camera->primary = true;
                 camera->setProjectionType(Camera::ProjectionType::Perspective);
 
-                m_selection = object;
+                setSelectedGameObject(object);
             }
 
             if (ImGui::MenuItem("Sprite"))
@@ -120,7 +120,7 @@ void SceneHierarchyPanel::onImGuiRender()
                 auto object = m_context->createGameObject("New Sprite");
                 object->createComponent<Transform>();
                 object->createComponent<SpriteRendererComponent>();
-                m_selection = object;
+                setSelectedGameObject(object);
             }
 
             if (ImGui::BeginMenu("Mesh"))
@@ -136,7 +136,7 @@ void SceneHierarchyPanel::onImGuiRender()
                     object->createComponent<Transform>();
                     object->createComponent<Mesh>();
                     object->createComponent<MeshRendererComponent>();
-                    m_selection = object;
+                    setSelectedGameObject(object);
                 }
                 if (ImGui::MenuItem("Cube"))
                 {
@@ -145,7 +145,7 @@ void SceneHierarchyPanel::onImGuiRender()
                     auto mesh = object->createComponent<MeshComponent>();
                     mesh->mesh = MeshFactory::cubeMesh(1.f);
                     auto render = object->createComponent<MeshRendererComponent>();
-                    m_selection = object;
+                    setSelectedGameObject(object);
                 }
                 if (ImGui::MenuItem("Sphere"))
                 {
@@ -154,7 +154,7 @@ void SceneHierarchyPanel::onImGuiRender()
                     auto mesh = object->createComponent<MeshComponent>();
                     mesh->mesh = MeshFactory::sphereMesh(1.f, 20, 20);
                     auto render = object->createComponent<MeshRendererComponent>();
-                    m_selection = object;
+                    setSelectedGameObject(object);
                 }
 
                 ImGui::EndMenu();
@@ -177,7 +177,7 @@ void SceneHierarchyPanel::onImGuiRender()
                 auto object = m_context->createGameObject("Directional Light");
                 object->createComponent<Transform>();
                 object->createComponent<DirectionalLight>();
-                m_selection = object;
+                setSelectedGameObject(object);
             }
 
             ImGui::EndMenu();
@@ -191,17 +191,26 @@ void SceneHierarchyPanel::onImGuiRender()
         {
             if (FileDialog::madeSelection())
             {
-                Reference<Mesh> mesh = Mesh::load(FileDialog::getSelection(), 0);
+                // The object is created once the mesh has loaded, as long as the same scene is still open
+                Scene* context = m_context;
 
-                auto object = m_context->createGameObject("Imported Mesh");
-                object->createComponent<Transform>();
-                auto meshRender = object->createComponent<MeshRendererComponent>();
-                meshRender->material = mesh->material;
+                Assets::loadAsync<Mesh>(FileDialog::getSelection(), [this, context](const Reference<Mesh>& mesh)
+                {
+                    if (m_context != context)
+                    {
+                        return;
+                    }
+
+                    auto object = m_context->createGameObject("Imported Mesh");
+                    object->createComponent<Transform>();
+                    auto meshRender = object->createComponent<MeshRendererComponent>();
+                    meshRender->material = mesh->material;
 
-                auto meshComp = object->createComponent<MeshComponent>();
-                meshComp->mesh = mesh;
+                    auto meshComp = object->createComponent<MeshComponent>();
+                    meshComp->mesh = mesh;
 
-                m_selection = object;
+                    setSelectedGameObject(object);
+                });
             }
         }
     }
@@ -229,9 +238,9 @@ void SceneHierarchyPanel::onImGuiRender()
 
     ImGui::Begin("Inspector");
 
-    if (m_selection != nullptr)
+    if (GameObject* selection = getSelectedGameObject())
     {
-        drawProperties(*m_selection);
+        drawProperties(*selection);
     }
 
     ImGui::End();
@@ -443,12 +452,13 @@ void SceneHierarchyPanel::drawProperties(GameObject& object)
         {
             for (auto& texture : Assets::getCache<Texture2D>())
             {
-                ImGui::PushID(texture.second.get());
+                ImGui::PushID(texture.getKey().c_str());
 
-                bool isSelected = component->texture ? component->texture->getId() == texture.second->getId() : false;
-                if (ImGui::Selectable(texture.second->name.c_str(), isSelected))
+                // Evicted textures are only loaded again once picked
+                bool isSelected = component->texture && component->texture == texture.getResident();
+                if (ImGui::Selectable(texture.getKey().c_str(), isSelected))
                 {
-                    component->texture = texture.second;
+                    component->texture = texture.get();
                 }
 
                 if (isSelected)
@@ -482,6 +492,11 @@ void SceneHierarchyPanel::drawProperties(GameObject& object)
             ImGui::NextColumn();
         }
 
+        ImGui::Text("Layer");
+        ImGui::NextColumn();
+        ImGui::DragInt("##Layer", &component->layer);
+        ImGui::NextColumn();
+
         ImGui::Columns(1);
     });
 
@@ -607,14 +622,14 @@ void SceneHierarchyPanel::drawProperties(GameObject& object)
 
         if (ImGui::BeginCombo("##materialSelect", name.c_str()))
         {
-            for (auto& material : Assets::getCache<Material>().getInternalList())
+            for (auto& material : Assets::getCache<Material>())
             {
-                ImGui::PushID(material.second.get());
+                ImGui::PushID(material.getKey().c_str());
 
-                bool isSelected = material.second == component->material;
-                if (ImGui::Selectable(material.second->name.c_str(), isSelected))
+                bool isSelected = material.getResident() == component->material;
+                if (ImGui::Selectable(material.get()->name.c_str(), isSelected))
                 {
-                    component->material = material.second;
+                    component->material = material.get();
                     isSelected = true;
                 }
 
@@ -637,6 +652,12 @@ void SceneHierarchyPanel::drawProperties(GameObject& object)
         ImGui::Checkbox("##castShadows", &component->castShadows);
         ImGui::NextColumn();
 
+        ImGui::Text("Static");
+        ImGui::NextColumn();
+
+        ImGui::Checkbox("##isStatic", &component->isStatic);
+        ImGui::NextColumn();
+
         ImGui::Columns(1);
     });
 
@@ -21,21 +21,31 @@ public:
 
     void drawProperties(GameObject& object);
     
-    void setContext(Scene* context) { m_context = context; }
+    void setContext(Scene* context)
+    {
+        m_context = context;
+        m_selection = GameObjectHandle();
+    }
 
     void recurseTree(GameObject& object);
 
     void onImGuiRender();
 
+    // nullptr if nothing is selected or the selection was destroyed since
     GameObject* getSelectedGameObject()
     {
-        return m_selection;
+        return m_context ? m_context->getGameObject(m_selection) : nullptr;
+    }
+
+    void setSelectedGameObject(GameObject* object)
+    {
+        m_selection = object ? object->getHandle() : GameObjectHandle();
     }
 
 private:
     Scene* m_context = nullptr;
 
-    GameObject* m_selection = nullptr;
+    GameObjectHandle m_selection;
     GameObject* m_deletedGameObject = nullptr;
 };
 
@@ -4,12 +4,14 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 layout (location = 2) in vec4 aColor;
 layout (location = 3) in float aTexIndex;
+layout (location = 4) in float aSampling;
 
 out Params
 {
     vec2 texCoord;
     vec4 color;
     flat float texIndex;
+    flat float sampling;
 } vsOutput;
 
 layout (std140, binding = 2) uniform matrices
@@ -23,17 +25,20 @@ void main()
     vsOutput.texCoord = aTexCoord;
     vsOutput.color = aColor;
     vsOutput.texIndex = aTexIndex;
+    vsOutput.sampling = aSampling;
     gl_Position = uProjection * uTransform * vec4(aPos, 1.0);
 }
 
 #shader fragment
 #define MAX_TEXTURE_SLOTS 32
+#define SAMPLING_DISTANCE 1
 
 in Params
 {
     vec2 texCoord;
     vec4 color;
-    float texIndex;
+    flat float texIndex;
+    flat float sampling;
 } fsInput;
 
 layout (location = 0) out vec4 color;
@@ -42,16 +47,26 @@ uniform sampler2D uTextures[MAX_TEXTURE_SLOTS];
 
 void main()
 {
-    color = fsInput.color;
+    vec4 sampled = vec4(1);
     for (int i = 0; i < MAX_TEXTURE_SLOTS; i++)
     {
         if (i == int(fsInput.texIndex))
         {
-            color *= texture(uTextures[i], fsInput.texCoord);
+            sampled = texture(uTextures[i], fsInput.texCoord);
             break;
         }
     }
 
+    // Derivatives are taken outside the loop, so every fragment of a quad computes them
+    if (int(fsInput.sampling) == SAMPLING_DISTANCE)
+    {
+        float distance = sampled.r;
+        float width = max(fwidth(distance) * 0.5, 1e-4);
+        sampled = vec4(1, 1, 1, smoothstep(0.5 - width, 0.5 + width, distance));
+    }
+
+    color = fsInput.color * sampled;
+
     if (color.a < 0.1)
     {
         discard;
@@ -18,7 +18,6 @@ layout (std140, binding = 0) uniform matrices
     mat4 uView;
 };
 
-uniform mat4 uLightSpaceMatrix;
 uniform mat4 uTransform = mat4(1.f);
 
 void main()
@@ -29,8 +28,6 @@ void main()
 
 #shader fragment
 
-#define MAX_LIGHTS 64
-
 // Structure representing a PBR material
 struct Material
 {
@@ -44,24 +41,30 @@ struct Material
     float lightmapToggle;
     float emissionMapToggle;
 
-    vec3 albedoColor;
+    vec4 albedoColor;
+
+    float normalMapTwoChannel;
 };
 
 // Structures representing types of lights
 struct PointLight
 {
     vec3 position;
-    vec3 radiance;
     float intensity;
+    vec3 radiance;
+    float radius;
 };
 
 struct DirectionalLight
 {
     vec3 direction;
-    vec3 radiance;
     float intensity;
+    vec3 radiance;
 };
 
+// Matches LightBlockHeader::MAX_DIRECTIONAL_LIGHTS
+const int MAX_DIRECTIONAL_LIGHTS = 4;
+
 struct SkyLight
 {
     vec3 radiance;
@@ -95,15 +98,20 @@ layout (location = 1) out vec4 brightColor;
 
 // Uniforms
 uniform vec3 uCameraPos;
-uniform Material uMaterial;
-
-uniform PointLight uPointLights[MAX_LIGHTS];
-uniform int uNumPointLights;
-
-uniform DirectionalLight uDirectionalLight;
-uniform int uUsingDirectionalLight;
+layout (std140, binding = 1) uniform MaterialBlock
+{
+    Material uMaterial;
+};
 
-uniform SkyLight uSkyLight;
+// Every light in the scene, uploaded once per frame
+layout (std430, binding = 0) readonly buffer LightBlock
+{
+    DirectionalLight uDirectionalLights[MAX_DIRECTIONAL_LIGHTS];
+    SkyLight uSkyLight;
+    int uNumPointLights;
+    int uNumDirectionalLights;
+    PointLight uPointLights[];
+};
 
 void main()
 {
@@ -12,7 +12,6 @@ out Params
     vec2 texCoord;
     vec3 normal;
     vec3 worldPos; // The frag's position in world space
-    vec4 worldPosLightSpace;
     mat3 worldNormals; // The Tangent, Binormal, Normal matrix
 } vsOutput;
 
@@ -22,26 +21,31 @@ layout (std140, binding = 0) uniform matrices
     mat4 uView;
 };
 
-uniform mat4 uLightSpaceMatrix;
 uniform mat4 uTransform = mat4(1.f);
 
+// Transforms of multi draws, each draw's instances start at its base instance
+layout (std430, binding = 3) readonly buffer TransformBlock
+{
+    mat4 uTransforms[];
+};
+
+uniform bool uIndirect = false;
+
 void main()
 {
+    mat4 transform = uIndirect ? uTransforms[gl_BaseInstance + gl_InstanceID] : uTransform;
     vec3 aBitangent = cross(aNormal, aTangent);
 
-    vsOutput.normal = transpose(inverse(mat3(uTransform))) * aNormal;
+    vsOutput.normal = transpose(inverse(mat3(transform))) * aNormal;
     vsOutput.texCoord = aTexCoord;
-    vsOutput.worldNormals = mat3(uTransform) * mat3(aTangent, aBitangent, aNormal);
-    vsOutput.worldPos = vec3(uTransform * vec4(aPos, 1.0));
-    vsOutput.worldPosLightSpace = uLightSpaceMatrix * vec4(vsOutput.worldPos, 1.0);
+    vsOutput.worldNormals = mat3(transform) * mat3(aTangent, aBitangent, aNormal);
+    vsOutput.worldPos = vec3(transform * vec4(aPos, 1.0));
 
     gl_Position = uProjection * uView * vec4(vsOutput.worldPos, 1.0);
 }
 
 #shader fragment
 
-#define MAX_LIGHTS 64
-
 // Structure representing a PBR material
 struct Material
 {
@@ -55,24 +59,30 @@ struct Material
     float lightmapToggle;
     float emissionMapToggle;
 
-    vec3 albedoColor;
+    vec4 albedoColor;
+
+    float normalMapTwoChannel;
 };
 
 // Structures representing types of lights
 struct PointLight
 {
     vec3 position;
-    vec3 radiance;
     float intensity;
+    vec3 radiance;
+    float radius;
 };
 
 struct DirectionalLight
 {
     vec3 direction;
-    vec3 radiance;
     float intensity;
+    vec3 radiance;
 };
 
+// Matches LightBlockHeader::MAX_DIRECTIONAL_LIGHTS
+const int MAX_DIRECTIONAL_LIGHTS = 4;
+
 struct SkyLight
 {
     vec3 radiance;
@@ -84,7 +94,6 @@ in Params
     vec2 texCoord;
     vec3 normal;
     vec3 worldPos;
-    vec4 worldPosLightSpace;
     mat3 worldNormals;
 } fsInput;
 
@@ -116,23 +125,61 @@ layout (binding = 7) uniform samplerCube uIrradianceMap;
 layout (binding = 8) uniform samplerCube uPrefilterMap;
 layout (binding = 9) uniform sampler2D uBrdfLUT;
 
-// Shadow map sampler
-layout (binding = 10) uniform sampler2D uShadowMap;
+// Shadow map samplers, one per cascade
+layout (binding = 10) uniform sampler2D uShadowMaps[4];
 
 layout (location = 0) out vec4 color;
 layout (location = 1) out vec4 brightColor;
 
 // Uniforms
 uniform vec3 uCameraPos;
-uniform Material uMaterial;
+layout (std140, binding = 1) uniform MaterialBlock
+{
+    Material uMaterial;
+};
 
-uniform PointLight uPointLights[MAX_LIGHTS];
-uniform int uNumPointLights;
+// Every light in the scene, uploaded once per frame
+layout (std430, binding = 0) readonly buffer LightBlock
+{
+    DirectionalLight uDirectionalLights[MAX_DIRECTIONAL_LIGHTS];
+    SkyLight uSkyLight;
+    int uNumPointLights;
+    int uNumDirectionalLights;
+    PointLight uPointLights[];
+};
 
-uniform DirectionalLight uDirectionalLight;
-uniform int uUsingDirectionalLight;
+// Clustered lighting, the point lights affecting each view space cluster
+struct ClusterRange
+{
+    uint offset;
+    uint count;
+};
+
+layout (std430, binding = 1) readonly buffer ClusterBlock
+{
+    uvec4 uClusterGrid;  // Clusters along x, y and z
+    vec4 uClusterDepth;  // Near, far, slice scale, slice bias
+    ClusterRange uClusters[];
+};
 
-uniform SkyLight uSkyLight;
+layout (std430, binding = 2) readonly buffer LightIndexBlock
+{
+    uint uLightIndices[];
+};
+
+layout (std140, binding = 0) uniform matrices
+{
+    mat4 uProjection;
+    mat4 uView;
+};
+
+// Cascaded shadow maps of the directional light
+layout (std140, binding = 3) uniform ShadowBlock
+{
+    mat4 uCascadeMatrices[4];
+    vec4 uCascadeSplits;     // View depth at which each cascade ends
+    vec4 uCascadeTexelSizes; // World space size of a shadow map texel
+};
 
 const float PI = 3.1415926535897932384626433832795028841971693993751058209749445923;
 
@@ -218,16 +265,74 @@ vec2 parallaxMapping(vec2 texCoord, vec3 viewDir)
     return finalTexCoord;
 }
 
-// Calculate whether the fragment is in shadow
-float shadowCalculation(vec4 worldPosLightSpace)
+float sampleShadowMap(int cascade, vec2 uv)
 {
+    // Sampler arrays may only be indexed with constants
+    if (cascade == 0) return texture(uShadowMaps[0], uv).r;
+    if (cascade == 1) return texture(uShadowMaps[1], uv).r;
+    if (cascade == 2) return texture(uShadowMaps[2], uv).r;
+
+    return texture(uShadowMaps[3], uv).r;
+}
+
+// Calculate how much of the fragment is in shadow, using the cascade that covers its view depth
+float shadowCalculation(vec3 worldPos, vec3 normal)
+{
+    float depth = -(uView * vec4(worldPos, 1.0)).z;
+
+    int cascade = 0;
+    while (cascade < 4 && depth > uCascadeSplits[cascade])
+    {
+        cascade++;
+    }
+
+    if (cascade == 4)
+    {
+        return 0.0;
+    }
+
+    // Offset along the normal by about a texel, scaled with the cascade, to avoid acne
+    vec3 position = worldPos + normal * uCascadeTexelSizes[cascade] * 1.5;
+    vec4 worldPosLightSpace = uCascadeMatrices[cascade] * vec4(position, 1.0);
+
     vec3 projCoords = worldPosLightSpace.xyz / worldPosLightSpace.w;
     projCoords = projCoords * 0.5 + 0.5;
-    float closestDepth = texture(uShadowMap, projCoords.xy).r; 
-    float currentDepth = projCoords.z;
-    float shadow = currentDepth > closestDepth  ? 1.0 : 0.0;
 
-    return shadow;
+    if (projCoords.z > 1.0)
+    {
+        return 0.0;
+    }
+
+    // 3x3 percentage closer filtering
+    vec2 texelSize = 1.0 / vec2(textureSize(uShadowMaps[0], 0));
+    float shadow = 0.0;
+
+    for (int x = -1; x <= 1; x++)
+    {
+        for (int y = -1; y <= 1; y++)
+        {
+            float closestDepth = sampleShadowMap(cascade, projCoords.xy + vec2(x, y) * texelSize);
+            shadow += projCoords.z > closestDepth ? 1.0 : 0.0;
+        }
+    }
+
+    return shadow / 9.0;
+}
+
+uint clusterIndex(vec3 worldPos)
+{
+    vec4 viewPos = uView * vec4(worldPos, 1.0);
+    vec4 clipPos = uProjection * viewPos;
+    vec2 ndc = clipPos.xy / clipPos.w;
+
+    vec2 grid = vec2(uClusterGrid.xy);
+    uvec2 tile = uvec2(clamp((ndc * 0.5 + 0.5) * grid, vec2(0.0), grid - 1.0));
+
+    // Slices are exponential in view depth
+    float slice = floor(log(max(-viewPos.z, uClusterDepth.x)) * uClusterDepth.z + uClusterDepth.w);
+    uint z = uint(clamp(slice, 0.0, float(uClusterGrid.z) - 1.0));
+
+    return tile.x + tile.y * uClusterGrid.x + z * uClusterGrid.x * uClusterGrid.y;
 }
 
 vec3 lighting(vec3 F0)
@@ -236,16 +341,20 @@ vec3 lighting(vec3 F0)
 
     // ----------------------------Point Lights-------------------------------------
 
-    for (int i = 0; i < uNumPointLights; i++)
+    ClusterRange cluster = uClusters[clusterIndex(fsInput.worldPos)];
+
+    for (uint i = 0u; i < cluster.count; i++)
     {
-        vec3 lightPos = uPointLights[i].position;
+        PointLight light = uPointLights[uLightIndices[cluster.offset + i]];
 
-        vec3 lightDir = normalize(lightPos - fsInput.worldPos);
+        vec3 lightDir = normalize(light.position - fsInput.worldPos);
         vec3 H = normalize(m_params.view + lightDir);
 
-        float distance = length(lightPos - fsInput.worldPos);
-        float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = uPointLights[i].radiance * attenuation;
+        // Inverse square falloff, windowed to reach zero at the light's radius
+        float distance = length(light.position - fsInput.worldPos);
+        float window = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+        float attenuation = window * window / (distance * distance);
+        vec3 radiance = light.radiance * attenuation;
 
         float NDF = distributionGGX(m_params.normal, H, m_params.roughness);
         float G = geometrySmith(m_params.normal, m_params.view, lightDir, m_params.roughness);
@@ -262,18 +371,20 @@ vec3 lighting(vec3 F0)
         vec3 specular = numerator / max(denominator, 0.001);
 
         vec3 pointLightContribution = (kD * m_params.albedo / PI + specular) * radiance * NdotL;
-        pointLightContribution *= uPointLights[i].intensity;
+        pointLightContribution *= light.intensity;
 
         Lo += pointLightContribution;
     }
     
-    // ----------------------------Directional Light-------------------------------------
-    if (uUsingDirectionalLight == 1)
+    // ----------------------------Directional Lights------------------------------------
+    for (int i = 0; i < uNumDirectionalLights; i++)
     {
-        vec3 lightDir = normalize(-uDirectionalLight.direction);
+        DirectionalLight light = uDirectionalLights[i];
+
+        vec3 lightDir = normalize(-light.direction);
         vec3 H = normalize(m_params.view + lightDir);
 
-        vec3 radiance = uDirectionalLight.radiance;
+        vec3 radiance = light.radiance;
 
         float NDF = distributionGGX(m_params.normal, H, m_params.roughness);
         float G = geometrySmith(m_params.normal, m_params.view, lightDir, m_params.roughness);
@@ -290,7 +401,13 @@ vec3 lighting(vec3 F0)
         vec3 specular = numerator / max(denominator, 0.001);
 
         vec3 dirLightContribution = (kD * m_params.albedo / PI + specular) * radiance * NdotL;
-        dirLightContribution *= uDirectionalLight.intensity;
+        dirLightContribution *= light.intensity;
+
+        // Only the first directional light has shadow cascades
+        if (i == 0)
+        {
+            dirLightContribution *= 1.0 - shadowCalculation(fsInput.worldPos, normalize(fsInput.normal));
+        }
 
         Lo += dirLightContribution;
     }
@@ -320,7 +437,7 @@ vec3 IBL(vec3 F0)
 void main()
 {
     // Retrieve all material attributes
-    m_params.albedo = uMaterial.albedoMapToggle > 0.5 ? texture(uAlbedoMap, fsInput.texCoord).rgb : uMaterial.albedoColor;
+    m_params.albedo = uMaterial.albedoMapToggle > 0.5 ? texture(uAlbedoMap, fsInput.texCoord).rgb : uMaterial.albedoColor.rgb;
     m_params.metallic = uMaterial.metallicMapToggle > 0.5 ? texture(uMetallicMap, fsInput.texCoord).r : uMaterial.metallic;
     m_params.roughness = uMaterial.roughnessMapToggle > 0.5 ? texture(uRoughnessMap, fsInput.texCoord).r : uMaterial.roughness;
     m_params.ao = uMaterial.lightmapToggle > 0.5 ? texture(uLightmap, fsInput.texCoord).r : 1.0;
@@ -330,8 +447,15 @@ void main()
     m_params.normal = normalize(fsInput.normal);
     if (uMaterial.normalMapToggle > 0.5)
     {
-        m_params.normal = normalize(2.0 * texture(uNormalMap, fsInput.texCoord).rgb - 1.0);
-        m_params.normal = normalize(fsInput.worldNormals * m_params.normal);
+        vec3 normal = 2.0 * texture(uNormalMap, fsInput.texCoord).rgb - 1.0;
+
+        // Two channel maps (BC5) leave blue at zero, z follows from the normal being unit length
+        if (uMaterial.normalMapTwoChannel > 0.5)
+        {
+            normal.z = sqrt(max(1.0 - dot(normal.xy, normal.xy), 0.0));
+        }
+
+        m_params.normal = normalize(fsInput.worldNormals * normalize(normal));
     }
 
     m_params.view = normalize(uCameraPos - fsInput.worldPos);
@@ -345,8 +469,9 @@ void main()
     vec3 lightContribution = lighting(F0);
     vec3 IBLContribution = IBL(F0);
 
-    color = vec4((m_params.emission + lightContribution + IBLContribution) * m_params.ao, 1.0);
+    // The material's alpha, blended in the transparent pass
+    color = vec4((m_params.emission + lightContribution + IBLContribution) * m_params.ao, uMaterial.albedoColor.a);
 
     float brightness = dot(color.rgb, vec3(0.2126, 0.7152, 0.0722));
-    brightColor = brightness > 1.0 ? vec4(color.rgb, 1.0) : vec4(0.0, 0.0, 0.0, 1.0);
+    brightColor = brightness > 1.0 ? vec4(color.rgb, color.a) : vec4(0.0, 0.0, 0.0, color.a);
 }
\ No newline at end of file
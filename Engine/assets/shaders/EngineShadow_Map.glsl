@@ -5,14 +5,21 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 layout (location = 3) in vec3 aTangent;
 
-uniform mat4 lightSpaceMatrix;
-uniform mat4 transform = mat4(1.f);
+uniform mat4 uLightSpaceMatrix;
+uniform mat4 uTransform = mat4(1.f);
+
+// Transforms of multi draws, each draw's instances start at its base instance
+layout (std430, binding = 3) readonly buffer TransformBlock
+{
+    mat4 uTransforms[];
+};
+
+uniform bool uIndirect = false;
 
 void main()
 {
-    vec4 pos = lightSpaceMatrix * transform * vec4(aPos, 1.0);
-    pos.z = 2;
-    gl_Position = pos;
+    mat4 transform = uIndirect ? uTransforms[gl_BaseInstance + gl_InstanceID] : uTransform;
+    gl_Position = uLightSpaceMatrix * transform * vec4(aPos, 1.0);
 }
 
 #shader fragment
@@ -2,26 +2,45 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include <core/Core.h>
 
 namespace Engine
 {
 
+template<typename T>
+struct AsyncAssetLoader;
+
+// Decoded 16-bit samples, ready to be handed to the audio device
+struct AudioData
+{
+    std::vector<int16_t> samples;
+    uint32_t channels = 0;
+    uint32_t sampleRate = 0;
+};
+
 class AudioBuffer
 {
     friend class AudioSource;
     friend class SoundEngine;
+    friend struct AsyncAssetLoader<AudioBuffer>;
 
 private:
     AudioBuffer(const std::string& filepath);
+    AudioBuffer(const AudioData& data);
     AudioBuffer(uint32_t id);
 
     static Reference<AudioBuffer> create(const std::string& path);
 
-    // 16-bit bitdepth
-    static void loadWAV(const std::string& path, uint32_t buffer);
-    static void loadMP3(const std::string& path, uint32_t buffer);
+    // Reads and decodes the file without touching the audio device, so it can run on any thread
+    static bool decode(const std::string& path, AudioData& data);
+
+    // 16-bit bitdepth, decoded from the file's contents
+    static bool loadWAV(const std::string& path, const std::vector<uint8_t>& file, AudioData& data);
+    static bool loadMP3(const std::string& path, const std::vector<uint8_t>& file, AudioData& data);
+
+    void setData_(const AudioData& data);
 
     uint32_t m_id = 0;
 
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+#include <core/Core.h>
+
+namespace Engine
+{
+
+class JobCounter;
+
+struct Job
+{
+    std::function<void()> function;
+    JobCounter* counter = nullptr;
+};
+
+// Counts outstanding jobs. Pass one to JobSystem::execute(), then JobSystem::wait() on it.
+// Jobs queued with JobSystem::executeAfter() are parked on their dependency until it reaches zero, so it must outlive them.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    // The job that finished last may still hold the lock once the count reads zero
+    ~JobCounter() { std::lock_guard<std::mutex> lock(m_mutex); }
+
+    inline bool isDone() const { return m_count.load(std::memory_order_acquire) == 0; }
+    inline uint32_t getCount() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint32_t> m_count = 0;
+
+    mutable std::mutex m_mutex;
+    mutable std::vector<Job> m_waiting;
+
+    friend class JobSystem;
+};
+
+// Singleton. One work-stealing queue per thread (the main thread included): a thread pushes and pops at the back of
+// its own queue, idle threads steal from the front of the others.
+class JobSystem
+{
+private:
+    JobSystem();
+
+public:
+    ~JobSystem();
+
+    static JobSystem* getInstance();
+
+    void execute(const std::function<void()>& function, JobCounter* counter = nullptr);
+
+    // Queues a job that only starts once 'dependency' has finished. Until then it waits on the counter, not in a queue.
+    void executeAfter(const JobCounter& dependency, const std::function<void()>& function, JobCounter* counter = nullptr);
+
+    // Queues a job that only worker threads run, once they have no other jobs. For long running work such as
+    // file loading, which must never be picked up by the main thread while it waits on a counter.
+    void executeBackground(const std::function<void()>& function, JobCounter* counter = nullptr);
+
+    // Blocks until the counter reaches zero. The calling thread runs queued jobs while it waits.
+    void wait(const JobCounter& counter);
+
+    // Calls func(i) for i in [0, count), split into jobs of batchSize iterations. Returns when all have run.
+    template<typename F>
+    void parallelFor(uint32_t count, uint32_t batchSize, F&& func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (batchSize == 0)
+        {
+            batchSize = 1;
+        }
+
+        if (m_workers.empty() || count <= batchSize)
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                func(i);
+            }
+
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t start = 0; start < count; start += batchSize)
+        {
+            uint32_t end = std::min(start + batchSize, count);
+
+            execute([&func, start, end]()
+            {
+                for (uint32_t i = start; i < end; i++)
+                {
+                    func(i);
+                }
+            }, &counter);
+        }
+
+        wait(counter);
+    }
+
+    inline uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+    // Index of the calling thread: 0 for the main thread, 1..n for workers
+    static uint32_t getThreadIndex();
+
+    // Game starts and stops the job system, programs without a Game (tools, benchmarks) call these themselves.
+    // Until initialize(), jobs run inline as they are queued. 0 workers means one per core, less the calling thread's.
+    void initialize(uint32_t workerCount = 0);
+
+    // Stops the workers. Jobs still queued run on the calling thread, background jobs are dropped and their counters
+    // released, so no wait() is left hanging.
+    void finalize();
+
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void push_(Job&& job);
+    void schedule_(Job&& job);
+    void release_(JobCounter& counter);
+    bool pop_(uint32_t index, Job& job);
+    bool steal_(uint32_t thief, Job& job);
+    bool popBackground_(Job& job);
+    bool runNext_(uint32_t index);
+    void run_(Job& job);
+
+    void workerLoop_(uint32_t index);
+
+    std::vector<std::thread> m_workers;
+    std::vector<Owned<WorkQueue>> m_queues;
+    WorkQueue m_backgroundQueue;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<uint32_t> m_pendingJobs = 0;
+
+    std::atomic<bool> m_running = false;
+};
+
+}
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstdlib>
+#include <array>
 
 #include <renderer/Buffer.h>
 
+#include <GL/glew.h>
+
 namespace Engine
 {
 
@@ -33,6 +36,13 @@ public:
         return m_layout;
     }
 
+    inline size_t getSize() const override
+    {
+        return m_size;
+    }
+
+    void copyData(const VertexBuffer& source, size_t size, size_t readOffset, size_t writeOffset) override;
+
 private:
     uint32_t m_id = 0;
 
@@ -69,6 +79,8 @@ public:
         return m_count;
     }
 
+    void copyData(const IndexBuffer& source, uint32_t count, uint32_t readOffset, uint32_t writeOffset) override;
+
 private:
     uint32_t m_id = 0;
     uint32_t m_count = 0;
@@ -85,6 +97,7 @@ class GLUniformBuffer : public UniformBuffer
 public:
     GLUniformBuffer(size_t size, uint32_t bindingPoint); // Dynamic
     GLUniformBuffer(const void* data, size_t size, uint32_t bindingPoint); // Static
+    ~GLUniformBuffer();
 
     void setBlockDeclaration(const Shader& shader) override;
 
@@ -95,6 +108,8 @@ public:
     void bind() const override;
     void unbind() const override;
 
+    void bindRange() const override;
+
     void* getBufferPtr(size_t size, size_t offset) const override;
     void* getBufferPtr(size_t offset) const override;
     void unmap() const override;
@@ -112,4 +127,76 @@ private:
     std::unordered_map<std::string, size_t> m_variableOffsets;
 };
 
+class GLShaderStorageBuffer : public ShaderStorageBuffer
+{
+public:
+    GLShaderStorageBuffer(size_t size, uint32_t bindingPoint);
+    ~GLShaderStorageBuffer();
+
+    void setData(const void* data, size_t size, size_t offset = 0) override;
+    void reserve(size_t size) override;
+
+    void bindRange() const override;
+
+    inline size_t getSize() const override { return m_size; }
+
+private:
+    uint32_t m_id = 0;
+    uint32_t m_bindingPoint = 0;
+
+    size_t m_size = 0;
+};
+
+class GLIndirectBuffer : public IndirectBuffer
+{
+public:
+    GLIndirectBuffer(uint32_t capacity);
+    ~GLIndirectBuffer();
+
+    void setData(const DrawIndirectCommand* commands, uint32_t count, uint32_t offset = 0) override;
+
+    void bind() const override;
+
+    inline uint32_t getCapacity() const override { return m_capacity; }
+
+private:
+    void reserve_(uint32_t capacity);
+
+    uint32_t m_id = 0;
+    uint32_t m_capacity = 0;
+};
+
+class GLStreamBuffer : public StreamBuffer
+{
+public:
+    GLStreamBuffer(size_t regionSize);
+    ~GLStreamBuffer();
+
+    StreamAllocation reserve(size_t size, size_t alignment = 1) override;
+    void commit(size_t size) override;
+
+    void nextFrame() override;
+
+    void bind() const override;
+    void bindRange(uint32_t bindingPoint, size_t offset, size_t size) const override;
+
+    inline size_t getRegionSize() const override { return m_regionSize; }
+
+private:
+    // Fences the current region and moves to the next one once the GPU is done with it
+    void advance_();
+    void wait_(uint32_t region);
+
+    uint32_t m_id = 0;
+
+    uint8_t* m_memory = nullptr;
+    size_t m_regionSize = 0;
+
+    uint32_t m_region = 0;
+    size_t m_head = 0; // Committed bytes in the current region
+    size_t m_reserved = 0; // Start of the last reservation
+
+    std::array<GLsync, FRAME_COUNT> m_fences = {};
+};
+
 }
\ No newline at end of file
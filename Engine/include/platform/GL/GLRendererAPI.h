@@ -13,14 +13,24 @@ public:
     void setDepthTesting(bool enabled) override;
     void setBlend(bool enabled) override;
     void setBlendFunction(BlendFunction src, BlendFunction dst) override;
+    void setDepthFunction(DepthFunction function) override;
+
+    void bindTexture(uint32_t slot, uint32_t id) override;
+    void copyTexture(uint32_t source, uint32_t destination, uint32_t width, uint32_t height) override;
 
     void setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
     void setClearColor(const math::vec4& color) override;
     void clear(uint32_t buffer) override;
 
-    void renderIndexed(Reference<VertexArray> array, uint32_t count, uint32_t offset) override;
+    void renderIndexed(Reference<VertexArray> array, uint32_t count, uint32_t offset, int32_t baseVertex) override;
     void renderInstanced(const Reference<VertexArray>& array, uint32_t instanceCount, uint32_t count, uint32_t offset) override;
+    void renderMultiIndirect(const Reference<VertexArray>& array, const IndirectBuffer& commands, uint32_t drawCount, uint32_t first) override;
+
+    void invalidateState() override;
+
+    void resetStateStatistics() override;
+    RendererStateStatistics getStateStatistics() const override;
 };
 
 }
\ No newline at end of file
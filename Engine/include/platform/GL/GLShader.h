@@ -16,6 +16,15 @@ public:
     void unbind() const override;
     void bind() const override;
 
+    UniformHandle getUniformHandle(const std::string& name) override;
+
+    void setInt(UniformHandle handle, int32_t value) override;
+    void setFloat(UniformHandle handle, float value) override;
+    void setFloat3(UniformHandle handle, const math::vec3& value) override;
+    void setFloat4(UniformHandle handle, const math::vec4& value) override;
+    void setMatrix3(UniformHandle handle, const math::mat3& value) override;
+    void setMatrix4(UniformHandle handle, const math::mat4& value) override;
+
     void setInt(const std::string& name, int32_t value) override;
     void setInt2(const std::string& name, const math::ivec2& value) override;
     void setInt3(const std::string& name, const math::ivec3& value) override;
@@ -69,9 +78,11 @@ private:
 
     std::string processMacros(const std::string& souce, const std::unordered_map<std::string, std::string>& macros);
 
-    std::unordered_map<std::string, uint32_t> m_uniformLocations;
+    // Filled with every active uniform after linking, names missing from it are looked up once and cached
+    std::unordered_map<std::string, int32_t> m_uniformLocations;
 
-    uint32_t getUniformLocation(const std::string& uniform);
+    void loadUniformLocations();
+    int32_t getUniformLocation(const std::string& uniform);
 
     std::string m_path = "";
 };
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <GL/glew.h>
+
+namespace Engine
+{
+
+// Shadow copy of the GL state the engine touches. Calls that would set a value GL already has are dropped.
+// Anything that changes state behind the cache's back (ImGui, context switches) must call invalidate() afterwards.
+class GLStateCache
+{
+public:
+    static constexpr uint32_t MAX_TEXTURE_UNITS = 32;
+    static constexpr uint32_t MAX_BUFFER_BINDINGS = 16;
+
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint array);
+    static void bindBuffer(GLenum target, GLuint buffer);
+    static void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    static void bindTextureUnit(GLuint unit, GLuint texture);
+    static void bindFramebuffer(GLuint framebuffer);
+
+    static void setEnabled(GLenum capability, bool enabled);
+    static void blendFunc(GLenum src, GLenum dst);
+    static void depthFunc(GLenum func);
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // Deleting a bound object resets the binding in GL, so these keep the cache in sync (names get reused)
+    static void deleteProgram(GLuint program);
+    static void deleteVertexArray(GLuint array);
+    static void deleteBuffer(GLuint buffer);
+    static void deleteTextures(GLsizei count, const GLuint* textures);
+    static void deleteFramebuffer(GLuint framebuffer);
+
+    // Forgets everything, the next call of each kind goes to GL
+    static void invalidate();
+
+    // Moves the running counters into the last frame's and starts counting again
+    static void resetStatistics();
+
+    inline static uint32_t getIssued() { return s_lastIssued; }
+    inline static uint32_t getFiltered() { return s_lastFiltered; }
+
+private:
+    static constexpr GLuint UNKNOWN = UINT32_MAX;
+
+    struct BufferRange
+    {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    enum Capability
+    {
+        DepthTest = 0, Blend, CullFace, StencilTest,
+        CapabilityCount
+    };
+
+    static int32_t getCapabilityIndex_(GLenum capability);
+    static int32_t getBufferIndex_(GLenum target);
+    static std::array<BufferRange, MAX_BUFFER_BINDINGS>* getBufferRanges_(GLenum target);
+
+    // Returns true if the call has to be issued
+    static bool update_(GLuint& cached, GLuint value);
+
+    static inline GLuint s_program = UNKNOWN;
+    static inline GLuint s_vertexArray = UNKNOWN;
+    static inline GLuint s_framebuffer = UNKNOWN;
+    static inline std::array<GLuint, 4> s_buffers = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+    static inline std::array<BufferRange, MAX_BUFFER_BINDINGS> s_uniformRanges;
+    static inline std::array<BufferRange, MAX_BUFFER_BINDINGS> s_storageRanges;
+    static inline std::array<GLuint, MAX_TEXTURE_UNITS> s_textures;
+    static inline std::array<GLuint, CapabilityCount> s_capabilities = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+    static inline GLuint s_blendSrc = UNKNOWN;
+    static inline GLuint s_blendDst = UNKNOWN;
+    static inline GLuint s_depthFunc = UNKNOWN;
+    static inline std::array<GLint, 4> s_viewport = { -1, -1, -1, -1 };
+
+    static inline uint32_t s_issued = 0;
+    static inline uint32_t s_filtered = 0;
+    static inline uint32_t s_lastIssued = 0;
+    static inline uint32_t s_lastFiltered = 0;
+};
+
+}
\ No newline at end of file
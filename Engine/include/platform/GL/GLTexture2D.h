@@ -3,6 +3,8 @@
 #include <string>
 
 #include <renderer/Texture2D.h>
+#include <util/Image.h>
+#include <util/CompressedImage.h>
 
 namespace Engine
 {
@@ -11,6 +13,8 @@ namespace Utils
 {
     uint32_t getSizedTextureFormatEnumValue_(SizedTextureFormat format);
     uint32_t getTextureFormatEnumValue_(TextureFormat format);
+    uint32_t getSizedTextureFormatSize_(SizedTextureFormat format);
+    uint32_t getCompressedBlockSize_(SizedTextureFormat format);
 }
 
 class GLTexture2D : public Texture2D
@@ -18,6 +22,8 @@ class GLTexture2D : public Texture2D
 public:
     GLTexture2D(const GLTexture2D& other);
     GLTexture2D(const std::string& path, bool clamp = false, bool linear = true, bool isSRGB = true);
+    GLTexture2D(const Image& image, bool clamp = false, bool linear = true, bool isSRGB = true);
+    GLTexture2D(const CompressedImage& image, bool clamp = false, bool linear = true);
     GLTexture2D(uint32_t width, uint32_t height, SizedTextureFormat dataFormat = SizedTextureFormat::RGBA8, bool clamp = false, bool linear = true);
     ~GLTexture2D();
 
@@ -31,6 +37,8 @@ public:
     inline uint32_t getId() const override { return m_id; }
     inline const std::string& getPath() const override { return m_path; }
 
+    size_t getMemorySize() const override;
+
     // Returns if texture's edge is clamped
     inline bool isClamped() const override { return m_clamp; };
 
@@ -39,6 +47,7 @@ public:
 
     // Using linear color space. Should be enabled for HDR
     inline bool isSRGB() const override { return m_isSRGB; }
+    inline SizedTextureFormat getFormat() const override { return m_internalFormat; }
 
     bool operator==(const Texture2D& other) override;
     bool operator!=(const Texture2D& other) override;
@@ -46,10 +55,11 @@ public:
 private:
     uint32_t m_id = 0;
 
-    SizedTextureFormat m_internalFormat;
+    SizedTextureFormat m_internalFormat = SizedTextureFormat::None;
     TextureFormat m_dataFormat;
 
     uint32_t m_width = 0, m_height = 0;
+    uint32_t m_levels = 1;
 
     bool m_clamp, m_linear, m_isSRGB;
 
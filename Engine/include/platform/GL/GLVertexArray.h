@@ -15,6 +15,7 @@ public:
     void unbind() const override;
 
     void addVertexBuffer(const Reference<VertexBuffer>& buffer) override;
+    void addVertexBuffer(const StreamBuffer& buffer, const BufferLayout& layout) override;
     void setIndexBuffer(const Reference<IndexBuffer>& buffer) override;
 
     inline Reference<IndexBuffer> getIndexBuffer() const { return m_indexBuffer; }
@@ -30,6 +31,9 @@ public:
     }
 
 private:
+    // Points the attributes at the bound array buffer
+    void setAttributes_(const BufferLayout& layout);
+
     uint32_t m_id = 0;
 
     uint32_t m_attribCount = 0;
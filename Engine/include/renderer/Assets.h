@@ -4,12 +4,19 @@
 #include <unordered_map>
 #include <typeindex>
 #include <vector>
+#include <list>
+#include <deque>
+#include <algorithm>
+#include <mutex>
+#include <functional>
 
 #include <core/Logger.h>
 #include <core/Core.h>
 #include <util/io/Deserializer.h>
 #include <renderer/Texture2D.h>
 #include <renderer/shader/Shader.h>
+#include <renderer/AsyncAsset.h>
+#include <core/JobSystem.h>
 #include <util/uuid.h>
 
 namespace Engine
@@ -56,6 +63,129 @@ struct AssetLoader<Mesh>
     }
 };
 
+class Model;
+
+// Bytes an asset takes up, by where they live
+struct AssetMemory
+{
+    size_t cpu = 0;
+    size_t gpu = 0;
+
+    inline size_t getTotal() const { return cpu + gpu; }
+};
+
+struct AssetStatistics
+{
+    uint32_t assets = 0;
+    uint32_t resident = 0;
+    AssetMemory memory; // Of resident assets
+    size_t budget = 0; // Zero if unlimited
+
+    uint32_t evicted = 0;
+    uint32_t reloaded = 0;
+};
+
+// Memory accounting and reloading of an asset type. Types without a specialization count no memory and are never evicted.
+template<typename T>
+struct AssetTraits
+{
+    static AssetMemory getMemory(const T& asset) { return {}; }
+
+    // Called just before the asset is evicted. Returns what loads it again, or nullptr if it can't be, such as for
+    // assets created in code, in which case it stays resident.
+    static std::function<Reference<T>()> getReloader(const Reference<T>& asset) { return nullptr; }
+};
+
+template<>
+struct AssetTraits<Texture2D>
+{
+    static AssetMemory getMemory(const Texture2D& asset);
+    static std::function<Reference<Texture2D>()> getReloader(const Reference<Texture2D>& asset);
+};
+
+template<>
+struct AssetTraits<Mesh>
+{
+    static AssetMemory getMemory(const Mesh& asset);
+    static std::function<Reference<Mesh>()> getReloader(const Reference<Mesh>& asset);
+};
+
+// Not reloadable, the ModelLoader keeps every model it loaded, so evicting one would free nothing
+template<>
+struct AssetTraits<Model>
+{
+    static AssetMemory getMemory(const Model& asset);
+    static std::function<Reference<Model>()> getReloader(const Reference<Model>& asset) { return nullptr; }
+};
+
+template<typename T>
+class AssetCache;
+
+// Identifies an asset in its cache for as long as it is there, unlike a key it survives renames
+template<typename T>
+class AssetHandle
+{
+    friend class AssetCache<T>;
+
+public:
+    AssetHandle() = default;
+
+    inline bool isValid() const { return m_id != 0; }
+    inline uint32_t getId() const { return m_id; }
+
+    inline bool operator==(const AssetHandle& other) const { return m_id == other.m_id; }
+    inline bool operator!=(const AssetHandle& other) const { return m_id != other.m_id; }
+
+private:
+    // The slot index plus one in the low bits, so zero stays invalid. The slot's generation in the high bits,
+    // so a handle to a removed asset doesn't resolve to whatever takes its slot next.
+    static constexpr uint32_t INDEX_BITS = 24;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+    AssetHandle(uint32_t index, uint32_t generation)
+        : m_id(((generation & 0xff) << INDEX_BITS) | (index + 1)) {}
+
+    inline uint32_t getIndex_() const { return (m_id & INDEX_MASK) - 1; }
+    inline uint32_t getGeneration_() const { return m_id >> INDEX_BITS; }
+
+    uint32_t m_id = 0;
+};
+
+template<typename T>
+class AssetEntry
+{
+    friend class AssetCache<T>;
+
+public:
+    inline const std::string& getKey() const { return m_key; }
+    inline AssetHandle<T> getHandle() const { return m_handle; }
+
+    // Loads the asset again if it was evicted
+    Reference<T> get();
+
+    // Replaces the asset under the same key and handle
+    void set(const Reference<T>& asset);
+
+    // nullptr while evicted. Doesn't count as a use.
+    inline const Reference<T>& getResident() const { return m_asset; }
+    inline bool isResident() const { return m_asset != nullptr; }
+
+    // As of when it was last loaded
+    inline const AssetMemory& getMemory() const { return m_memory; }
+
+private:
+    AssetCache<T>* m_cache = nullptr;
+
+    std::string m_key;
+    AssetHandle<T> m_handle;
+
+    Reference<T> m_asset;
+    std::function<Reference<T>()> m_reload; // Set while evicted
+
+    AssetMemory m_memory;
+    uint64_t m_lastUsed = 0;
+};
+
 class IAssetCache
 {
     friend class Assets;
@@ -65,85 +195,322 @@ protected:
     virtual ~IAssetCache() = default;
 
     virtual const int getAssetCount() noexcept = 0;
+
+    // Evicts the least recently used assets nothing else references until the cache is within its budget
+    virtual void trim() = 0;
 };
 
+// Assets by key and by handle. With a budget set, assets only the cache references are evicted least recently used
+// first once their memory exceeds it, and loaded again the next time they are asked for.
 template <typename T>
 class AssetCache : public IAssetCache
 {
     friend class Assets;
+    friend class AssetEntry<T>;
 
 public:
-    void add(const std::string& key, const Reference<T>& asset);
+    // Keeps the existing asset if the key is taken
+    AssetHandle<T> add(const std::string& key, const Reference<T>& asset);
 
     NonOwning<T> get(const std::string& key);
+    Reference<T> get(AssetHandle<T> handle);
+
+    AssetHandle<T> getHandle(const std::string& key);
 
     void remove(const std::string& key);
+    void rename(const std::string& key, const std::string& newKey);
 
     const bool exists(const std::string& key);
 
     const int getAssetCount() noexcept override;
 
-    typename std::unordered_map<std::string, Reference<T>>::iterator begin() { return m_assets.begin(); }
-    typename std::unordered_map<std::string, Reference<T>>::iterator end()   { return m_assets.end(); }
-    typename std::unordered_map<std::string, Reference<T>>::const_iterator begin() const { return m_assets.begin(); }
-    typename std::unordered_map<std::string, Reference<T>>::const_iterator end()   const { return m_assets.end(); }
+    // Bytes of CPU and GPU memory, zero for no limit. Applied once per frame by Assets::update().
+    inline void setBudget(size_t bytes) { m_budget = bytes; }
+    inline size_t getBudget() const { return m_budget; }
+
+    AssetStatistics getStatistics() const;
 
-    std::unordered_map<std::string, Reference<T>>& getInternalList();
+    typename std::list<AssetEntry<T>>::iterator begin() { return m_entries.begin(); }
+    typename std::list<AssetEntry<T>>::iterator end()   { return m_entries.end(); }
+    typename std::list<AssetEntry<T>>::const_iterator begin() const { return m_entries.begin(); }
+    typename std::list<AssetEntry<T>>::const_iterator end()   const { return m_entries.end(); }
 
     void load(const std::string& path)
     {
-        m_assets.insert(std::make_pair(Utils::genUUID(), AssetLoader<T>::load(path)));
+        add(Utils::genUUID(), AssetLoader<T>::load(path));
     }
 
 private:
-    std::unordered_map<std::string, Reference<T>> m_assets;
+    void trim() override;
+
+    AssetEntry<T>* getEntry_(AssetHandle<T> handle);
+    Reference<T> use_(AssetEntry<T>& entry);
+
+    std::list<AssetEntry<T>> m_entries; // In the order they were added
+    std::unordered_map<std::string, AssetEntry<T>*> m_keys;
+
+    std::vector<AssetEntry<T>*> m_slots; // By handle index, nullptr if free
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeSlots;
+
+    uint64_t m_clock = 0;
+    size_t m_budget = 0;
+
+    uint32_t m_evicted = 0;
+    uint32_t m_reloaded = 0;
 };
 
 // -------------------------------------------------------------------------------------------
 
 template<typename T>
-void AssetCache<T>::add(const std::string& key, const Reference<T>& asset)
+Reference<T> AssetEntry<T>::get()
+{
+    return m_cache->use_(*this);
+}
+
+template<typename T>
+void AssetEntry<T>::set(const Reference<T>& asset)
+{
+    m_asset = asset;
+    m_reload = nullptr;
+    m_memory = asset ? AssetTraits<T>::getMemory(*asset) : AssetMemory();
+    m_lastUsed = ++m_cache->m_clock;
+}
+
+template<typename T>
+AssetHandle<T> AssetCache<T>::add(const std::string& key, const Reference<T>& asset)
 {
-    m_assets.insert(std::make_pair(key, asset));
+    auto found = m_keys.find(key);
+    if (found != m_keys.end())
+    {
+        return found->second->m_handle;
+    }
+
+    uint32_t index;
+    if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back(nullptr);
+        m_generations.push_back(0);
+    }
+
+    AssetEntry<T>& entry = m_entries.emplace_back();
+    entry.m_cache = this;
+    entry.m_key = key;
+    entry.m_handle = AssetHandle<T>(index, m_generations[index]);
+    entry.m_asset = asset;
+    entry.m_lastUsed = ++m_clock;
+
+    if (asset)
+    {
+        entry.m_memory = AssetTraits<T>::getMemory(*asset);
+    }
+
+    m_slots[index] = &entry;
+    m_keys.emplace(key, &entry);
+
+    return entry.m_handle;
 }
 
 template<typename T>
 NonOwning<T> AssetCache<T>::get(const std::string& key)
 {
-    if (!exists(key))
+    auto found = m_keys.find(key);
+    if (found == m_keys.end())
     {
         Reference<T> ref(nullptr);
         return ref;
     }
 
-    return m_assets.at(key);
+    return use_(*found->second);
+}
+
+template<typename T>
+Reference<T> AssetCache<T>::get(AssetHandle<T> handle)
+{
+    AssetEntry<T>* entry = getEntry_(handle);
+
+    return entry ? use_(*entry) : nullptr;
+}
+
+template<typename T>
+AssetHandle<T> AssetCache<T>::getHandle(const std::string& key)
+{
+    auto found = m_keys.find(key);
+
+    return found != m_keys.end() ? found->second->m_handle : AssetHandle<T>();
 }
 
 template<typename T>
 void AssetCache<T>::remove(const std::string& key)
 {
-    if (this->exists(key))
+    auto found = m_keys.find(key);
+    if (found == m_keys.end())
+    {
+        return;
+    }
+
+    AssetEntry<T>* entry = found->second;
+    uint32_t index = entry->m_handle.getIndex_();
+
+    m_slots[index] = nullptr;
+    m_generations[index]++;
+    m_freeSlots.push_back(index);
+
+    m_keys.erase(found);
+    m_entries.remove_if([entry](const AssetEntry<T>& other) { return &other == entry; });
+}
+
+template<typename T>
+void AssetCache<T>::rename(const std::string& key, const std::string& newKey)
+{
+    auto found = m_keys.find(key);
+    if (found == m_keys.end() || exists(newKey))
     {
-        m_assets.erase(key);
+        return;
     }
+
+    AssetEntry<T>* entry = found->second;
+    entry->m_key = newKey;
+
+    m_keys.erase(found);
+    m_keys.emplace(newKey, entry);
 }
 
 template<typename T>
 const bool AssetCache<T>::exists(const std::string& key)
 {
-    return m_assets.find(key) != m_assets.end();
+    return m_keys.find(key) != m_keys.end();
 }
 
 template<typename T>
 const int AssetCache<T>::getAssetCount() noexcept
 {
-    return m_assets.size();
+    return m_entries.size();
 }
 
 template<typename T>
-std::unordered_map<std::string, Reference<T>>& AssetCache<T>::getInternalList()
+AssetStatistics AssetCache<T>::getStatistics() const
 {
-    return m_assets;
+    AssetStatistics statistics;
+    statistics.assets = static_cast<uint32_t>(m_entries.size());
+    statistics.budget = m_budget;
+    statistics.evicted = m_evicted;
+    statistics.reloaded = m_reloaded;
+
+    for (auto& entry : m_entries)
+    {
+        if (entry.isResident())
+        {
+            statistics.resident++;
+            statistics.memory.cpu += entry.m_memory.cpu;
+            statistics.memory.gpu += entry.m_memory.gpu;
+        }
+    }
+
+    return statistics;
+}
+
+template<typename T>
+void AssetCache<T>::trim()
+{
+    if (m_budget == 0)
+    {
+        return;
+    }
+
+    size_t used = 0;
+    std::vector<AssetEntry<T>*> candidates;
+
+    for (auto& entry : m_entries)
+    {
+        if (!entry.isResident())
+        {
+            continue;
+        }
+
+        used += entry.m_memory.getTotal();
+
+        // Only the cache holds it
+        if (entry.m_asset.use_count() == 1 && entry.m_memory.getTotal() > 0)
+        {
+            candidates.push_back(&entry);
+        }
+    }
+
+    if (used <= m_budget)
+    {
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const AssetEntry<T>* a, const AssetEntry<T>* b)
+    {
+        return a->m_lastUsed < b->m_lastUsed;
+    });
+
+    for (AssetEntry<T>* entry : candidates)
+    {
+        if (used <= m_budget)
+        {
+            break;
+        }
+
+        auto reload = AssetTraits<T>::getReloader(entry->m_asset);
+        if (!reload)
+        {
+            continue;
+        }
+
+        entry->m_reload = std::move(reload);
+        entry->m_asset = nullptr;
+
+        used -= entry->m_memory.getTotal();
+        m_evicted++;
+    }
+}
+
+template<typename T>
+AssetEntry<T>* AssetCache<T>::getEntry_(AssetHandle<T> handle)
+{
+    if (!handle.isValid())
+    {
+        return nullptr;
+    }
+
+    uint32_t index = handle.getIndex_();
+
+    if (index >= m_slots.size() || m_slots[index] == nullptr || (m_generations[index] & 0xff) != handle.getGeneration_())
+    {
+        return nullptr;
+    }
+
+    return m_slots[index];
+}
+
+template<typename T>
+Reference<T> AssetCache<T>::use_(AssetEntry<T>& entry)
+{
+    entry.m_lastUsed = ++m_clock;
+
+    if (!entry.m_asset && entry.m_reload)
+    {
+        entry.m_asset = entry.m_reload();
+        entry.m_reload = nullptr;
+
+        if (entry.m_asset)
+        {
+            entry.m_memory = AssetTraits<T>::getMemory(*entry.m_asset);
+        }
+
+        m_reloaded++;
+    }
+
+    return entry.m_asset;
 }
 
 // -------------------------------------------------------------------------------------------
@@ -158,14 +525,9 @@ public:
     ~Assets();
 
     template<typename T>
-    static void add(const std::string& key, Reference<T> asset)
+    static AssetHandle<T> add(const std::string& key, Reference<T> asset)
     {
-        if (!cacheExists<T>())
-        {
-            m_instance->m_caches.insert(std::pair<std::type_index, IAssetCache*>(typeid(T), new AssetCache<T>()));
-        }
-
-        getCache<T>().add(key, asset);
+        return getCache<T>().add(key, asset);
     }
 
     template<typename T>
@@ -180,14 +542,21 @@ public:
     template<typename T>
     static NonOwning<T> get(const std::string& key)
     {
-        if (!cacheExists<T>())
-        {
-            m_instance->m_caches.insert(std::pair<std::type_index, IAssetCache*>(typeid(T), new AssetCache<T>()));
-        }
-
         return getCache<T>().get(key);
     }
 
+    template<typename T>
+    static Reference<T> get(AssetHandle<T> handle)
+    {
+        return getCache<T>().get(handle);
+    }
+
+    template<typename T>
+    static AssetHandle<T> getHandle(const std::string& key)
+    {
+        return getCache<T>().getHandle(key);
+    }
+
     template<typename T>
     static bool exists(const std::string& key)
     {
@@ -210,8 +579,91 @@ public:
         getCache<T>().remove(key);
     }
 
+    template<typename T>
+    static void rename(const std::string& key, const std::string& newKey)
+    {
+        getCache<T>().rename(key, newKey);
+    }
+
+    // Bytes of memory the assets of a type may take before unreferenced ones are evicted, zero for no limit
+    template<typename T>
+    static void setBudget(size_t bytes)
+    {
+        getCache<T>().setBudget(bytes);
+    }
+
+    template<typename T>
+    static AssetStatistics getStatistics()
+    {
+        if (!cacheExists<T>())
+        {
+            return {};
+        }
+
+        return getCache<T>().getStatistics();
+    }
+
     static void flush();
 
+    // Returns straight away. The file is decoded on a worker thread, then the asset is created on the main thread by
+    // update(). Requests for a file that is still loading share its handle. Only called from the main thread.
+    template<typename T>
+    static Reference<AsyncAsset<T>> loadAsync(const std::string& path, const typename AsyncAsset<T>::Callback& callback = nullptr)
+    {
+        static std::unordered_map<std::string, std::weak_ptr<AsyncAsset<T>>> loading;
+
+        auto found = loading.find(path);
+        if (found != loading.end())
+        {
+            auto asset = found->second.lock();
+
+            if (asset && asset->getState() == AssetState::Loading)
+            {
+                if (callback)
+                {
+                    asset->onLoaded(callback);
+                }
+
+                return asset;
+            }
+        }
+
+        auto asset = Reference<AsyncAsset<T>>(new AsyncAsset<T>(path, AsyncAssetLoader<T>::getPlaceholder()));
+        loading[path] = asset;
+
+        if (callback)
+        {
+            asset->onLoaded(callback);
+        }
+
+        // The jobs keep the handle alive, so callbacks fire even if the caller lets go of it
+        JobSystem::getInstance()->executeBackground([asset]()
+        {
+            auto decoded = createReference<typename AsyncAssetLoader<T>::Decoded>(AsyncAssetLoader<T>::decode(asset->getPath()));
+
+            queueUpload_(AsyncAssetLoader<T>::getUploadSize(*decoded), [asset, decoded]()
+            {
+                asset->complete_(AsyncAssetLoader<T>::upload(*decoded, asset->getPath()));
+
+                auto entry = loading.find(asset->getPath());
+                if (entry != loading.end() && entry->second.lock() == asset)
+                {
+                    loading.erase(entry);
+                }
+            });
+        });
+
+        return asset;
+    }
+
+    // Creates assets decoded by loadAsync(), up to the upload budget, then evicts assets over their cache's budget.
+    // Called by the game once per frame.
+    static void update();
+
+    // Bytes of decoded data turned into assets per frame. At least one asset is created each frame regardless.
+    static inline void setUploadBudget(size_t bytes) { m_instance->m_uploadBudget = bytes; }
+    static inline size_t getUploadBudget() { return m_instance->m_uploadBudget; }
+
     template<typename T>
     static unsigned int getAssetCount() noexcept
     {
@@ -243,11 +695,11 @@ public:
     template<typename T>
     static const std::string& find(const Reference<T>& assetToFind)
     {
-        for (auto& asset : getCache<T>().getInternalList())
+        for (auto& entry : getCache<T>())
         {
-            if (asset.second == assetToFind)
+            if (entry.getResident() == assetToFind)
             {
-                return asset.first;
+                return entry.getKey();
             }
         }
 
@@ -256,8 +708,20 @@ public:
     }
 
 private:
+    struct AssetUpload
+    {
+        size_t size = 0;
+        std::function<void()> function;
+    };
+
+    static void queueUpload_(size_t size, const std::function<void()>& function);
+
     std::unordered_map<std::type_index, IAssetCache*> m_caches;
 
+    std::mutex m_uploadMutex;
+    std::deque<AssetUpload> m_uploads;
+    size_t m_uploadBudget = 16 * 1024 * 1024;
+
     static Assets* m_instance;
 };
 
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include <core/Core.h>
+#include <core/Logger.h>
+#include <audio/AudioBuffer.h>
+#include <renderer/Texture2D.h>
+
+namespace Engine
+{
+
+class Image;
+class CompressedImage;
+class Mesh;
+class MeshCache;
+
+enum class AssetState
+{
+    Loading,
+    Ready,
+    Failed
+};
+
+// Handle returned by Assets::loadAsync(). Only used from the main thread.
+template<typename T>
+class AsyncAsset
+{
+    friend class Assets;
+
+public:
+    using Callback = std::function<void(const Reference<T>&)>;
+
+    // The loader's placeholder until the asset is ready, which may be nullptr
+    inline Reference<T> get() const { return m_asset ? m_asset : m_placeholder; }
+
+    inline AssetState getState() const { return m_state; }
+    inline bool isReady() const { return m_state == AssetState::Ready; }
+    inline const std::string& getPath() const { return m_path; }
+
+    // Called once the asset is ready, straight away if it already is. Never called if loading fails.
+    void onLoaded(const Callback& callback)
+    {
+        if (m_state == AssetState::Ready)
+        {
+            callback(m_asset);
+        }
+        else if (m_state == AssetState::Loading)
+        {
+            m_callbacks.push_back(callback);
+        }
+    }
+
+private:
+    AsyncAsset(const std::string& path, const Reference<T>& placeholder)
+        : m_path(path), m_placeholder(placeholder)
+    {
+
+    }
+
+    void complete_(const Reference<T>& asset)
+    {
+        if (!asset)
+        {
+            Logger::getCoreLogger()->error("Could not load asset: %s", m_path.c_str());
+
+            m_state = AssetState::Failed;
+            m_callbacks.clear();
+            return;
+        }
+
+        m_asset = asset;
+        m_state = AssetState::Ready;
+
+        for (auto& callback : m_callbacks)
+        {
+            callback(m_asset);
+        }
+
+        m_callbacks.clear();
+    }
+
+    std::string m_path;
+
+    Reference<T> m_asset;
+    Reference<T> m_placeholder;
+    AssetState m_state = AssetState::Loading;
+
+    std::vector<Callback> m_callbacks;
+};
+
+// Splits loading an asset type in two: decode() reads and decodes the file on a worker thread, upload() creates the
+// asset from the result on the main thread, where GPU and audio resources can be created. getUploadSize() is what the
+// upload counts against the per-frame budget, in bytes.
+template<typename T>
+struct AsyncAssetLoader;
+
+// Only one of the two is set, compressed for .ktx2 and .dds files
+struct DecodedTexture
+{
+    Reference<Image> image;
+    Reference<CompressedImage> compressed;
+};
+
+template<>
+struct AsyncAssetLoader<Texture2D>
+{
+    using Decoded = DecodedTexture;
+
+    static Decoded decode(const std::string& path);
+    static size_t getUploadSize(const Decoded& decoded);
+    static Reference<Texture2D> upload(const Decoded& decoded, const std::string& path);
+    static Reference<Texture2D> getPlaceholder();
+};
+
+// Loads the first mesh of the file, the same one the Editor imports. Its textures then load asynchronously as well.
+template<>
+struct AsyncAssetLoader<Mesh>
+{
+    using Decoded = Reference<MeshCache>;
+
+    static Decoded decode(const std::string& path);
+    static size_t getUploadSize(const Decoded& decoded);
+    static Reference<Mesh> upload(const Decoded& decoded, const std::string& path);
+    static Reference<Mesh> getPlaceholder();
+};
+
+template<>
+struct AsyncAssetLoader<AudioBuffer>
+{
+    using Decoded = AudioData;
+
+    static Decoded decode(const std::string& path);
+    static size_t getUploadSize(const Decoded& decoded);
+    static Reference<AudioBuffer> upload(const Decoded& decoded, const std::string& path);
+    static Reference<AudioBuffer> getPlaceholder();
+};
+
+// Images are CPU side only, nothing is left to do on the main thread
+template<>
+struct AsyncAssetLoader<Image>
+{
+    using Decoded = Reference<Image>;
+
+    static Decoded decode(const std::string& path);
+    static size_t getUploadSize(const Decoded& decoded);
+    static Reference<Image> upload(const Decoded& decoded, const std::string& path);
+    static Reference<Image> getPlaceholder();
+};
+
+}
\ No newline at end of file
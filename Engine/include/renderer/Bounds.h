@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include <vector>
+
+#include <maths/math.h>
+
+namespace Engine
+{
+
+struct BoundingSphere
+{
+    math::vec3 center = math::vec3(0.f);
+    float radius = -1.f; // Negative means unbounded (never culled)
+
+    inline bool isValid() const { return radius >= 0.f; }
+
+    // Bounds of the sphere after transform. Non-uniform scale is handled by using the largest axis.
+    BoundingSphere transformed(const math::mat4& transform) const
+    {
+        if (!isValid())
+        {
+            return *this;
+        }
+
+        const auto& c0 = transform[0];
+        const auto& c1 = transform[1];
+        const auto& c2 = transform[2];
+        const auto& c3 = transform[3];
+
+        BoundingSphere sphere;
+        sphere.center.x = c0.x * center.x + c1.x * center.y + c2.x * center.z + c3.x;
+        sphere.center.y = c0.y * center.x + c1.y * center.y + c2.y * center.z + c3.y;
+        sphere.center.z = c0.z * center.x + c1.z * center.y + c2.z * center.z + c3.z;
+
+        float sx = c0.x * c0.x + c0.y * c0.y + c0.z * c0.z;
+        float sy = c1.x * c1.x + c1.y * c1.y + c1.z * c1.z;
+        float sz = c2.x * c2.x + c2.y * c2.y + c2.z * c2.z;
+
+        sphere.radius = radius * std::sqrt(std::max(sx, std::max(sy, sz)));
+
+        return sphere;
+    }
+};
+
+struct AABB
+{
+    math::vec3 min = math::vec3( FLT_MAX);
+    math::vec3 max = math::vec3(-FLT_MAX);
+
+    inline bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    inline math::vec3 getCenter() const { return math::vec3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f); }
+    inline math::vec3 getExtents() const { return math::vec3((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f); }
+
+    void expand(const math::vec3& point)
+    {
+        min = math::vec3(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z));
+        max = math::vec3(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z));
+    }
+
+    void expand(const AABB& other)
+    {
+        if (other.isValid())
+        {
+            expand(other.min);
+            expand(other.max);
+        }
+    }
+
+    // World space box enclosing this box after transform (Arvo's method)
+    AABB transformed(const math::mat4& transform) const
+    {
+        if (!isValid())
+        {
+            return *this;
+        }
+
+        math::vec3 center = getCenter();
+        math::vec3 extents = getExtents();
+
+        const auto& c0 = transform[0];
+        const auto& c1 = transform[1];
+        const auto& c2 = transform[2];
+        const auto& c3 = transform[3];
+
+        math::vec3 worldCenter(c0.x * center.x + c1.x * center.y + c2.x * center.z + c3.x,
+                               c0.y * center.x + c1.y * center.y + c2.y * center.z + c3.y,
+                               c0.z * center.x + c1.z * center.y + c2.z * center.z + c3.z);
+
+        math::vec3 worldExtents(std::abs(c0.x) * extents.x + std::abs(c1.x) * extents.y + std::abs(c2.x) * extents.z,
+                                std::abs(c0.y) * extents.x + std::abs(c1.y) * extents.y + std::abs(c2.y) * extents.z,
+                                std::abs(c0.z) * extents.x + std::abs(c1.z) * extents.y + std::abs(c2.z) * extents.z);
+
+        AABB box;
+        box.min = math::vec3(worldCenter.x - worldExtents.x, worldCenter.y - worldExtents.y, worldCenter.z - worldExtents.z);
+        box.max = math::vec3(worldCenter.x + worldExtents.x, worldCenter.y + worldExtents.y, worldCenter.z + worldExtents.z);
+
+        return box;
+    }
+
+    // Sphere centred on the box, grown to contain every point
+    template<typename Vertex>
+    static void fromVertices(const std::vector<Vertex>& vertices, AABB& box, BoundingSphere& sphere)
+    {
+        box = AABB();
+        for (auto& vertex : vertices)
+        {
+            box.expand(vertex.position);
+        }
+
+        if (!box.isValid())
+        {
+            sphere = BoundingSphere();
+            return;
+        }
+
+        sphere.center = box.getCenter();
+
+        float radiusSquared = 0.f;
+        for (auto& vertex : vertices)
+        {
+            float dx = vertex.position.x - sphere.center.x;
+            float dy = vertex.position.y - sphere.center.y;
+            float dz = vertex.position.z - sphere.center.z;
+
+            radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+        }
+
+        sphere.radius = std::sqrt(radiusSquared);
+    }
+};
+
+}
\ No newline at end of file
@@ -213,11 +213,17 @@ public:
 
     virtual const BufferLayout& getLayout() const = 0;
 
+    virtual size_t getSize() const = 0;
+
+    // Copies bytes from another vertex buffer without a round trip through the CPU
+    virtual void copyData(const VertexBuffer& source, size_t size, size_t readOffset, size_t writeOffset) = 0;
+
     virtual void* getBufferPtr(size_t size, size_t offset) const = 0;
     virtual void* getBufferPtr(size_t offset) const = 0;
     virtual void unmap() const = 0;
 
     static Reference<VertexBuffer> create(size_t size = 0);
+    static Reference<VertexBuffer> create(const void* data, size_t size);
 };
 
 enum class IndexDataType
@@ -241,6 +247,9 @@ public:
 
     virtual IndexDataType getDataType() const = 0;
 
+    // Copies indices from another index buffer of the same type without a round trip through the CPU
+    virtual void copyData(const IndexBuffer& source, uint32_t count, uint32_t readOffset, uint32_t writeOffset) = 0;
+
     virtual void* getBufferPtr(uint32_t size, uint32_t offset) const = 0;
     virtual void* getBufferPtr(uint32_t offset) const = 0;
     virtual void unmap() const = 0;
@@ -263,6 +272,9 @@ public:
     virtual void bind() const = 0;
     virtual void unbind() const = 0;
 
+    // Attaches the whole buffer to its block binding point
+    virtual void bindRange() const = 0;
+
     virtual void* getBufferPtr(size_t size, size_t offset) const = 0;
     virtual void* getBufferPtr(size_t offset) const = 0;
     virtual void unmap() const = 0;
@@ -272,4 +284,98 @@ public:
     static Reference<UniformBuffer> create(size_t size, uint32_t bindingPoint);
 };
 
+// Unsized GPU storage, read by shaders as a std430 buffer block
+class ShaderStorageBuffer
+{
+public:
+    virtual ~ShaderStorageBuffer() = default;
+
+    // Grows the buffer when the data doesn't fit. Growing discards the old contents.
+    virtual void setData(const void* data, size_t size, size_t offset = 0) = 0;
+    virtual void reserve(size_t size) = 0;
+
+    // Attaches the whole buffer to its block binding point
+    virtual void bindRange() const = 0;
+
+    virtual size_t getSize() const = 0;
+
+    static Reference<ShaderStorageBuffer> create(size_t size, uint32_t bindingPoint);
+};
+
+struct StreamAllocation
+{
+    void* data = nullptr;
+    size_t offset = 0; // From the start of the buffer
+    size_t size = 0;
+};
+
+// Persistently mapped memory for data rewritten every frame, split into one region per frame in flight.
+// Writes go straight to the mapped pointer. A region is only reused once the GPU has finished the frame that read it.
+class StreamBuffer
+{
+public:
+    static constexpr uint32_t FRAME_COUNT = 3;
+
+    virtual ~StreamBuffer() = default;
+
+    // Room for at least 'size' bytes at a multiple of 'alignment', and everything up to the end of the region.
+    // Moves on to the next region early when this one is full, which can wait on the GPU.
+    virtual StreamAllocation reserve(size_t size, size_t alignment = 1) = 0;
+
+    // Ends the last reservation after 'size' bytes of it were written
+    virtual void commit(size_t size) = 0;
+
+    inline StreamAllocation allocate(size_t size, size_t alignment = 1)
+    {
+        StreamAllocation allocation = reserve(size, alignment);
+
+        if (allocation.data)
+        {
+            commit(size);
+            allocation.size = size;
+        }
+
+        return allocation;
+    }
+
+    // Fences the region written this frame and waits until the GPU has released the next one
+    virtual void nextFrame() = 0;
+
+    // Binds it as the vertex buffer, for VertexArray::addVertexBuffer()
+    virtual void bind() const = 0;
+
+    // Attaches part of it to a shader storage block binding point
+    virtual void bindRange(uint32_t bindingPoint, size_t offset, size_t size) const = 0;
+
+    virtual size_t getRegionSize() const = 0;
+
+    static Reference<StreamBuffer> create(size_t regionSize);
+};
+
+// Mirrors the layout GL reads indirect indexed draws from
+struct DrawIndirectCommand
+{
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+// Draw commands for multi draw calls, written by the CPU every frame
+class IndirectBuffer
+{
+public:
+    virtual ~IndirectBuffer() = default;
+
+    // Grows the buffer when the commands don't fit. Growing discards the old contents.
+    virtual void setData(const DrawIndirectCommand* commands, uint32_t count, uint32_t offset = 0) = 0;
+
+    virtual void bind() const = 0;
+
+    virtual uint32_t getCapacity() const = 0;
+
+    static Reference<IndirectBuffer> create(uint32_t capacity);
+};
+
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <renderer/Bounds.h>
+
+namespace Engine
+{
+
+struct Plane
+{
+    math::vec3 normal = math::vec3(0.f);
+    float distance = 0.f;
+};
+
+// Spheres stored as separate component arrays, so the culling loop processes several at a time
+struct SphereBatch
+{
+    std::vector<float> x, y, z, radius;
+
+    void clear();
+    void push(const BoundingSphere& sphere);
+
+    inline uint32_t size() const { return static_cast<uint32_t>(x.size()); }
+};
+
+class Frustum
+{
+public:
+    Frustum() = default;
+
+    // Extracts the six planes from a projection * view matrix. Normals point inwards.
+    static Frustum fromMatrix(const math::mat4& viewProjection);
+
+    bool intersects(const BoundingSphere& sphere) const;
+    bool intersects(const AABB& box) const;
+
+    // Writes 1 to visible[i] if sphere i is at least partially inside. Unbounded spheres are always visible.
+    // Returns the number of visible spheres.
+    uint32_t cull(const SphereBatch& spheres, std::vector<uint8_t>& visible) const;
+
+    inline const Plane& getPlane(uint32_t index) const { return m_planes[index]; }
+
+private:
+    Plane m_planes[6];
+};
+
+}
\ No newline at end of file
@@ -13,16 +13,17 @@ struct RenderingInstance
     math::mat4 transform;
 };
 
+// Draws its meshes once per instance. Renderer3D submits every copy to the render queue, which batches them into
+// instanced draws, so repeated meshes don't need one of these to be instanced.
 class InstancedRenderer
 {
 public:
-    InstancedRenderer();
+    InstancedRenderer() = default;
 
     void add(const RenderingInstance& instance);
     void setInstance(const std::vector<Reference<Mesh>>& model);
     void setInstance(const Reference<Mesh>& mesh);
 
-    void updateInstances();
     void resetInstances();
 
     const std::vector<Reference<Mesh>>& getInstance() const { return m_meshes; }
@@ -33,12 +34,6 @@ public:
 private:
     std::vector<RenderingInstance> m_instances;
     std::vector<Reference<Mesh>> m_meshes;
-
-    Reference<VertexBuffer> m_instanceBuffer;
-
-    bool m_instanceChanged = false;
-
-    void setInstance_(const Reference<Mesh>& mesh);
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <maths/math.h>
+
+namespace Engine
+{
+
+struct PointLightData;
+
+// std430 mirrors of the ClusterBlock storage buffer in the PBR shaders
+struct ClusterHeader
+{
+    uint32_t gridX, gridY, gridZ;
+    uint32_t padding;
+
+    float zNear, zFar;
+    float sliceScale, sliceBias; // slice = log(depth) * scale + bias
+};
+
+struct ClusterRange
+{
+    uint32_t offset; // Into the light index list
+    uint32_t count;
+};
+
+// View space froxel grid for clustered forward shading. Tiles split the screen evenly, slices split depth exponentially.
+// Point lights are assigned on the CPU and the result is a compact list of light indices per cluster.
+class LightClusters
+{
+public:
+    static constexpr uint32_t GRID_X = 16;
+    static constexpr uint32_t GRID_Y = 9;
+    static constexpr uint32_t GRID_Z = 24;
+
+    static constexpr uint32_t TILE_COUNT = GRID_X * GRID_Y;
+    static constexpr uint32_t CLUSTER_COUNT = TILE_COUNT * GRID_Z;
+
+    static constexpr uint32_t CLUSTER_BINDING_POINT = 1;
+    static constexpr uint32_t INDEX_BINDING_POINT = 2;
+
+    // Rebuilds the cluster boxes, does nothing if the projection didn't change
+    void build(const math::mat4& projection);
+
+    // Light positions are in world space. Slices are processed in parallel on the job system.
+    void assign(const std::vector<PointLightData>& lights, const math::mat4& view);
+
+    inline const ClusterHeader& getHeader() const { return m_header; }
+    inline const std::vector<ClusterRange>& getRanges() const { return m_ranges; }
+    inline const std::vector<uint32_t>& getLightIndices() const { return m_lightIndices; }
+
+    uint32_t getSlice(float depth) const;
+
+private:
+    void assignSlice_(uint32_t slice);
+    static uint32_t getTile_(float ndc, uint32_t count);
+
+    ClusterHeader m_header = {};
+    math::mat4 m_projection = math::mat4(0.f);
+
+    // Cluster boxes in view space, one entry per cluster in x, y, z order
+    std::vector<float> m_minX, m_minY, m_minZ;
+    std::vector<float> m_maxX, m_maxY, m_maxZ;
+
+    // Lights of the current assign() in view space, with their slice range
+    struct ViewLight
+    {
+        float x, y, z, radius;
+        uint32_t index;
+        uint32_t firstSlice, lastSlice;
+        uint32_t firstX, lastX, firstY, lastY; // Tiles covered on screen
+    };
+
+    std::vector<ViewLight> m_lights;
+    std::vector<std::vector<uint32_t>> m_clusterLights;
+
+    std::vector<ClusterRange> m_ranges;
+    std::vector<uint32_t> m_lightIndices;
+};
+
+}
\ No newline at end of file
@@ -24,6 +24,56 @@ private:
     math::mat4 m_projection;
 };
 
+// std430 mirrors of the LightBlock storage buffer in the PBR shaders
+struct PointLightData
+{
+    math::vec3 position;
+    float intensity;
+    math::vec3 radiance;
+    float radius; // Distance at which the light is cut off
+};
+
+struct DirectionalLightData
+{
+    math::vec3 direction;
+    float intensity;
+    math::vec3 radiance;
+    float padding;
+};
+
+struct SkyLightData
+{
+    math::vec3 radiance;
+    float intensity;
+};
+
+struct LightBlockHeader
+{
+    // The size of the shaders' directional light array. The first directional light casts the cascaded shadows.
+    static constexpr int32_t MAX_DIRECTIONAL_LIGHTS = 4;
+
+    DirectionalLightData directionalLights[MAX_DIRECTIONAL_LIGHTS];
+    SkyLightData skyLight;
+    int32_t numPointLights;
+    int32_t numDirectionalLights;
+    int32_t padding[2];
+};
+
+static_assert(sizeof(PointLightData) == 32 && sizeof(DirectionalLightData) == 32 && sizeof(LightBlockHeader) == 160,
+              "Light data must match the std430 layout");
+
+// All lights of a scene, packed once per frame. The point lights follow the header in the buffer, directional lights
+// past MAX_DIRECTIONAL_LIGHTS are left out.
+struct LightBlock
+{
+    static constexpr uint32_t BINDING_POINT = 0;
+
+    LightBlockHeader header;
+    std::vector<PointLightData> pointLights;
+
+    void clear();
+};
+
 struct BaseLight
 {
 public:
@@ -31,7 +81,8 @@ public:
     BaseLight(const math::vec3& radiance_, float intensity_)
         : radiance(radiance_), intensity(intensity_), m_shadowInfo(nullptr) {}
 
-    virtual void setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const {};
+    // Writes the light into the block
+    virtual void pack(LightBlock& block) const {};
 
     math::vec3 radiance = math::vec3(1, 1, 1);
     float intensity = 1.f;
@@ -52,18 +103,21 @@ public:
     PointLight(const math::vec3& radiance, float intensity, const math::vec3& position_)
         : BaseLight(radiance, intensity) {}
 
-    void setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const override;
+    void pack(LightBlock& block) const override;
+
+    // Lights are cut off where their contribution falls below this, which bounds them for clustering
+    static constexpr float ATTENUATION_CUTOFF = 0.01f;
 
     //math::vec3 position;
 };
-// TODO: possibly add support for multiple directional lights
+
 struct DirectionalLight : public BaseLight, public GameComponent
 {
 public:
     DirectionalLight() {}
     DirectionalLight(const math::vec3& radiance, float intensity, const math::vec3& direction_);
 
-    void setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const override;
+    void pack(LightBlock& block) const override;
 
     math::vec3 direction;
 };
@@ -89,7 +143,7 @@ public:
     SkyLight(const math::vec3& radiance, float intensity)
         : BaseLight(radiance, intensity) {}
 
-    void setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const override;
+    void pack(LightBlock& block) const override;
 };
 
 }
\ No newline at end of file
@@ -1,14 +1,39 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include <core/Core.h>
 #include <renderer/shader/Shader.h>
 #include <renderer/Texture2D.h>
+#include <renderer/Buffer.h>
 
 namespace Engine
 {
 
+// Mirrors the std140 layout of the MaterialBlock uniform block in the PBR shaders
+struct MaterialBlock
+{
+    static constexpr uint32_t BINDING_POINT = 1;
+
+    float metallic;
+    float roughness;
+
+    float albedoMapToggle;
+    float normalMapToggle;
+    float metallicMapToggle;
+    float roughnessMapToggle;
+    float lightmapToggle;
+    float emissionMapToggle;
+
+    math::vec4 albedoColor; // Alpha below one draws the material in the transparent pass
+
+    float normalMapTwoChannel; // The normal map stores x and y only (BC5), z is reconstructed
+    float padding[3];
+};
+
+static_assert(sizeof(MaterialBlock) == 64, "MaterialBlock must match the std140 layout");
+
 class Material
 {
 public:
@@ -46,6 +71,9 @@ public:
     std::string name = "";
     std::string uuid = "";
 
+    // Used by the render queue to group draws of the same material
+    uint32_t sortId = s_sortIdCounter.fetch_add(1, std::memory_order_relaxed);
+
     bool operator==(const Material& other)
     {
         return other.albedoMap == albedoMap && 
@@ -63,6 +91,19 @@ public:
     {
         return !(*this == other);
     }
+
+    // Drawn in the transparent pass (blended, back to front)
+    inline bool isTransparent() const { return albedoColor.w < 1.f; }
+
+private:
+    // Re-uploads the block only if a property changed since the last bind
+    void updateUniformBuffer_() const;
+
+    mutable Reference<UniformBuffer> m_uniformBuffer = nullptr;
+    mutable MaterialBlock m_block;
+
+    // Shared by every thread that creates materials
+    static inline std::atomic<uint32_t> s_sortIdCounter = 0;
 };
 
 }
\ No newline at end of file
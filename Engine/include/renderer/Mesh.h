@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include <renderer/Buffer.h>
 #include <renderer/VertexArray.h>
 #include <renderer/Material.h>
+#include <renderer/Bounds.h>
 #include <core/Core.h>
 #include <scene/GameComponent.h>
 
@@ -21,12 +23,23 @@ public:
     Reference<VertexArray> vertexArray;
     Reference<Material> material;
 
+    // Object space bounds, filled in when vertices are set. Meshes without bounds are never culled.
+    AABB bounds;
+    BoundingSphere boundingSphere;
+
     std::string path = "";
     uint32_t id = 0;
 
+    // Used by the render queue to group draws of the same mesh
+    uint32_t sortId = s_sortIdCounter.fetch_add(1, std::memory_order_relaxed);
+
     void setVertices(const std::vector<math::vec3>& positions, const std::vector<math::vec3>& uvs, const std::vector<uint32_t>& indices);
 
     static Reference<Mesh> load(const std::string& path, unsigned int id);
+
+private:
+    // Model imports on loading jobs create meshes off the main thread
+    static inline std::atomic<uint32_t> s_sortIdCounter = 0;
 };
 
 }
\ No newline at end of file
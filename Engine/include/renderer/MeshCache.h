@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+
+#include <core/Core.h>
+#include <renderer/Model.h>
+#include <renderer/Bounds.h>
+#include <util/io/MappedFile.h>
+
+namespace Engine
+{
+
+enum class MeshTexture : uint32_t
+{
+    Albedo = 0,
+    Normal,
+    Metallic,
+    Roughness,
+    AmbientOcclusion,
+    Emission,
+
+    Count
+};
+
+struct MeshCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+
+    // Source file the meshes were cooked from, a mismatch means the cooked file is out of date
+    uint64_t sourceSize;
+    int64_t sourceTime;
+
+    uint32_t vertexStride;
+    uint32_t submeshCount;
+    uint32_t modelMeshCount;
+    uint32_t stringsSize;
+};
+
+struct MeshCacheSubmesh
+{
+    // Byte offsets from the start of the file
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+
+    uint32_t vertexCount;
+    uint32_t indexCount;
+
+    AABB bounds;
+    BoundingSphere boundingSphere;
+
+    uint32_t hasMaterial;
+    uint32_t textures[static_cast<uint32_t>(MeshTexture::Count)]; // Offsets into the string table, NO_TEXTURE if unset
+};
+
+// Mesh data as it comes out of the importer, before it is written to a cooked file
+struct CookedSubmesh
+{
+    std::vector<ModelVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    bool hasMaterial = false;
+    std::array<std::string, static_cast<size_t>(MeshTexture::Count)> textures;
+};
+
+// Meshes of a model file cooked into one binary file next to it (<source>.mesh):
+//   header | submesh table | model mesh order | string table | vertex and index data, 16 byte aligned
+// Cooked files are memory mapped and their vertex and index data is uploaded straight from the mapping.
+class MeshCache
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t NO_TEXTURE = ~0u;
+
+    // Maps the cooked file of the source, nullptr if there is none or it is out of date.
+    // Without the source, any valid cooked file is used, so cooked files can ship on their own.
+    static Reference<MeshCache> open(const std::string& sourcePath);
+
+    // Writes the cooked file and maps it. If it can't be written, the cache keeps the data in memory instead.
+    static Reference<MeshCache> cook(const std::string& sourcePath, const std::vector<CookedSubmesh>& submeshes, const std::vector<uint32_t>& modelMeshes);
+
+    static std::string getCookedPath(const std::string& sourcePath);
+
+    inline uint32_t getSubmeshCount() const { return getHeader_().submeshCount; }
+    inline const MeshCacheSubmesh& getSubmesh(uint32_t index) const { return getSubmeshes_()[index]; }
+
+    // Meshes in the order the model's node hierarchy references them
+    inline uint32_t getModelMeshCount() const { return getHeader_().modelMeshCount; }
+    inline uint32_t getModelMesh(uint32_t index) const { return getModelMeshes_()[index]; }
+
+    inline const ModelVertex* getVertices(const MeshCacheSubmesh& submesh) const { return reinterpret_cast<const ModelVertex*>(m_data + submesh.vertexOffset); }
+    inline const uint32_t* getIndices(const MeshCacheSubmesh& submesh) const { return reinterpret_cast<const uint32_t*>(m_data + submesh.indexOffset); }
+
+    // Empty if the submesh has no texture of the type
+    std::string getTexture(const MeshCacheSubmesh& submesh, MeshTexture texture) const;
+
+private:
+    // Checks that every table and blob lies within the data, and every index within its submesh's vertices
+    bool validate_() const;
+
+    inline const MeshCacheHeader& getHeader_() const { return *reinterpret_cast<const MeshCacheHeader*>(m_data); }
+    inline const MeshCacheSubmesh* getSubmeshes_() const { return reinterpret_cast<const MeshCacheSubmesh*>(m_data + sizeof(MeshCacheHeader)); }
+    inline const uint32_t* getModelMeshes_() const { return reinterpret_cast<const uint32_t*>(getSubmeshes_() + getSubmeshCount()); }
+    inline const char* getStrings_() const { return reinterpret_cast<const char*>(getModelMeshes_() + getModelMeshCount()); }
+
+    MappedFile m_file;
+    std::vector<uint8_t> m_memory; // Used when the cooked file couldn't be written
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include <core/Core.h>
+#include <renderer/Buffer.h>
+#include <renderer/VertexArray.h>
+
+namespace Engine
+{
+
+class Mesh;
+
+// Vertex and index storage shared by every mesh with the ModelVertex layout, so runs of draws can be issued as a single
+// multi draw call. Meshes are copied in on the GPU the first time they're requested, and their space is reclaimed once
+// the mesh's buffers are destroyed or replaced.
+class MeshPool
+{
+public:
+    struct Range
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t baseVertex = 0;
+    };
+
+    void init(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+    // Returns false if the mesh can't be pooled, it has to be drawn from its own vertex array instead
+    bool get(const Mesh& mesh, Range& range);
+
+    inline const Reference<VertexArray>& getVertexArray() const { return m_vertexArray; }
+
+    static bool isPoolable(const Mesh& mesh);
+
+private:
+    // First fit allocator over element offsets
+    class FreeList
+    {
+    public:
+        bool allocate(uint32_t size, uint32_t& offset);
+        void release(uint32_t offset, uint32_t size);
+        void grow(uint32_t capacity);
+
+        inline uint32_t getCapacity() const { return m_capacity; }
+
+    private:
+        struct Block
+        {
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        std::vector<Block> m_blocks; // Sorted by offset, never adjacent
+        uint32_t m_capacity = 0;
+    };
+
+    struct Entry
+    {
+        std::weak_ptr<VertexBuffer> vertexBuffer;
+        std::weak_ptr<IndexBuffer> indexBuffer;
+        uint32_t vertexCount;
+        Range range;
+    };
+
+    bool isCurrent_(const Entry& entry, const Mesh& mesh) const;
+    void release_(const Entry& entry);
+    void releaseExpired_();
+    void grow_(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+    std::unordered_map<const Mesh*, Entry> m_entries;
+
+    FreeList m_vertices;
+    FreeList m_indices;
+
+    Reference<VertexBuffer> m_vertexBuffer;
+    Reference<IndexBuffer> m_indexBuffer;
+    Reference<VertexArray> m_vertexArray;
+};
+
+}
\ No newline at end of file
@@ -1,28 +1,38 @@
 #pragma once
 
 #include <renderer/Model.h>
+#include <renderer/MeshCache.h>
 
 namespace Engine
 {
 
+// Model files are imported with Assimp once and cooked into a MeshCache, later loads map the cooked file instead
 class ModelLoader
 {
 public:
     static Reference<Model> load(const std::string& path);
     static Reference<Mesh> loadMesh(const std::string& path, unsigned int id);
 
+    // loadMesh() in two steps for background loading. The cache can be loaded on any thread, the mesh is created on
+    // the main thread. Textures are then loaded asynchronously if 'asyncTextures' is set. A map stays unset until its
+    // texture is ready, so the material shades with its scalar values meanwhile rather than a placeholder texture.
+    static Reference<MeshCache> loadMeshCache(const std::string& path);
+    static Reference<Mesh> createMesh(const MeshCache& cache, uint32_t id, const std::string& path, bool asyncTextures = false);
+
 private:
-    static void processNode_(aiNode* node, const aiScene* scene, const Reference<Model>& model);
-    static Reference<Mesh> processMesh_(aiMesh* mesh, const aiScene* scene, const Reference<Model>& model);
-    static Reference<Texture2D> loadMaterialTexture_(aiMaterial* mat, aiTextureType type, const std::string& directory);
+    static Reference<MeshCache> cook_(const std::string& path);
+
+    static void processNode_(aiNode* node, std::vector<uint32_t>& modelMeshes);
+    static void processMesh_(aiMesh* mesh, const aiScene* scene, const std::string& directory, CookedSubmesh& submesh);
+    static std::string getMaterialTexture_(aiMaterial* mat, aiTextureType type, const std::string& directory);
 
-    static const aiScene* setupAssimp_(const std::string& modelPath);
+    static Reference<Texture2D> loadTexture_(const std::string& path);
+    static void loadTextureAsync_(const std::string& path, const Reference<Material>& material, Reference<Texture2D> Material::* map);
+
+    static const aiScene* setupAssimp_(Assimp::Importer& importer, const std::string& modelPath);
 
     static inline std::vector<Reference<Texture2D>> m_texturesLoaded;
-    static inline std::unordered_map<int, Reference<Material>> m_materialsLoaded;
     static inline std::unordered_map<std::string, Reference<Model>> m_modelsLoaded;
-
-    static inline Assimp::Importer m_importer;
 };
 
 }
\ No newline at end of file
@@ -44,9 +44,24 @@ public:
         m_api->setBlendFunction(src, dst);
     }
 
-    static void renderIndexed(Reference<VertexArray> array, uint32_t count = 0, uint32_t offset = 0)
+    static void setDepthFunction(DepthFunction function)
     {
-        m_api->renderIndexed(array, count, offset);
+        m_api->setDepthFunction(function);
+    }
+
+    static void bindTexture(uint32_t slot, uint32_t id)
+    {
+        m_api->bindTexture(slot, id);
+    }
+
+    static void copyTexture(uint32_t source, uint32_t destination, uint32_t width, uint32_t height)
+    {
+        m_api->copyTexture(source, destination, width, height);
+    }
+
+    static void renderIndexed(Reference<VertexArray> array, uint32_t count = 0, uint32_t offset = 0, int32_t baseVertex = 0)
+    {
+        m_api->renderIndexed(array, count, offset, baseVertex);
     }
 
     static void renderInstanced(const Reference<VertexArray>& array, uint32_t instanceCount, uint32_t count = 0, uint32_t offset = 0)
@@ -54,11 +69,41 @@ public:
         m_api->renderInstanced(array, instanceCount, count, offset);
     }
 
+    static void renderMultiIndirect(const Reference<VertexArray>& array, const IndirectBuffer& commands, uint32_t drawCount, uint32_t first = 0)
+    {
+        m_api->renderMultiIndirect(array, commands, drawCount, first);
+    }
+
     static uint32_t defaultClearBits()
     {
         return (uint32_t)RendererBufferType::Color | (uint32_t)RendererBufferType::Depth | (uint32_t)RendererBufferType::Stencil;
     }
 
+    static void invalidateState()
+    {
+        m_api->invalidateState();
+    }
+
+    static void resetStateStatistics()
+    {
+        m_api->resetStateStatistics();
+    }
+
+    static RendererStateStatistics getStateStatistics()
+    {
+        return m_api->getStateStatistics();
+    }
+
+    static void resetStatistics()
+    {
+        m_api->resetStatistics();
+    }
+
+    static const Statistics& getStatistics()
+    {
+        return m_api->getStatistics();
+    }
+
     static RendererCapabilities getCapabilities()
     {
         return m_api->getCapabilities();
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <core/Core.h>
+#include <renderer/Bounds.h>
+
+namespace Engine
+{
+
+class Mesh;
+class Material;
+
+struct RenderObject
+{
+    Reference<Mesh> mesh;
+    Reference<Material> material;
+    math::mat4 transform;
+    BoundingSphere bounds; // World space
+    bool castShadows = true;
+    bool isStatic = false; // Static casters are kept in the cached shadow cascades
+};
+
+// Flat list of draws ordered by a 64 bit key. Storage is kept between frames, so clear() doesn't free anything.
+//
+// Key layout, most significant bits first:
+//   Opaque:      pass (2) | shader (12) | material (14) | mesh (12) | depth (24, front to back)
+//   Transparent: pass (2) | depth (24, back to front) | shader (12) | material (14) | mesh (12)
+// Opaque draws are grouped by state first and only use depth to break ties, transparent draws must be in depth order.
+class RenderQueue
+{
+public:
+    enum class Pass : uint8_t
+    {
+        Opaque = 0,
+        Transparent = 1
+    };
+
+    void clear();
+
+    // 'depth' is the view distance, normalized to [0, 1]
+    void push(const Reference<Mesh>& mesh, const Reference<Material>& material, const math::mat4& transform, const BoundingSphere& bounds, Pass pass, float depth,
+              bool castShadows = true, bool isStatic = false);
+
+    // Radix sorts the keys. Indexing afterwards is in sorted order.
+    void sort();
+
+    inline const RenderObject& operator[](uint32_t index) const { return m_objects[m_order[index]]; }
+    inline Pass getPass(uint32_t index) const { return static_cast<Pass>(m_keys[m_order[index]] >> 62); }
+
+    inline uint32_t size() const { return static_cast<uint32_t>(m_objects.size()); }
+    inline bool empty() const { return m_objects.empty(); }
+
+    static uint64_t makeKey(Pass pass, uint32_t shader, uint32_t material, uint32_t mesh, float depth);
+
+private:
+    std::vector<RenderObject> m_objects;
+    std::vector<uint64_t> m_keys;
+
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_scratch;
+};
+
+}
\ No newline at end of file
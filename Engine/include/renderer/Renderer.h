@@ -30,6 +30,9 @@ public:
     static void startFrame();
     static void endFrame();
 
+    // Called once per frame, after everything has been rendered. Fences the data streamed during the frame.
+    static void nextFrame();
+
     static void windowResize(WindowResizeEvent& event);
 
     static float hdrExposure;
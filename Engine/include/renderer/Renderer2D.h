@@ -8,6 +8,7 @@
 #include <renderer/Mesh.h>
 #include <renderer/IRenderable2D.h>
 #include <renderer/Framebuffer.h>
+#include <renderer/SpriteQueue.h>
 #include <maths/rect/rect.h>
 #include <scene/EditorCamera.h>
 
@@ -20,12 +21,7 @@ struct QuadVertex
     math::vec2 texCoord;
     math::vec4 color;
     float texIndex;
-};
-
-struct GlyphVertex
-{
-    math::vec2 position;
-    math::vec2 texCoord;
+    float sampling; // SpriteSampling
 };
 
 struct Renderer2DData
@@ -34,23 +30,26 @@ struct Renderer2DData
     static constexpr uint32_t MAX_TEXTURE_SLOTS = 32;
     static constexpr uint32_t MAX_VERTICES = MAX_SPRITES * 4;
     static constexpr uint32_t MAX_INDICES = MAX_SPRITES * 6;
-    static constexpr uint32_t MAX_GLYPHS = 512;
 
     NonOwning<Shader> textureShader;
-    NonOwning<Shader> textShader;
 
+    // Recorded until flushBatch(), which sorts them and packs them into batches
+    SpriteQueue spriteQueue;
+    SpriteQueue::Order spriteOrder = SpriteQueue::Order::Batched;
+    int32_t layer = 0;
+
+    // Quads are written straight into the stream's mapped memory, between vertexBase and vertexLimit
+    Reference<StreamBuffer> vertexStream;
     QuadVertex* vertexBase = nullptr;
     QuadVertex* vertexPointer = nullptr;
+    QuadVertex* vertexLimit = nullptr;
+    size_t vertexOffset = 0;
     uint32_t indexCount = 0;
     
     Reference<Texture2D> textureSlots[MAX_TEXTURE_SLOTS];
     uint32_t textureSlotIndex = 1;
     
     Mesh mesh;
-    
-    Reference<Mesh> textMesh;
-    GlyphVertex* textVertexBase;
-    GlyphVertex* textVertexPtr;
 
     Reference<UniformBuffer> matrixData;
 
@@ -60,14 +59,6 @@ struct Renderer2DData
         math::vec2(1, 1),
         math::vec2(1, 0)
     };
-
-    // TODO: look into text batching similar to Renderer3D.
-    // At the moment, every string of text is a seperate draw call (inefficient)
-};
-
-struct Statistics
-{
-    uint64_t drawCalls;
 };
 
 class Renderer2D
@@ -77,8 +68,12 @@ public:
     static void nextBatch();
     static void flushBatch();
     
-    static void beginScene(Camera& camera);
-    static void beginScene(Camera& camera, const math::mat4& transform);
+    // Sprites are drawn once the scene ends, in layer order. 'order' decides how sprites within a layer are ordered.
+    static void beginScene(Camera& camera, SpriteQueue::Order order = SpriteQueue::Order::Batched);
+    static void beginScene(Camera& camera, const math::mat4& transform, SpriteQueue::Order order = SpriteQueue::Order::Batched);
+
+    // Layer of the sprites rendered after this, higher layers are drawn on top. Reset to 0 by beginScene().
+    static inline void setLayer(int32_t layer) { s_data.layer = layer; }
 
     static void renderSprite(const Reference<Texture2D>& texture, const math::vec2& position, const math::vec2& size, const math::vec4& color = math::vec4(1));
     static void renderSprite(const Reference<Texture2D>& texture, const math::vec2& position, const math::vec2& size, const math::frect& texRect);
@@ -94,16 +89,27 @@ public:
     
     static void endScene();
 
-    static void renderText(const std::string& text, const Reference<TrueTypeFont>& font, const math::vec2& position, const math::vec4& color = math::vec4(0, 0, 0, 0));
-    static void renderText(const std::string& text, const Reference<TrueTypeFont>& font, const math::vec2& position, const math::vec2& size, const math::vec4& color = math::vec4(0, 0, 0, 0));
+    // Glyphs are sprites of the font atlas, so text is batched, layered and ordered like any other sprite.
+    // 'text' is UTF-8, 'size' is the character size in pixels.
+    static void renderText(const std::string& text, const Reference<TrueTypeFont>& font, const math::vec2& position, const math::vec4& color = math::vec4(0, 0, 0, 1));
+    static void renderText(const std::string& text, const Reference<TrueTypeFont>& font, const math::vec2& position, const math::vec2& size, const math::vec4& color = math::vec4(0, 0, 0, 1));
 
 private:
     static inline Renderer2DData s_data;
-    static inline Statistics s_statistics;
 
     static void init();
     static void shutdown();
 
+    // Start and issue one draw call of the sorted sprites. Starting fails if no vertex space could be reserved.
+    static bool beginBatch_();
+    static void drawBatch_();
+
+    // Slot of the texture in the current batch, drawing the batch first when every slot is taken
+    static float getTextureSlot_(const Reference<Texture2D>& texture);
+
+    // Moves the vertex stream on to the next frame's region and lets fonts evict glyphs of earlier frames
+    static void nextFrame();
+
     friend class Renderer;
 };
 
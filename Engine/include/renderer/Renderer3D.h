@@ -7,6 +7,11 @@
 #include <renderer/Model.h>
 #include <renderer/Lighting.h>
 #include <renderer/Framebuffer.h>
+#include <renderer/Frustum.h>
+#include <renderer/RenderQueue.h>
+#include <renderer/LightClusters.h>
+#include <renderer/ShadowCascades.h>
+#include <renderer/MeshPool.h>
 #include <renderer/Skybox.h>
 #include <renderer/InstancedRenderer.h>
 #include <renderer/EnvironmentMap.h>
@@ -15,10 +20,27 @@
 namespace Engine
 {
 
-struct RenderObject
+struct CullingStatistics
 {
-    Reference<Mesh> mesh;
-    math::mat4 transform;
+    uint32_t visible = 0;
+    uint32_t culled = 0;
+    uint32_t shadowVisible = 0;
+    uint32_t shadowCulled = 0;
+};
+
+// A run of the render queue issued with one call. Runs of pooled meshes sharing a material become multi draws,
+// in which repeated meshes are a single instanced command.
+struct DrawBatch
+{
+    uint32_t object; // Render queue index of the first draw
+    uint32_t firstCommand;
+    uint32_t commandCount; // 0 if the object is drawn from its own vertex array
+};
+
+struct DrawRange
+{
+    uint32_t firstCommand = 0;
+    uint32_t commandCount = 0;
 };
 
 struct Renderer3DData
@@ -33,17 +55,57 @@ struct Renderer3DData
 
     NonOwning<Shader> shadowMapShader;
 
-    Reference<Texture2D> shadowMap;
-    Reference<Framebuffer> shadowMapFramebuffer;
-    math::mat4 lightProjection;
-    math::mat4 lightView;
-    math::mat4 lightMatrix;
+    // Fitted in beginScene() when the scene has a directional light
+    ShadowCascades shadowCascades;
+    std::array<Reference<Framebuffer>, ShadowCascades::CASCADE_COUNT> shadowMaps;
+    std::array<Reference<Framebuffer>, ShadowCascades::CASCADE_COUNT> staticShadowMaps; // Cached cascades only
+    std::array<bool, ShadowCascades::CASCADE_COUNT> dynamicShadows = {}; // Dynamic casters were drawn over the static map
+    Reference<UniformBuffer> shadowData;
+    bool usingShadows = false;
 
     std::vector<const BaseLight*> lights;
+    LightBlock lightBlock;
+    Reference<ShaderStorageBuffer> lightData;
+
+    // Built for the camera in beginScene(), filled in uploadLights()
+    LightClusters lightClusters;
+    Reference<ShaderStorageBuffer> clusterData;
+    Reference<ShaderStorageBuffer> lightIndexData;
 
     math::vec3 cameraPos;
+    math::mat4 cameraView;
+
+    Frustum cameraFrustum;
+    Frustum lightFrustum;
+
+    // Filled in flushBatch(), in sorted render queue order
+    SphereBatch cullingSpheres;
+    std::vector<uint8_t> cameraVisibility;
+    std::array<std::vector<uint8_t>, ShadowCascades::CASCADE_COUNT> shadowVisibility; // Dynamic casters only in cached cascades
+    std::array<std::vector<uint8_t>, ShadowCascades::CASCADE_COUNT> staticShadowVisibility; // Cached cascades only
+    std::vector<uint8_t> casters;
+    std::vector<uint8_t> staticCasters;
+    std::vector<uint8_t> shadowCasters; // Drawn into at least one cascade
+
+    // Filled in prepareDraws(). Each command's instance transforms are written contiguously from its base instance,
+    // straight into the stream's mapped memory.
+    MeshPool meshPool;
+    std::vector<MeshPool::Range> meshRanges;
+    std::vector<uint8_t> pooled;
+    math::mat4* transforms = nullptr;
+    uint32_t transformCount = 0;
+    size_t transformOffset = 0;
+    std::vector<DrawIndirectCommand> drawCommands;
+    std::vector<DrawBatch> drawBatches;
+    std::array<DrawRange, ShadowCascades::CASCADE_COUNT> shadowDraws;
+    std::array<DrawRange, ShadowCascades::CASCADE_COUNT> staticShadowDraws;
+    bool indirectShadows = false;
+
+    Reference<StreamBuffer> transformStream;
+    uint32_t storageAlignment = 1;
+    Reference<IndirectBuffer> drawCommandData;
     
-    std::unordered_map<Reference<Material>, std::vector<RenderObject>> renderObjects;
+    RenderQueue renderQueue;
 
     bool usingSkybox = true;
 };
@@ -51,12 +113,15 @@ struct Renderer3DData
 class Renderer3D
 {
 public:
+    // Storage buffer holding the instance transforms of multi draws
+    static constexpr uint32_t TRANSFORM_BINDING_POINT = 3;
+
     static void beginScene(EditorCamera& camera);
     static void beginScene(Camera& camera, const math::mat4& transform);
 
     static void submit(const Reference<Mesh>& mesh, const math::mat4& transform); // TODO: meshes shouldn't hold materials (research further)
     static void submit(const Reference<Model>& model, const math::mat4& transform);
-    static void submit(const Reference<Mesh>& mesh, const math::mat4& transform, const Reference<Material>& material);
+    static void submit(const Reference<Mesh>& mesh, const math::mat4& transform, const Reference<Material>& material, bool castShadows = true, bool isStatic = false);
     static void submitOutline(const Reference<Mesh>& mesh, const math::mat4& transform, const math::vec3& outlineColor);
 
     static void submit(const Reference<InstancedRenderer>& instance);
@@ -76,15 +141,38 @@ public:
 
     static void renderShadows();
 
+    // Set by beginScene(). The light frustum contains every shadow cascade, or is the camera's if there are no shadows.
+    static inline const Frustum& getCameraFrustum() { return s_data.cameraFrustum; }
+    static inline const Frustum& getLightFrustum() { return s_data.lightFrustum; }
+
+    // Results of the last flushBatch()
+    static inline const CullingStatistics& getCullingStatistics() { return s_cullingStatistics; }
+
     static void useSkybox(bool use) { s_data.usingSkybox = use; }
 
 private:
-    static void setLightingUniforms(const Reference<Shader>& shader);
+    // Packs the lights in beginScene() and fits the shadow cascades to the camera
+    static void packLights();
+    static void updateShadows(const math::mat4& view, const math::mat4& projection);
+
+    // Uploads the packed lights, assigns the point lights to clusters and binds the buffers
+    static void uploadLights();
+    static void cull();
+
+    // Draws the visible casters into the bound shadow map, the pooled ones through the draw range
+    static void renderCasters(const DrawRange& draws, const std::vector<uint8_t>& visibility);
+
+    // Gathers the draws of both passes into batches and uploads the transforms and draw commands
+    static void prepareDraws();
 
     static void init();
     static void shutdown();
 
+    // Moves the transform stream on to the next frame's region
+    static void nextFrame();
+
     static inline Renderer3DData s_data;
+    static inline CullingStatistics s_cullingStatistics;
 
     friend class Renderer;
 };
@@ -37,10 +37,25 @@ struct RendererCapabilities
 {
     uint32_t maxTextureUnits;
     uint32_t maxTextureSize;
+    uint32_t storageBufferAlignment; // Offsets of storage buffer ranges must be a multiple of this
     std::string version;
     uint32_t shaderVersion;
 };
 
+// State changes requested during the last frame, and how many of them were dropped because nothing changed
+struct RendererStateStatistics
+{
+    uint32_t issued = 0;
+    uint32_t filtered = 0;
+};
+
+// Draw calls submitted during the last frame
+struct Statistics
+{
+    uint64_t drawCalls = 0;
+    uint64_t draws = 0; // Every draw packed into a multi draw call counts here
+};
+
 class RendererAPI
 {
 public:
@@ -53,13 +68,41 @@ public:
     virtual void setDepthTesting(bool enabled) = 0;
     virtual void setBlend(bool enabled) = 0;
     virtual void setBlendFunction(BlendFunction src, BlendFunction dst) = 0;
+    virtual void setDepthFunction(DepthFunction function) = 0;
+
+    virtual void bindTexture(uint32_t slot, uint32_t id) = 0;
+
+    // Copies the first level of a 2D texture into another of the same format, without going through a framebuffer
+    virtual void copyTexture(uint32_t source, uint32_t destination, uint32_t width, uint32_t height) = 0;
 
     virtual void setClearColor(const math::vec4& color) = 0;
     virtual void clear(uint32_t buffer) = 0;
 
-    virtual void renderIndexed(Reference<VertexArray> array, uint32_t count = 0, uint32_t offset = 0) = 0;
+    // 'baseVertex' is added to every index, so streamed vertices can be drawn with a fixed index buffer
+    virtual void renderIndexed(Reference<VertexArray> array, uint32_t count = 0, uint32_t offset = 0, int32_t baseVertex = 0) = 0;
     virtual void renderInstanced(const Reference<VertexArray>& array, uint32_t instanceCount, uint32_t count = 0, uint32_t offset = 0) = 0;
 
+    // Issues 'drawCount' indexed draws from the bound vertex array with one call, reading commands from 'first' onwards
+    virtual void renderMultiIndirect(const Reference<VertexArray>& array, const IndirectBuffer& commands, uint32_t drawCount, uint32_t first = 0) = 0;
+
+    // Must be called after anything outside the renderer has touched the API's state
+    virtual void invalidateState() = 0;
+
+    // Called once per frame
+    virtual void resetStateStatistics() = 0;
+    virtual RendererStateStatistics getStateStatistics() const = 0;
+
+    inline void resetStatistics()
+    {
+        m_lastStatistics = m_statistics;
+        m_statistics = Statistics();
+    }
+
+    inline const Statistics& getStatistics() const noexcept
+    {
+        return m_lastStatistics;
+    }
+
     inline constexpr const RendererCapabilities& getCapabilities() const noexcept
     {
         return m_capabilities;
@@ -69,6 +112,9 @@ public:
 
 protected:
     RendererCapabilities m_capabilities;
+
+    Statistics m_statistics;
+    Statistics m_lastStatistics;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <maths/math.h>
+#include <renderer/Frustum.h>
+
+namespace Engine
+{
+
+// std140 mirror of the ShadowBlock uniform block in the PBR shaders
+struct ShadowBlock
+{
+    static constexpr uint32_t BINDING_POINT = 3;
+
+    math::mat4 cascadeMatrices[4];
+    math::vec4 cascadeSplits; // View depth at which each cascade ends
+    math::vec4 texelSizes; // World space size of a shadow map texel in each cascade
+};
+
+// Cascaded shadow maps for the directional light. The camera's view is split in depth and each slice gets an
+// orthographic shadow map fitted to its bounding sphere. The sphere's size doesn't change as the camera turns, and the
+// maps are snapped to whole texels, so shadow edges don't shimmer.
+//
+// The far cascades are snapped to a coarse grid instead, which lets the depth of their static casters be kept across
+// frames until the light moves, the camera leaves the grid cell or the static casters inside them change. Dynamic
+// casters are drawn over a copy of it every frame.
+class ShadowCascades
+{
+public:
+    static constexpr uint32_t CASCADE_COUNT = 4;
+    static constexpr uint32_t FIRST_CACHED_CASCADE = 2;
+    static constexpr uint32_t MAP_SIZE = 1024;
+
+    static constexpr float MAX_DISTANCE = 100.f; // Shadows end here, or at the camera's far plane if it's closer
+    static constexpr float SPLIT_LAMBDA = 0.75f; // Blend between uniform (0) and logarithmic (1) splits
+    static constexpr float CASTER_DISTANCE = 100.f; // How far towards the light casters are still captured
+    static constexpr uint32_t CACHED_SNAP_TEXELS = 64; // Grid step of the cached cascades
+
+    struct Cascade
+    {
+        math::mat4 matrix; // Light projection * light view
+        Frustum frustum;
+
+        // Cached cascades only
+        uint64_t casterHash = 0;
+        bool valid = false;
+    };
+
+    // Refits the cascades to the camera. 'direction' is the direction the light travels in.
+    void update(const math::mat4& view, const math::mat4& projection, const math::vec3& direction);
+
+    // Returns true if a cached cascade has to be rendered again, given the hash of the static casters in its frustum.
+    // The cascade is considered up to date afterwards.
+    bool needsUpdate(uint32_t cascade, uint64_t casterHash);
+
+    // Forces every cached cascade to be rendered again
+    void invalidate();
+
+    inline const Cascade& getCascade(uint32_t index) const { return m_cascades[index]; }
+    inline const ShadowBlock& getBlock() const { return m_block; }
+
+    // Contains every cascade, for gathering casters before culling each cascade
+    inline const Frustum& getFrustum() const { return m_frustum; }
+
+    static inline bool isCached(uint32_t cascade) { return cascade >= FIRST_CACHED_CASCADE; }
+
+    // A cascade's caster hash is the sum of these, so casters can be visited in any order
+    static uint64_t hashCaster(const void* mesh, const math::mat4& transform);
+
+private:
+    std::array<Cascade, CASCADE_COUNT> m_cascades;
+    ShadowBlock m_block;
+    Frustum m_frustum;
+};
+
+}
\ No newline at end of file
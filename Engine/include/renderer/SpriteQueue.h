@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <core/Core.h>
+#include <renderer/Texture2D.h>
+
+namespace Engine
+{
+
+// How the fragment shader turns the texture sample into a color
+enum class SpriteSampling : uint8_t
+{
+    Color = 0,    // Sample is multiplied with the color
+    Distance = 1  // Red channel is a signed distance to an outline at 0.5, used by font atlases
+};
+
+struct Sprite
+{
+    Reference<Texture2D> texture;
+    math::vec3 positions[4];
+    math::vec4 texRect; // Normalized x1, y1, x2, y2
+    math::vec4 color;
+    SpriteSampling sampling = SpriteSampling::Color;
+};
+
+// Sprites recorded during a 2D scene, drawn in key order once it ends. Storage is kept between frames.
+//
+// Key layout, most significant bits first:
+//   Batched:    layer (16) | depth (32, back to front) | texture (16)
+//   Submission: layer (16) | 0 (48)
+// Batched order groups equal textures within a layer and depth, so the fewest batches are needed.
+// Submission order only sorts by layer; the sort is stable, so overlays keep the order they were rendered in.
+class SpriteQueue
+{
+public:
+    enum class Order : uint8_t
+    {
+        Batched = 0,
+        Submission = 1
+    };
+
+    void clear();
+
+    // 'depth' is the sprite's z, higher is drawn later
+    void push(const Sprite& sprite, int32_t layer, float depth, Order order);
+
+    void sort();
+
+    inline const Sprite& operator[](uint32_t index) const { return m_sprites[m_order[index]]; }
+
+    inline uint32_t size() const { return static_cast<uint32_t>(m_sprites.size()); }
+    inline bool empty() const { return m_sprites.empty(); }
+
+    static uint64_t makeKey(int32_t layer, float depth, uint32_t texture, Order order);
+
+private:
+    std::vector<Sprite> m_sprites;
+    std::vector<uint64_t> m_keys;
+
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_scratch;
+};
+
+}
\ No newline at end of file
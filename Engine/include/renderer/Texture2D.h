@@ -8,6 +8,9 @@
 namespace Engine
 {
 
+class Image;
+class CompressedImage;
+
 enum class SizedTextureFormat
 {
     None = 0,
@@ -20,6 +23,16 @@ enum class SizedTextureFormat
     RGBA16F,
     sRGBA8,
     sRGB8,
+    R8,
+
+    // Block compressed, uploaded from a CompressedImage
+    BC1,
+    sBC1,
+    BC3,
+    sBC3,
+    BC5,
+    BC7,
+    sBC7,
 
     Depth = Depth24Stencil8
 };
@@ -64,10 +77,10 @@ public:
     static Reference<Texture2D> create(const Reference<Texture2D>& other);
     static Reference<Texture2D> create(const std::string& file, bool clamp = false, bool linear = true, bool isSRGB = true);
     static Reference<Texture2D> create(uint32_t width, uint32_t height, SizedTextureFormat dataFormat = SizedTextureFormat::RGBA8, bool clamp = false, bool linear = true);
+    static Reference<Texture2D> create(const Image& image, bool clamp = false, bool linear = true, bool isSRGB = true);
+    static Reference<Texture2D> create(const CompressedImage& image, bool clamp = false, bool linear = true);
     static Reference<Texture2D> createWhiteTexture();
 
-    static Reference<Texture2D> asyncCreate(const std::string& file, bool isSRGB = false);
-
     virtual void setData(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height, const void* data, 
                          TextureFormat dataFormat = TextureFormat::RGBA, DataType type = DataType::UnsignedByte) = 0;
     
@@ -81,8 +94,14 @@ public:
     virtual bool isLinear() const = 0;
     virtual bool isSRGB() const = 0;
 
+    // The format the texture is stored in on the GPU
+    virtual SizedTextureFormat getFormat() const = 0;
+
     virtual uint32_t getId() const = 0;
 
+    // Bytes of GPU memory
+    virtual size_t getMemorySize() const = 0;
+
     virtual const std::string& getPath() const = 0;
 
     virtual bool operator==(const Texture2D& other) = 0;
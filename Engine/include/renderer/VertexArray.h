@@ -16,6 +16,9 @@ public:
     virtual void unbind() const = 0;
 
     virtual void addVertexBuffer(const Reference<VertexBuffer>& buffer) = 0;
+
+    // Attributes start at the beginning of the whole stream, draws pick a region's vertices with a base vertex
+    virtual void addVertexBuffer(const StreamBuffer& buffer, const BufferLayout& layout) = 0;
     virtual void setIndexBuffer(const Reference<IndexBuffer>& buffer) = 0;
 
     virtual Reference<IndexBuffer> getIndexBuffer() const = 0;
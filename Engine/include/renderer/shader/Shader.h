@@ -27,6 +27,14 @@ struct Uniform
     int location;
 };
 
+// A uniform resolved ahead of time, skipping the name lookup when setting it. Only valid for the shader it came from.
+struct UniformHandle
+{
+    int32_t location = -1;
+
+    inline bool isValid() const { return location != -1; }
+};
+
 class Shader
 {
 public:
@@ -39,6 +47,15 @@ public:
     virtual void bind() const = 0;
     virtual void unbind() const = 0;
 
+    virtual UniformHandle getUniformHandle(const std::string& name) = 0;
+
+    virtual void setInt(UniformHandle handle, int value) = 0;
+    virtual void setFloat(UniformHandle handle, float value) = 0;
+    virtual void setFloat3(UniformHandle handle, const math::vec3& value) = 0;
+    virtual void setFloat4(UniformHandle handle, const math::vec4& value) = 0;
+    virtual void setMatrix3(UniformHandle handle, const math::mat3& value) = 0;
+    virtual void setMatrix4(UniformHandle handle, const math::mat4& value) = 0;
+
     virtual void setInt(const std::string& name, int value) = 0;
     virtual void setInt2(const std::string& name, const math::ivec2& value) = 0;
     virtual void setInt3(const std::string& name, const math::ivec3& value) = 0;
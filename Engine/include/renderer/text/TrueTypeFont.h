@@ -2,44 +2,108 @@
 
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include <list>
 
 #include <maths/vector/vec2.h>
+#include <maths/vector/vec4.h>
 #include <core/Core.h>
 #include <renderer/Texture2D.h>
 
+struct FT_LibraryRec_;
+struct FT_FaceRec_;
+
 namespace Engine
 {
 
+// Metrics are in pixels at TrueTypeFont::GLYPH_SIZE, scaled by the renderer to the requested size
 struct Glyph
 {
     math::vec2 advance;
-    math::vec2 size;
-    math::vec2 pos;
+    math::vec2 size; // Includes the distance field's padding, zero for glyphs without an outline
+    math::vec2 pos; // Top left of the quad relative to the pen position
+
+    math::vec4 texRect; // Normalized x1, y1, x2, y2
+};
+
+struct FontStatistics
+{
+    uint32_t residentGlyphs = 0;
+    uint32_t capacity = 0;
+    size_t atlasMemory = 0; // Bytes
 
-    float texOffset;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t rasterized = 0;
+    uint32_t evicted = 0;
+    uint32_t dropped = 0; // Glyphs not drawn because every cell held a glyph used in the same frame
+    double rasterizeMillis = 0.0;
 };
 
+// Glyphs are rasterized on first use as signed distance fields into cells of a single atlas, which serves every
+// character size. When the atlas is full, the least recently used glyph gives up its cell.
 class TrueTypeFont
 {
 public:
+    static constexpr uint32_t GLYPH_SIZE = 40;
+    static constexpr uint32_t SPREAD = 6; // Pixels over which the distance field falls off, and padding around each glyph
+    static constexpr uint32_t CELL_SIZE = 64;
+    static constexpr uint32_t DEFAULT_ATLAS_SIZE = 1024;
+
     TrueTypeFont();
+    ~TrueTypeFont();
+
+    TrueTypeFont(const TrueTypeFont&) = delete;
+    TrueTypeFont& operator=(const TrueTypeFont&) = delete;
+
+    void load(const std::string& path, int characterSize, uint32_t atlasSize = DEFAULT_ATLAS_SIZE);
 
-    void load(const std::string& path, int characterSize);
+    static Reference<TrueTypeFont> create(const std::string& path, int characterSize, uint32_t atlasSize = DEFAULT_ATLAS_SIZE);
 
-    static Reference<TrueTypeFont> create(const std::string& path, int characterSize);
+    // Rasterizes the glyph if it isn't cached. Returns nullptr if it can't be given a cell this frame.
+    // The pointer is valid until the next call.
+    const Glyph* getGlyph(uint32_t codePoint);
+
+    // Glyphs used before this may be evicted again. Called by the renderer once per frame.
+    static inline void nextFrame() { s_frame++; }
 
-    inline const std::unordered_map<char, Glyph>& getGlyphs() const { return m_glyphs; }
-    inline const math::vec2& getAtlasSize() const { return m_atlasSize; }
     inline Reference<Texture2D> getTextureAtlas() const { return m_texture; }
     inline int getCharacterSize() const { return m_characterSize; }
+    inline const FontStatistics& getStatistics() const { return m_statistics; }
 
 private:
-    math::vec2 m_atlasSize;
+    static constexpr uint32_t NO_CELL = ~0u;
+
+    struct CachedGlyph
+    {
+        Glyph glyph;
+        uint32_t cell = NO_CELL;
+        uint64_t lastUsed = 0;
+        std::list<uint32_t>::iterator recent; // Position in m_recent, only valid with a cell
+    };
+
+    void release_();
+
+    // Fills in the glyph's metrics and writes its distance field to m_cellData, false if FreeType can't load it
+    bool rasterize_(uint32_t codePoint, Glyph& glyph);
+    uint32_t acquireCell_();
+
+    static inline uint64_t s_frame = 0;
+
+    FT_LibraryRec_* m_library = nullptr;
+    FT_FaceRec_* m_face = nullptr;
 
     Reference<Texture2D> m_texture;
+    uint32_t m_cellsPerRow = 0;
     int m_characterSize = 0;
 
-    std::unordered_map<char, Glyph> m_glyphs;
+    std::unordered_map<uint32_t, CachedGlyph> m_glyphs;
+    std::list<uint32_t> m_recent; // Code points of glyphs holding a cell, most recently used first
+    std::vector<uint32_t> m_freeCells;
+
+    std::vector<uint8_t> m_cellData;
+
+    FontStatistics m_statistics;
 };
 
 }
\ No newline at end of file
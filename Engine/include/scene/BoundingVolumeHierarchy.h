@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <renderer/Bounds.h>
+#include <renderer/Frustum.h>
+
+namespace Engine
+{
+
+class GameObject;
+
+// Dynamic AABB tree. Leaves store a slightly enlarged ("fat") box so small movements don't touch the tree;
+// larger ones remove and re-insert the leaf. The tree is kept balanced with rotations on the way back up.
+class BoundingVolumeHierarchy
+{
+public:
+    static constexpr uint32_t NULL_NODE = UINT32_MAX;
+    static constexpr float FAT_MARGIN = 0.1f;
+
+    BoundingVolumeHierarchy();
+
+    // Returns a proxy id for use with move()/remove()
+    uint32_t insert(const AABB& box, GameObject* object);
+    void remove(uint32_t proxy);
+
+    // Returns true if the tree had to be updated
+    bool move(uint32_t proxy, const AABB& box);
+
+    inline GameObject* getObject(uint32_t proxy) const { return m_nodes[proxy].object; }
+    inline const AABB& getBounds(uint32_t proxy) const { return m_nodes[proxy].tight; }
+
+    // Visits every leaf whose box passes 'overlaps'. Subtrees failing 'overlaps' are skipped entirely.
+    // overlaps(const AABB&) -> bool, callback(GameObject*, const AABB& tight)
+    template<typename Overlaps, typename F>
+    void query(Overlaps&& overlaps, F&& callback) const
+    {
+        if (m_root == NULL_NODE)
+        {
+            return;
+        }
+
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        stack.push_back(m_root);
+
+        while (!stack.empty())
+        {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if (!overlaps(node.box))
+            {
+                continue;
+            }
+
+            if (node.isLeaf())
+            {
+                if (overlaps(node.tight))
+                {
+                    callback(node.object, node.tight);
+                }
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    void queryFrustum(const Frustum& frustum, std::vector<GameObject*>& objects) const;
+    void queryBox(const AABB& box, std::vector<GameObject*>& objects) const;
+    void querySphere(const BoundingSphere& sphere, std::vector<GameObject*>& objects) const;
+
+    // Closest leaf box hit by the ray, or nullptr. 'distance' is set to the distance along the (normalized) direction.
+    GameObject* raycast(const math::vec3& origin, const math::vec3& direction, float maxDistance, float* distance = nullptr) const;
+
+    inline uint32_t getCount() const { return m_count; }
+    int32_t getHeight() const;
+
+private:
+    struct Node
+    {
+        AABB box;   // Fat for leaves, union of children otherwise
+        AABB tight; // Leaves only
+
+        GameObject* object = nullptr;
+
+        uint32_t parent = NULL_NODE; // Next free node while on the free list
+        uint32_t child1 = NULL_NODE;
+        uint32_t child2 = NULL_NODE;
+
+        int32_t height = -1; // Leaf = 0, free = -1
+
+        inline bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    uint32_t allocateNode_();
+    void freeNode_(uint32_t index);
+
+    void insertLeaf_(uint32_t leaf);
+    void removeLeaf_(uint32_t leaf);
+
+    uint32_t balance_(uint32_t index);
+
+    std::vector<Node> m_nodes;
+    uint32_t m_root = NULL_NODE;
+    uint32_t m_freeList = NULL_NODE;
+    uint32_t m_count = 0;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <atomic>
+
+#include <core/Core.h>
+#include <scene/GameObjectPool.h>
+
+namespace Engine
+{
+
+class GameComponent;
+class GameObject;
+
+template<typename... Ts>
+class SceneView;
+
+using ComponentId = uint32_t;
+
+// Hands out a small dense integer per component type so lookups are an array index rather than a hash of typeid.
+class ComponentType
+{
+public:
+    template<typename T>
+    static ComponentId id()
+    {
+        static const ComponentId id = s_counter.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+private:
+    static inline std::atomic<ComponentId> s_counter = 0;
+};
+
+class IComponentPool
+{
+public:
+    virtual ~IComponentPool() = default;
+
+    virtual void release(GameComponent* component) = 0;
+    virtual uint32_t getCount() const noexcept = 0;
+};
+
+// Stores every component of one type in fixed-size chunks. Components of a type sit next to each other in memory,
+// and because chunks never move, pointers handed out to game objects stay valid until the component is released.
+template<typename T>
+class ComponentPool : public IComponentPool
+{
+public:
+    static constexpr uint32_t CHUNK_SIZE = 256;
+
+    ComponentPool() = default;
+    ComponentPool(const ComponentPool&) = delete;
+
+    ~ComponentPool()
+    {
+        for (uint32_t i = 0; i < m_highWater; i++)
+        {
+            if (m_chunks[i / CHUNK_SIZE]->alive[i % CHUNK_SIZE])
+            {
+                at(i)->~T();
+            }
+        }
+
+        for (auto chunk : m_chunks)
+        {
+            delete chunk;
+        }
+    }
+
+    template<typename... Args>
+    T* allocate(Args&&... args)
+    {
+        uint32_t index;
+
+        if (!m_freeList.empty())
+        {
+            index = m_freeList.back();
+            m_freeList.pop_back();
+        }
+        else
+        {
+            if (m_highWater == m_chunks.size() * CHUNK_SIZE)
+            {
+                m_chunks.push_back(new Chunk());
+            }
+
+            index = m_highWater++;
+        }
+
+        T* component = new (at(index)) T(std::forward<Args>(args)...);
+        m_chunks[index / CHUNK_SIZE]->slots[index % CHUNK_SIZE].index = index;
+        m_chunks[index / CHUNK_SIZE]->alive[index % CHUNK_SIZE] = true;
+        m_count++;
+
+        return component;
+    }
+
+    void release(GameComponent* component) override
+    {
+        T* ptr = static_cast<T*>(component);
+
+        // The component is the start of its slot
+        uint32_t index = reinterpret_cast<Slot*>(ptr)->index;
+        Chunk* chunk = m_chunks[index / CHUNK_SIZE];
+
+        if (!chunk->alive[index % CHUNK_SIZE])
+        {
+            return;
+        }
+
+        ptr->~T();
+        chunk->alive[index % CHUNK_SIZE] = false;
+        m_freeList.push_back(index);
+        m_count--;
+    }
+
+    // Visits live components in memory order
+    template<typename F>
+    void each(F&& func)
+    {
+        for (uint32_t i = 0; i < m_highWater; i++)
+        {
+            if (m_chunks[i / CHUNK_SIZE]->alive[i % CHUNK_SIZE])
+            {
+                func(*at(i));
+            }
+        }
+    }
+
+    inline uint32_t getCount() const noexcept override { return m_count; }
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char data[sizeof(T)];
+        uint32_t index; // Of the slot in the pool, so release() needn't search the chunks for it
+    };
+
+    struct Chunk
+    {
+        Slot slots[CHUNK_SIZE];
+        bool alive[CHUNK_SIZE] = {};
+    };
+
+    inline T* at(uint32_t index)
+    {
+        return reinterpret_cast<T*>(m_chunks[index / CHUNK_SIZE]->slots[index % CHUNK_SIZE].data);
+    }
+
+    std::vector<Chunk*> m_chunks;
+    std::vector<uint32_t> m_freeList;
+
+    uint32_t m_highWater = 0;
+    uint32_t m_count = 0;
+};
+
+// Notified whenever a component is added to or removed from a game object in the hierarchy
+class ISceneView
+{
+public:
+    virtual ~ISceneView() = default;
+
+    virtual bool dependsOn(ComponentId id) const = 0;
+    virtual void onComponentsChanged(GameObject* object) = 0;
+
+    // Only sent to listeners (see ComponentStorage::addListener())
+    virtual void onTransformChanged(GameObject* /*object*/) {}
+};
+
+// One pool per component type, plus the pool the game objects themselves live in.
+// Shared by every game object in a hierarchy (i.e. one per scene).
+class ComponentStorage
+{
+public:
+    template<typename T>
+    ComponentPool<T>& getPool()
+    {
+        ComponentId id = ComponentType::id<T>();
+
+        if (id >= m_pools.size())
+        {
+            m_pools.resize(id + 1);
+        }
+
+        if (!m_pools[id])
+        {
+            m_pools[id] = createOwned<ComponentPool<T>>();
+        }
+
+        return *static_cast<ComponentPool<T>*>(m_pools[id].get());
+    }
+
+    template<typename T>
+    bool hasPool() const
+    {
+        ComponentId id = ComponentType::id<T>();
+        return id < m_pools.size() && m_pools[id];
+    }
+
+    template<typename T, typename F>
+    void each(F&& func)
+    {
+        if (hasPool<T>())
+        {
+            getPool<T>().each(std::forward<F>(func));
+        }
+    }
+
+    // Persistent list of the game objects holding all of Ts. Built on first use, then kept up to date. (see SceneView.h)
+    template<typename... Ts>
+    SceneView<Ts...>& view();
+
+    inline GameObjectPool& getObjects() { return m_objects; }
+
+    // Components added with GameObject::addExistingComponent() live on the heap, outside any pool
+    inline uint32_t getHeapComponentCount(ComponentId id) const
+    {
+        return id < m_heapComponents.size() ? m_heapComponents[id] : 0;
+    }
+
+    // Listeners are not owned by the storage and must be removed before they are destroyed
+    void addListener(ISceneView* listener)
+    {
+        m_listeners.push_back(listener);
+    }
+
+    void removeListener(ISceneView* listener)
+    {
+        auto it = std::find(m_listeners.begin(), m_listeners.end(), listener);
+        if (it != m_listeners.end())
+            m_listeners.erase(it);
+    }
+
+    void onComponentsChanged(GameObject* object, ComponentId id)
+    {
+        for (auto& view : m_views)
+        {
+            if (view && view->dependsOn(id))
+            {
+                view->onComponentsChanged(object);
+            }
+        }
+
+        for (auto listener : m_listeners)
+        {
+            if (listener->dependsOn(id))
+            {
+                listener->onComponentsChanged(object);
+            }
+        }
+    }
+
+    void onTransformChanged(GameObject* object)
+    {
+        for (auto listener : m_listeners)
+        {
+            listener->onTransformChanged(object);
+        }
+    }
+
+private:
+    std::vector<Owned<IComponentPool>> m_pools;
+    std::vector<Owned<ISceneView>> m_views;
+    std::vector<ISceneView*> m_listeners;
+
+    GameObjectPool m_objects;
+
+    // Indexed by ComponentId, updated by GameObject
+    std::vector<uint32_t> m_heapComponents;
+
+    void onHeapComponentAdded_(ComponentId id)
+    {
+        if (id >= m_heapComponents.size())
+        {
+            m_heapComponents.resize(id + 1);
+        }
+
+        m_heapComponents[id]++;
+    }
+
+    void onHeapComponentRemoved_(ComponentId id)
+    {
+        m_heapComponents[id]--;
+    }
+
+    friend class GameObject;
+
+    template<typename V>
+    static uint32_t viewId()
+    {
+        static const uint32_t id = s_viewCounter.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    static inline std::atomic<uint32_t> s_viewCounter = 0;
+};
+
+}
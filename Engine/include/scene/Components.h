@@ -33,6 +33,8 @@ struct SpriteRendererComponent : public GameComponent
 
     bool usingTexRect = false;
     math::frect textureRect;
+
+    int32_t layer = 0; // Higher layers are drawn on top
 };
 /*
 struct TextRendererComponent : public GameComponent
@@ -51,6 +53,7 @@ struct MeshRendererComponent : public GameComponent
 {
     Reference<Material> material;
     bool castShadows = true;
+    bool isStatic = false; // Never moves, so its shadows can be cached
 };
 /*
 struct RigidBody2DComponent : public GameComponent
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <core/Core.h>
+#include <scene/GameObjectPool.h>
 
 namespace Engine
 {
@@ -18,14 +19,19 @@ public:
     virtual void onGameObjectSet(GameObject* object) {}
     virtual void onTransformChange(const Transform& transform) {}
 
-    void setOwner(GameObject* owner)
+    void setOwner(GameObjectHandle owner, GameObjectPool* objects)
     {
         m_owner = owner;
+        m_objects = objects;
         //onGameObjectSet(owner);
     }
 
-protected:
-    GameObject* m_owner = nullptr;
+    // nullptr if the component has no owner or it was destroyed
+    inline GameObject* getOwner() const { return m_objects ? m_objects->get(m_owner) : nullptr; }
+
+private:
+    GameObjectHandle m_owner;
+    GameObjectPool* m_objects = nullptr; // The owner's hierarchy
 };
 
 }
\ No newline at end of file
@@ -1,12 +1,12 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
-#include <typeindex>
-#include <typeinfo>
+#include <type_traits>
 
 #include <scene/GameComponent.h>
+#include <scene/ComponentPool.h>
+#include <scene/GameObjectPool.h>
 #include <core/Logger.h>
 
 namespace Engine
@@ -28,12 +28,24 @@ public:
 
     GameObject* getParent() const;
 
+    // Safe to keep around after the object is destroyed, resolve with Scene::getGameObject()
+    inline GameObjectHandle getHandle() const { return m_handle; }
+
+    // Notifies this object's components that its world transform changed
     void onTransformChange(const Transform& transform);
 
+    // Rebuilds dirty world matrices top-down and notifies components. Clean subtrees are skipped entirely.
+    void updateTransforms();
+
+    // Only rebuilds the matrices, adding every object whose world transform changed to 'changed' rather than notifying
+    // anyone. Safe on a worker as long as nothing else touches the hierarchy's transforms meanwhile.
+    void updateTransforms(std::vector<GameObject*>& changed);
+
+    // Moves the last child into the removed one's place, so children don't keep their order
     void removeChild(GameObject* child);
     GameObject* createChild();
 
-    std::vector<GameObject*> getChildren();
+    inline const std::vector<GameObject*>& getChildren() const { return m_children; }
     std::vector<GameObject*> getChildrenRecursive();
 
     template<typename T>
@@ -73,21 +85,22 @@ public:
     {
         if (!hasComponent<T>())
         {
-            T* component = new T(std::forward<Args>(args)...);
-            this->addExistingComponent<T>(component);
+            auto& pool = m_storage->getPool<T>();
+            T* component = pool.allocate(std::forward<Args>(args)...);
+            setComponent_(ComponentType::id<T>(), component, &pool);
             return component;
         }
 
         return getComponent<T>();
     }
 
+    // Takes ownership of a heap allocated component (it will be deleted, not returned to a pool)
     template<typename T>
     void addExistingComponent(GameComponent* component)
     {
         if (std::is_base_of<GameComponent, T>() && !hasComponent<T>())
         {
-            component->setOwner(this);
-            m_components.emplace(static_cast<std::type_index>(typeid(T)), component);
+            setComponent_(ComponentType::id<T>(), component, nullptr);
         }
     }
 
@@ -129,18 +142,9 @@ public:
     template<typename T>
     void removeComponent()
     {
-        if (std::is_base_of<GameComponent, T>())
+        if (std::is_base_of<GameComponent, T>() && hasComponent<T>())
         {
-            for (auto& component : m_components)
-            {
-                if (component.first == static_cast<std::type_index>(typeid(T)))
-                {
-                    delete component.second;
-                    m_components.erase(component.first);
-                    
-                    break;
-                }
-            }
+            releaseComponent_(ComponentType::id<T>());
         }
     }
 
@@ -149,8 +153,8 @@ public:
     {
         if (std::is_base_of<GameComponent, T>())
         {
-            //reinterpret_cast<T*>(m_components.at(typeid(T)))->setOwner(this); // TODO: why is this necessary?
-            return static_cast<T*>(m_components.at(typeid(T)));
+            ComponentId id = ComponentType::id<T>();
+            return id < m_components.size() ? static_cast<T*>(m_components[id].component) : nullptr;
         }
 
         Logger::getCoreLogger()->critical("Component is not derived from class GameComponent!");
@@ -160,7 +164,8 @@ public:
     template<typename T>
     bool hasComponent()
     {
-        return m_components.find(static_cast<std::type_index>(typeid(T))) != m_components.end();
+        ComponentId id = ComponentType::id<T>();
+        return id < m_components.size() && m_components[id].component != nullptr;
     }
 
     template<typename... Components>
@@ -171,11 +176,31 @@ public:
         return check;
     }
 
+    // Component pools shared with the rest of this hierarchy
+    inline ComponentStorage& getStorage() { return *m_storage; }
+
 private:
-    std::unordered_map<std::type_index, GameComponent*> m_components;
+    struct ComponentSlot
+    {
+        GameComponent* component = nullptr;
+        IComponentPool* pool = nullptr; // nullptr if the component was added with addExistingComponent()
+    };
+
+    // Indexed by ComponentType::id<T>()
+    std::vector<ComponentSlot> m_components;
     std::vector<GameObject*> m_children;
     GameObject* m_parent = nullptr;
 
+    // Where this object is in its parent's m_children, so removing it doesn't have to search
+    uint32_t m_childIndex = 0;
+
+    GameObjectHandle m_handle;
+
+    Reference<ComponentStorage> m_storage;
+
+    // Set if this object or one of its descendants has a dirty transform
+    bool m_transformsDirty = true;
+
     //std::vector<GameComponent*> m_listeners;
 
     template<typename T>
@@ -184,6 +209,19 @@ private:
         check = check ? object->hasComponent<T>() : false;
     }
 
+    void setComponent_(ComponentId id, GameComponent* component, IComponentPool* pool);
+    void releaseComponent_(ComponentId id);
+
+    void collectChildren_(std::vector<GameObject*>& children) const;
+
+    void updateTransforms_(std::vector<GameObject*>* changed);
+
+    void markTransformsDirty_();
+    void invalidateChildTransforms_();
+
+    friend class Transform;
+    friend class GameObjectPool;
+
     void destroy_();
 };
 
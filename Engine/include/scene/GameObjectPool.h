@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine
+{
+
+class GameObject;
+
+// Weak reference to a pooled game object. Stays safe to hold after the object is destroyed:
+// the slot's generation is bumped on destruction so stale handles resolve to nullptr.
+struct GameObjectHandle
+{
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    static constexpr uint32_t ROOT_INDEX = UINT32_MAX - 1; // The hierarchy's root, which isn't pooled
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    inline bool isValid() const noexcept { return index != INVALID_INDEX; }
+
+    bool operator==(const GameObjectHandle& other) const noexcept { return index == other.index && generation == other.generation; }
+    bool operator!=(const GameObjectHandle& other) const noexcept { return !(*this == other); }
+};
+
+// Owns every non-root game object of a hierarchy, and resolves handles to the root as well. Objects live in fixed-size chunks so their addresses never change,
+// and freed slots are recycled through a free list, making create/destroy O(1) with no heap traffic once warmed up.
+class GameObjectPool
+{
+public:
+    static constexpr uint32_t CHUNK_SIZE = 128;
+
+    GameObjectPool() = default;
+    GameObjectPool(const GameObjectPool&) = delete;
+    ~GameObjectPool();
+
+    GameObject* create(GameObject* parent);
+    void destroy(GameObject* object);
+
+    // Returns nullptr if the handle is invalid or the object it referred to was destroyed
+    GameObject* get(GameObjectHandle handle) const;
+
+    // The root lives outside the pool, set by its constructor
+    inline void setRoot(GameObject* root) { m_root = root; }
+
+    inline uint32_t getCount() const noexcept { return m_count; }
+
+    // Visits the root, then every live object in slot order
+    template<typename F>
+    void each(F&& func) const
+    {
+        if (m_root)
+        {
+            func(m_root);
+        }
+
+        for (uint32_t i = 0; i < m_generations.size(); i++)
+        {
+            if (GameObject* object = getAlive_(i))
+            {
+                func(object);
+            }
+        }
+    }
+
+private:
+    struct Chunk;
+
+    GameObject* at(uint32_t index) const;
+
+    // nullptr if the slot is free
+    GameObject* getAlive_(uint32_t index) const;
+
+    std::vector<Chunk*> m_chunks;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeList;
+
+    GameObject* m_root = nullptr;
+    uint32_t m_count = 0;
+};
+
+}
\ No newline at end of file
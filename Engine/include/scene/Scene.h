@@ -4,6 +4,9 @@
 
 #include <core/Core.h>
 #include <scene/GameObject.h>
+#include <scene/SceneView.h>
+#include <scene/SystemScheduler.h>
+#include <scene/SceneSpatialIndex.h>
 #include <maths/math.h>
 
 namespace Engine
@@ -30,11 +33,30 @@ public:
 
     GameObject* createGameObject(const std::string& name);
 
+    // nullptr if the object has been destroyed
+    GameObject* getGameObject(GameObjectHandle handle)
+    {
+        return m_rootObject.getStorage().getObjects().get(handle);
+    }
+
     GameObject& getRootGameObject()
     {
         return m_rootObject;
     }
 
+    // Every game object in the scene with all of the components Ts. Cached and updated as components change.
+    template<typename... Ts>
+    SceneView<Ts...>& view()
+    {
+        return m_rootObject.getStorage().view<Ts...>();
+    }
+
+    // Bounding volume hierarchy over every object with a MeshComponent, for culling, picking and overlap queries
+    const SceneSpatialIndex& getSpatialIndex() const { return m_spatialIndex; }
+
+    // Systems run each frame by onUpdateRuntime()
+    SystemScheduler& getSystems() { return m_systems; }
+
     // Returns singleton components/objects
     // TODO: SingletonComponent inherit GameComponent. Scene::getPrimarySingletonComponent<T>()
     GameObject* getPrimaryCameraGameObject();
@@ -57,6 +79,9 @@ public:
 private:
     GameObject m_rootObject;
 
+    SystemScheduler m_systems;
+    SceneSpatialIndex m_spatialIndex;
+
     uint32_t m_viewportWidth = 0, m_viewportHeight = 0;
 
     std::string m_path = "";
@@ -64,7 +89,6 @@ private:
     void render2DEntities();
     void render3DEntities();
 
-    void recurseRender3D(GameObject* object);
     void recurseRender2D(GameObject* object);
 
     void setLights();
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include <scene/ComponentPool.h>
+#include <scene/BoundingVolumeHierarchy.h>
+
+namespace Engine
+{
+
+class Mesh;
+
+// Keeps every game object with a MeshComponent and a Transform in a BoundingVolumeHierarchy, using the mesh's
+// world space bounds. Registered as a ComponentStorage listener, so it follows component and transform changes.
+// Objects whose mesh has no bounds (or no mesh yet) are kept on a separate list and reported by every query.
+class SceneSpatialIndex : public ISceneView
+{
+public:
+    bool dependsOn(ComponentId id) const override;
+    void onComponentsChanged(GameObject* object) override;
+    void onTransformChanged(GameObject* object) override;
+
+    // Picks up meshes assigned or replaced since the object was added, refitting its bounds. Called once per frame by the scene.
+    void update();
+
+    // Visits objects whose bounds pass 'overlaps', plus every unbounded object
+    template<typename Overlaps, typename F>
+    void query(Overlaps&& overlaps, F&& callback) const
+    {
+        m_tree.query(overlaps, [&callback](GameObject* object, const AABB&) { callback(object); });
+
+        for (auto object : m_unbounded)
+        {
+            callback(object);
+        }
+    }
+
+    void queryFrustum(const Frustum& frustum, std::vector<GameObject*>& objects) const;
+    void queryBox(const AABB& box, std::vector<GameObject*>& objects) const;
+    void querySphere(const BoundingSphere& sphere, std::vector<GameObject*>& objects) const;
+
+    // Closest bounded object along the ray. Unbounded objects can't be hit.
+    GameObject* raycast(const math::vec3& origin, const math::vec3& direction, float maxDistance = FLT_MAX, float* distance = nullptr) const;
+
+    inline const BoundingVolumeHierarchy& getTree() const { return m_tree; }
+
+private:
+    // An object in the tree, with the mesh its bounds were taken from
+    struct Proxy
+    {
+        uint32_t node;
+        const Mesh* mesh;
+        AABB meshBounds;
+    };
+
+    bool getWorldBounds_(GameObject* object, AABB& bounds) const;
+
+    void insert_(GameObject* object, const AABB& bounds);
+    void track_(GameObject* object);
+    void untrack_(GameObject* object);
+
+    BoundingVolumeHierarchy m_tree;
+
+    std::unordered_map<GameObject*, Proxy> m_proxies;
+    std::vector<GameObject*> m_unbounded;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <tuple>
+
+#include <scene/GameObject.h>
+
+namespace Engine
+{
+
+// A cached query over every game object in a scene that has all of the components Ts.
+// It is filled once when first requested and afterwards only touched when one of Ts is added or removed,
+// so iterating it each frame performs no allocation or hierarchy traversal.
+// NOTE: adding/removing one of Ts while iterating reorders the view; iterate by index in that case.
+template<typename... Ts>
+class SceneView : public ISceneView
+{
+public:
+    SceneView(ComponentStorage& storage)
+    {
+        using First = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+        // Every object holding all of Ts holds a First, so its pool is enough to look through, unless some First
+        // was added with addExistingComponent() and only a walk over every object finds it
+        if (storage.getHeapComponentCount(ComponentType::id<First>()) > 0)
+        {
+            storage.getObjects().each([this](GameObject* object)
+            {
+                onComponentsChanged(object);
+            });
+
+            return;
+        }
+
+        storage.getPool<First>().each([this](First& component)
+        {
+            onComponentsChanged(component.getOwner());
+        });
+    }
+
+    bool dependsOn(ComponentId id) const override
+    {
+        return ((ComponentType::id<Ts>() == id) || ...);
+    }
+
+    void onComponentsChanged(GameObject* object) override
+    {
+        bool matches = object->hasComponents<Ts...>();
+        auto it = m_indices.find(object);
+
+        if (matches && it == m_indices.end())
+        {
+            m_indices.emplace(object, static_cast<uint32_t>(m_objects.size()));
+            m_objects.push_back(object);
+        }
+        else if (!matches && it != m_indices.end())
+        {
+            uint32_t index = it->second;
+            m_indices.erase(it);
+
+            // Swap with the last element to keep the array packed
+            if (index != m_objects.size() - 1)
+            {
+                m_objects[index] = m_objects.back();
+                m_indices[m_objects[index]] = index;
+            }
+
+            m_objects.pop_back();
+        }
+    }
+
+    inline typename std::vector<GameObject*>::const_iterator begin() const { return m_objects.begin(); }
+    inline typename std::vector<GameObject*>::const_iterator end()   const { return m_objects.end(); }
+
+    inline GameObject* operator[](uint32_t index) const { return m_objects[index]; }
+
+    inline uint32_t size() const noexcept { return m_objects.size(); }
+    inline bool empty() const noexcept { return m_objects.empty(); }
+
+private:
+    std::vector<GameObject*> m_objects;
+    std::unordered_map<GameObject*, uint32_t> m_indices;
+};
+
+template<typename... Ts>
+SceneView<Ts...>& ComponentStorage::view()
+{
+    uint32_t id = viewId<SceneView<Ts...>>();
+
+    if (id >= m_views.size())
+    {
+        m_views.resize(id + 1);
+    }
+
+    if (!m_views[id])
+    {
+        m_views[id] = createOwned<SceneView<Ts...>>(*this);
+    }
+
+    return *static_cast<SceneView<Ts...>*>(m_views[id].get());
+}
+
+}
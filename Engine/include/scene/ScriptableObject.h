@@ -8,6 +8,7 @@ namespace Engine
 class ScriptableObject
 {
     friend class Scene;
+    friend class NativeScriptSystem;
 
 public:
     virtual ~ScriptableObject() = default;
@@ -15,16 +16,21 @@ public:
     template<typename T>
     T* getComponent()
     {
-        return m_gameObject->getComponent<T>();
+        GameObject* object = getGameObject();
+        return object ? object->getComponent<T>() : nullptr;
     }
 
+    // nullptr once the script's game object is destroyed
+    inline GameObject* getGameObject() const { return m_objects ? m_objects->get(m_gameObject) : nullptr; }
+
 protected:
     virtual void onStart() {}
     virtual void onDestroy() {}
     virtual void onUpdate(float dt) {}
 
 private:
-    GameObject* m_gameObject;
+    GameObjectHandle m_gameObject;
+    GameObjectPool* m_objects = nullptr;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <scene/ComponentPool.h>
+
+namespace Engine
+{
+
+class Scene;
+
+// A unit of per-frame scene work. Systems declare the component types they read and write so the
+// SystemScheduler can run the ones that don't conflict at the same time.
+// NOTE: a system that may run off the main thread must not create new scene views or add/remove components. It
+// creates its views in onAttach() and leaves main thread work (OpenAL, the renderer, listeners) to onSync().
+class System
+{
+public:
+    System(const std::string& name)
+        : m_name(name) {}
+
+    virtual ~System() = default;
+
+    virtual void onUpdate(Scene& scene, float dt) = 0;
+
+    // Called on the main thread when the system is added to its scene
+    virtual void onAttach(Scene& scene) {}
+
+    // Called on the main thread once every system of the stage has finished, to apply what onUpdate() collected
+    virtual void onSync(Scene& scene) {}
+
+    inline const std::string& getName() const { return m_name; }
+
+    // Must run on the main thread (GL, scripting runtimes, ...)
+    inline bool isMainThreadOnly() const { return m_mainThreadOnly; }
+
+    // Touches anything in the scene; runs on its own
+    inline bool isExclusive() const { return m_exclusive; }
+
+    bool conflictsWith(const System& other) const
+    {
+        if (m_exclusive || other.m_exclusive)
+        {
+            return true;
+        }
+
+        return intersects_(m_writes, other.m_writes) || intersects_(m_writes, other.m_reads) || intersects_(m_reads, other.m_writes);
+    }
+
+protected:
+    template<typename... Ts>
+    void reads()
+    {
+        (m_reads.push_back(ComponentType::id<Ts>()), ...);
+    }
+
+    template<typename... Ts>
+    void writes()
+    {
+        (m_writes.push_back(ComponentType::id<Ts>()), ...);
+    }
+
+    void setMainThreadOnly(bool mainThreadOnly) { m_mainThreadOnly = mainThreadOnly; }
+    void setExclusive(bool exclusive) { m_exclusive = exclusive; }
+
+private:
+    static bool intersects_(const std::vector<ComponentId>& a, const std::vector<ComponentId>& b)
+    {
+        for (auto id : a)
+        {
+            if (std::find(b.begin(), b.end(), id) != b.end())
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::string m_name;
+
+    std::vector<ComponentId> m_reads;
+    std::vector<ComponentId> m_writes;
+
+    bool m_mainThreadOnly = false;
+    bool m_exclusive = false;
+};
+
+}
\ No newline at end of file
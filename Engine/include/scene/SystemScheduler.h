@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <core/Core.h>
+#include <scene/System.h>
+
+namespace Engine
+{
+
+struct SystemTiming
+{
+    const System* system;
+    uint32_t stage;
+    double millis; // In onUpdate()
+    double syncMillis; // In onSync()
+};
+
+// Runs a scene's systems each frame. Systems are grouped into stages: a system goes in the stage after the last
+// earlier-added system it conflicts with, so registration order is kept wherever it matters.
+// Systems within a stage run concurrently on the JobSystem, then each one's onSync() runs on the main thread.
+class SystemScheduler
+{
+public:
+    explicit SystemScheduler(Scene& scene)
+        : m_scene(scene) {}
+
+    template<typename T, typename... Args>
+    T* addSystem(Args&&... args)
+    {
+        auto system = new T(std::forward<Args>(args)...);
+        m_systems.emplace_back(system);
+        m_dirty = true;
+
+        system->onAttach(m_scene);
+
+        return system;
+    }
+
+    void removeSystem(System* system);
+
+    void run(Scene& scene, float dt);
+
+    // Timings from the last run(), in registration order
+    inline const std::vector<SystemTiming>& getTimings() const { return m_timings; }
+
+    inline uint32_t getStageCount() const { return static_cast<uint32_t>(m_stages.size()); }
+
+private:
+    void buildStages_();
+
+    Scene& m_scene;
+
+    std::vector<Owned<System>> m_systems;
+
+    // Indices into m_systems
+    std::vector<std::vector<uint32_t>> m_stages;
+    std::vector<SystemTiming> m_timings;
+
+    bool m_dirty = true;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <scene/System.h>
+
+namespace Engine
+{
+
+class Transform;
+class BaseLight;
+class SkyLight;
+class DirectionalLight;
+class PointLight;
+
+// Built-in systems registered by every Scene. Added in this order, which the scheduler preserves where they conflict.
+
+class NativeScriptSystem : public System
+{
+public:
+    NativeScriptSystem();
+
+    void onUpdate(Scene& scene, float dt) override;
+};
+
+class ScriptSystem : public System
+{
+public:
+    ScriptSystem();
+
+    void onUpdate(Scene& scene, float dt) override;
+};
+
+// Rebuilds dirty world matrices on any thread and records which objects moved. The components listening for
+// transform changes (audio sources and listeners) and the scene's spatial index are told in onSync().
+class TransformSystem : public System
+{
+public:
+    TransformSystem();
+
+    void onUpdate(Scene& scene, float dt) override;
+    void onSync(Scene& scene) override;
+
+private:
+    std::vector<GameObject*> m_changed;
+};
+
+// Collects the scene's lights for Renderer3D. Only the light pointers are gathered, so it doesn't wait on transforms.
+// Renderer3D's light list is filled in onSync().
+class LightSystem : public System
+{
+public:
+    LightSystem();
+
+    void onAttach(Scene& scene) override;
+    void onUpdate(Scene& scene, float dt) override;
+    void onSync(Scene& scene) override;
+
+private:
+    SceneView<SkyLight>* m_skyLights = nullptr;
+    SceneView<DirectionalLight, Transform>* m_directionalLights = nullptr;
+    SceneView<PointLight, Transform>* m_pointLights = nullptr;
+
+    std::vector<const BaseLight*> m_lights;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Engine
+{
+
+// Block compressed texture formats GPUs sample directly. Texels are encoded in 4x4 blocks of 8 (BC1) or 16 bytes:
+//   BC1 - RGB, 4 bits per texel
+//   BC3 - RGBA, BC1 colors plus a separately interpolated alpha, 8 bits per texel
+//   BC5 - two channels interpolated separately (red and green, e.g. normal map XY), 8 bits per texel
+//   BC7 - RGBA, 8 bits per texel, the best quality of the four
+class BlockCompression
+{
+public:
+    enum class Format
+    {
+        BC1, BC3, BC5, BC7
+    };
+
+    // Bytes per 4x4 block
+    static uint32_t getBlockSize(Format format);
+
+    // Bytes of a width x height image, edge blocks included
+    static size_t getSize(Format format, uint32_t width, uint32_t height);
+
+    // Encodes tightly packed RGBA8 pixels. Edge blocks repeat the image's last row and column.
+    // BC7 blocks all use mode 6, one RGBA line. Opaque blocks keep their alpha at exactly 255, which limits their color
+    // channels to odd values.
+    static void encode(Format format, const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* blocks);
+
+    // Decodes to tightly packed RGBA8 pixels, BC5 to red and green with blue 0 and alpha 255.
+    // Only mode 6 of BC7 is decoded, the one encode() writes. False if a block uses any other mode.
+    static bool decode(Format format, const uint8_t* blocks, uint32_t width, uint32_t height, uint8_t* pixels);
+
+    // Mirrors the image vertically in place. Exact when the height is a multiple of four, otherwise the rows of the
+    // edge blocks' padding move to the top. BC7 blocks can't be flipped without encoding them again, so false for BC7.
+    static bool flipVertically(Format format, uint8_t* blocks, uint32_t width, uint32_t height);
+};
+
+}
\ No newline at end of file
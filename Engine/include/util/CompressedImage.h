@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <core/Core.h>
+#include <util/BlockCompression.h>
+
+namespace Engine
+{
+
+// A block compressed image with its mip chain, as stored in .ktx2 and .dds files. The data is uploaded to the GPU as
+// it is, so nothing is decoded or generated at load time.
+class CompressedImage
+{
+public:
+    using Format = BlockCompression::Format;
+
+    struct Level
+    {
+        uint32_t width;
+        uint32_t height;
+        size_t offset; // Into the image's data
+        size_t size;
+    };
+
+    // Whether the file is loaded by CompressedImage rather than Image, going by its extension
+    static bool isCompressedFile(const std::string& path);
+
+    // Loads a .ktx2 or .dds file. KTX2 files must not be supercompressed, neither may be cube maps or arrays.
+    // If flipped, the levels are stored bottom row first, as the textures created from an Image with flipped set.
+    // Safe to call from any thread. getData() returns nullptr if loading failed.
+    static Reference<CompressedImage> create(const std::string& path, bool flipped = false);
+
+    // An empty image to add levels to, largest first
+    static Reference<CompressedImage> create(Format format, uint32_t width, uint32_t height, bool isSRGB, bool flipped);
+
+    // Adds the next smaller level, BlockCompression::getSize() bytes of blocks
+    void addLevel(const uint8_t* blocks);
+
+    // Writes a KTX2 file, recording the row order of the levels in its orientation
+    bool saveKTX2(const std::string& path) const;
+
+    inline Format getFormat() const { return m_format; }
+    inline bool isSRGB() const { return m_isSRGB; }
+    inline bool isFlipped() const { return m_flipped; }
+
+    inline uint32_t getWidth() const { return m_width; }
+    inline uint32_t getHeight() const { return m_height; }
+
+    inline uint32_t getLevelCount() const { return static_cast<uint32_t>(m_levels.size()); }
+    inline const Level& getLevel(uint32_t level) const { return m_levels[level]; }
+    inline const uint8_t* getLevelData(uint32_t level) const { return m_data.data() + m_levels[level].offset; }
+
+    inline const void* getData() const { return m_levels.empty() ? nullptr : m_data.data(); }
+    inline size_t getSize() const { return m_data.size(); }
+    inline const std::string& getPath() const { return m_path; }
+
+private:
+    CompressedImage() = default;
+
+    bool parseKTX2_(const std::vector<uint8_t>& file);
+    bool parseDDS_(const std::vector<uint8_t>& file);
+
+    // Copies 'count' levels stored one after another from 'offset' of the file, largest first
+    bool readLevels_(const std::vector<uint8_t>& file, size_t offset, uint32_t count);
+
+    Format m_format = Format::BC1;
+    bool m_isSRGB = false;
+    bool m_flipped = false;
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+
+    std::vector<Level> m_levels;
+    std::vector<uint8_t> m_data;
+
+    std::string m_path;
+};
+
+}
\ No newline at end of file
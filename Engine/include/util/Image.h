@@ -18,6 +18,7 @@ public:
     ~Image();
 
 public:
+    // Safe to call from any thread
     static Reference<Image> create(const std::string& path, bool flipped = false);
 
     inline unsigned int getWidth() const { return m_width; }
@@ -25,6 +26,7 @@ public:
     inline Image::Format getFormat() const { return m_format; }
     inline void* getData() const { return m_data; }
     inline int getChannels() const { return m_channels; }
+    inline const std::string& getPath() const { return m_path; }
 
 private:
     Image();
@@ -35,6 +37,7 @@ private:
     Format m_format;
     void* m_data;
     int m_channels = 0;
+    std::string m_path;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine
+{
+
+// Stable LSD radix sort of 64 bit keys, 8 bits per pass. 'order' receives the indices of the keys in sorted order,
+// 'scratch' is working storage so callers can keep both between frames. Passes where every key has the same byte are skipped.
+void radixSort(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch);
+
+}
\ No newline at end of file
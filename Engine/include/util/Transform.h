@@ -11,15 +11,14 @@
 namespace Engine
 {
 
+// Local and world matrices are cached. Setters only flag the transform (and its descendants) as dirty;
+// matrices are rebuilt on the next read, or by GameObject::updateTransforms() once per frame.
 class Transform : public GameComponent
 {
 public:
     Transform();
     Transform(const math::vec3& translation, const math::vec3& rotation, const math::vec3& scale);
 
-    // Parent transform
-    void onTransformChange(const Transform& transform) override;
-
     void setTranslation(const math::vec3& translation);
     void setTranslation(float x, float y, float z);
 
@@ -44,21 +43,36 @@ public:
     const math::vec3& getRotation() const { return m_rotation; }
     const math::vec3& getScale() const { return m_scale; }
 
-    const math::vec3& getWorldTranslation() const { return m_worldTranslation; }
-    const math::vec3& getWorldRotation() const { return m_worldRotation; }
-    const math::vec3& getWorldScale() const { return m_worldScale; }
+    const math::vec3& getWorldTranslation() const { updateWorld_(); return m_worldTranslation; }
+    const math::vec3& getWorldRotation() const { updateWorld_(); return m_worldRotation; }
+    const math::vec3& getWorldScale() const { updateWorld_(); return m_worldScale; }
 
-    math::mat4 matrix() const;
-    math::mat4 worldMatrix() const;
+    const math::mat4& matrix() const;
+    const math::mat4& worldMatrix() const;
 
 private:
     math::vec3 m_translation;
     math::vec3 m_rotation;
     math::vec3 m_scale = math::vec3(1.f);
 
-    math::vec3 m_worldTranslation;
-    math::vec3 m_worldRotation;
-    math::vec3 m_worldScale;
+    mutable math::vec3 m_worldTranslation;
+    mutable math::vec3 m_worldRotation;
+    mutable math::vec3 m_worldScale;
+
+    mutable math::mat4 m_localMatrix;
+    mutable math::mat4 m_worldMatrix;
+
+    mutable bool m_localDirty = true;
+    mutable bool m_worldDirty = true;
+
+    // Set when the world matrix changed and the owner's other components have not been told yet
+    bool m_changed = true;
+
+    void invalidateWorld_();
+    void updateWorld_() const;
+    const Transform* getParentTransform_() const;
+
+    friend class GameObject;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace Engine
+{
+
+static constexpr uint32_t UTF8_REPLACEMENT_CHARACTER = 0xFFFD;
+
+// Decodes the code point starting at 'index' and moves 'index' past it. Malformed sequences, overlong encodings
+// and surrogates decode to U+FFFD one byte at a time, so decoding always makes progress.
+uint32_t decodeUtf8(const std::string& text, size_t& index);
+
+}
\ No newline at end of file
@@ -25,6 +25,9 @@ public:
     static Reference<Scene> loadScene(const std::string& path);
 
     static void loadGameObject(GameObject& parent, YAML::Node& node);
+
+    // YAML::LoadFile() through the FileSystem, so documents can come from archives
+    static YAML::Node loadYAML(const std::string& path);
 };
 
 }
\ No newline at end of file
@@ -3,12 +3,16 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <shared_mutex>
 
 #include <core/Core.h>
 
 namespace Engine
 {
 
+class PackArchive;
+
 class FileStream
 {
 public:
@@ -31,9 +35,27 @@ public:
     ~FileStream();
 };
 
+// A file's bytes, either in place in a mounted archive or read into 'storage'. Reusing one view for many reads reuses
+// its storage as well.
+struct FileView
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    std::vector<uint8_t> storage;
+    Reference<PackArchive> archive; // Keeps the bytes mapped while they're in use
+};
+
+// Files are looked up in the mounted archives first, archives mounted later taking precedence, then on disk
 class FileSystem
 {
 public:
+    static bool mount(const std::string& archivePath);
+    static void unmountAll();
+
+    // Mounts every .pak archive in the directory
+    static void mountArchives(const std::string& directory);
+
     static void setAssetDirectoryPath(const std::string& path);
     static inline const std::string& getAssetDirectoryPath() { return m_assetDirectoryPath; }
 
@@ -45,6 +67,12 @@ public:
     static void writeToFile(const std::string& path, const std::string& text);
     static std::string readFile(const std::string& path);
 
+    // Safe to call from any thread. False if the file exists neither in an archive nor on disk.
+    static bool readBytes(const std::string& path, std::vector<uint8_t>& data);
+
+    // Like readBytes(), but files stored uncompressed in an archive aren't copied
+    static bool readView(const std::string& path, FileView& view);
+
     static void writeToBinaryFile(const std::string& path, void* data, size_t size);
     static char* readBinaryFile(const std::string& path, size_t size);
 
@@ -53,7 +81,12 @@ public:
     static std::string getExtension(const std::string& path);
 
 private:
+    static bool readLooseFile_(const std::string& path, std::vector<uint8_t>& data);
+
     static std::string m_assetDirectoryPath;
+
+    static std::vector<Reference<PackArchive>> m_archives;
+    static std::shared_mutex m_archiveMutex;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Engine
+{
+
+// LZ4 block format (no frame), so data can be inspected or produced with the reference lz4 tools
+class Lz4
+{
+public:
+    // Worst case size of compressing 'size' bytes
+    static size_t getMaxCompressedSize(size_t size);
+
+    // Most that 'compressedSize' bytes can expand to, a match length byte of 255 being the densest encoding
+    static size_t getMaxDecompressedSize(size_t compressedSize);
+
+    // Returns the compressed size, 0 if it doesn't fit into 'capacity'
+    static size_t compress(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity);
+
+    // False if the data is corrupted or doesn't decompress to exactly 'size' bytes
+    static bool decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size);
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace Engine
+{
+
+// Read only view of a whole file. Pages are loaded by the OS as they are touched, nothing is copied up front.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    inline const uint8_t* getData() const { return m_data; }
+    inline size_t getSize() const { return m_size; }
+    inline bool isOpen() const { return m_data != nullptr; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+}
\ No newline at end of file
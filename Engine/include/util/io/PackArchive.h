@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <core/Core.h>
+#include <util/io/MappedFile.h>
+
+namespace Engine
+{
+
+struct PackHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t stringsSize;
+};
+
+struct PackEntry
+{
+    uint64_t pathHash;
+
+    // Byte offset from the start of the archive
+    uint64_t offset;
+    uint64_t size;
+    uint64_t storedSize; // Equal to size if the entry isn't compressed
+
+    uint32_t pathOffset; // Into the string table
+    uint32_t compressed;
+};
+
+// A file to pack, stored under 'archivePath' and read from 'filePath'
+struct PackSource
+{
+    std::string archivePath;
+    std::string filePath;
+};
+
+// A file's bytes, straight from the archive's mapping when it's stored uncompressed. Valid while the archive is.
+struct PackView
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+struct PackStatistics
+{
+    uint32_t files = 0;
+    uint32_t compressed = 0;
+    uint64_t size = 0; // Bytes before packing
+    uint64_t storedSize = 0;
+};
+
+// Many files in one memory mapped archive:
+//   header | entries sorted by path hash | string table | file data, in the order the files were given
+// Entries are found by a binary search over the hashes of their normalized paths. Data is LZ4 compressed only where
+// that shrinks it fourfold, decoding runs at no more than a few times the speed of an SSD, so below that reading the
+// extra bytes is cheaper, and uncompressed entries can be used in place.
+class PackArchive
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // nullptr if the file isn't a valid archive
+    static Reference<PackArchive> open(const std::string& path);
+
+    static bool build(const std::string& path, const std::vector<PackSource>& sources, PackStatistics* statistics = nullptr);
+
+    // Forward slashes, no "." or ".." components, the form paths are stored in
+    static std::string normalizePath(const std::string& path);
+
+    bool contains(const std::string& path) const;
+
+    // Decompresses the file into 'data'. Safe to call from any thread.
+    bool read(const std::string& path, std::vector<uint8_t>& data) const;
+
+    // Points 'view' into the mapping without copying, only compressed files are decoded, into 'storage'. Safe to call
+    // from any thread.
+    bool view(const std::string& path, PackView& view, std::vector<uint8_t>& storage) const;
+
+    inline uint32_t getEntryCount() const { return getHeader_().entryCount; }
+    inline const std::string& getPath() const { return m_path; }
+
+private:
+    // Checks that every table and blob lies within the file
+    bool validate_() const;
+
+    // Normalizes the path only if it isn't already, which saves allocating for the common case
+    const PackEntry* lookup_(const std::string& path) const;
+
+    // Takes a normalized path
+    const PackEntry* findEntry_(std::string_view path) const;
+
+    // Decompresses into 'data', which must hold the entry's size
+    bool decompress_(const PackEntry& entry, uint8_t* data) const;
+
+    inline const PackHeader& getHeader_() const { return *reinterpret_cast<const PackHeader*>(m_file.getData()); }
+    inline const PackEntry* getEntries_() const { return reinterpret_cast<const PackEntry*>(m_file.getData() + sizeof(PackHeader)); }
+    inline const char* getStrings_() const { return reinterpret_cast<const char*>(getEntries_() + getEntryCount()); }
+
+    std::string m_path;
+    MappedFile m_file;
+};
+
+}
\ No newline at end of file
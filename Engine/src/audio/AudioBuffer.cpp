@@ -5,6 +5,7 @@
 #include <dr_libs/dr_wav.h>
 #include <dr_libs/dr_mp3.h>
 #include <core/Logger.h>
+#include <util/io/FileSystem.h>
 
 namespace Engine
 {
@@ -13,21 +14,20 @@ AudioBuffer::AudioBuffer(const std::string& filepath)
 {
     alGenBuffers(1, &m_id);
 
-    auto extension = filepath.substr(filepath.find_last_of(".") + 1);
-    if (extension == "wav")
-    {
-        loadWAV(filepath, m_id);
-    }
-    else if (extension == "mp3")
+    AudioData data;
+    if (decode(filepath, data))
     {
-        loadMP3(filepath, m_id);
-    }
-    else
-    {
-        Logger::getCoreLogger()->error("Unsupported audio file type: %s", extension);
+        setData_(data);
     }
 }
 
+AudioBuffer::AudioBuffer(const AudioData& data)
+{
+    alGenBuffers(1, &m_id);
+
+    setData_(data);
+}
+
 AudioBuffer::~AudioBuffer()
 {
     alDeleteBuffers(1, &m_id);
@@ -38,45 +38,79 @@ Reference<AudioBuffer> AudioBuffer::create(const std::string& filepath)
     return Reference<AudioBuffer>(new AudioBuffer(filepath));
 }
 
-void AudioBuffer::loadWAV(const std::string& path, uint32_t buffer)
+bool AudioBuffer::decode(const std::string& path, AudioData& data)
+{
+    auto extension = path.substr(path.find_last_of(".") + 1);
+    if (extension != "wav" && extension != "mp3")
+    {
+        Logger::getCoreLogger()->error("Unsupported audio file type: %s", extension.c_str());
+        return false;
+    }
+
+    // Read through the file system, so sounds can come from archives
+    std::vector<uint8_t> file;
+    if (!FileSystem::readBytes(path, file))
+    {
+        Logger::getCoreLogger()->error("Could not open audio file: %s", path.c_str());
+        return false;
+    }
+
+    if (extension == "wav")
+    {
+        return loadWAV(path, file, data);
+    }
+
+    return loadMP3(path, file, data);
+}
+
+void AudioBuffer::setData_(const AudioData& data)
+{
+    ALenum format = data.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+
+    alBufferData(m_id, format, data.samples.data(), static_cast<ALsizei>(data.samples.size() * sizeof(int16_t)), data.sampleRate);
+}
+
+bool AudioBuffer::loadWAV(const std::string& path, const std::vector<uint8_t>& file, AudioData& data)
 {
     // Load the .wav file
     drwav wav;
-    if (!drwav_init_file(&wav, path.c_str(), nullptr))
+    if (!drwav_init_memory(&wav, file.data(), file.size(), nullptr))
     {
-        Logger::getCoreLogger()->error("Could not open .wav file: %s", path);
-        return;
+        Logger::getCoreLogger()->error("Could not open .wav file: %s", path.c_str());
+        return false;
     }
 
-    size_t dataSize = wav.totalPCMFrameCount * wav.channels * sizeof(drwav_int16);
-    drwav_int16* data = (drwav_int16*)malloc(dataSize);
-    drwav_read_pcm_frames_s16(&wav, wav.totalPCMFrameCount, data);
+    data.channels = wav.channels;
+    data.sampleRate = wav.sampleRate;
+    data.samples.resize(wav.totalPCMFrameCount * wav.channels);
 
-    alBufferData(buffer, AL_FORMAT_STEREO16, data, dataSize, wav.sampleRate);
+    drwav_read_pcm_frames_s16(&wav, wav.totalPCMFrameCount, data.samples.data());
 
     drwav_uninit(&wav);
+    return true;
 }
 
-void AudioBuffer::loadMP3(const std::string& path, uint32_t buffer)
+bool AudioBuffer::loadMP3(const std::string& path, const std::vector<uint8_t>& file, AudioData& data)
 {
     // Load the .mp3 file
     drmp3 mp3;
-    if (!drmp3_init_file(&mp3, path.c_str(), nullptr))
+    if (!drmp3_init_memory(&mp3, file.data(), file.size(), nullptr))
     {
-        Logger::getCoreLogger()->error("Could not open .mp3 file: %s", path);
-        return;
+        Logger::getCoreLogger()->error("Could not open .mp3 file: %s", path.c_str());
+        return false;
     }
 
     drmp3_uint64 frameCount;
     drmp3_get_mp3_and_pcm_frame_count(&mp3, nullptr, &frameCount);
 
-    size_t dataSize = frameCount * mp3.channels * sizeof(drmp3_int16);
-    drmp3_int16* data = (drmp3_int16*)malloc(dataSize);
-    drmp3_read_pcm_frames_s16(&mp3, frameCount, data);
+    data.channels = mp3.channels;
+    data.sampleRate = mp3.sampleRate;
+    data.samples.resize(frameCount * mp3.channels);
 
-    alBufferData(buffer, AL_FORMAT_STEREO16, data, dataSize, mp3.sampleRate);
+    drmp3_read_pcm_frames_s16(&mp3, frameCount, data.samples.data());
 
     drmp3_uninit(&mp3);
+    return true;
 }
 
 }
\ No newline at end of file
@@ -6,12 +6,15 @@
 #include <renderer/Renderer2D.h>
 #include <renderer/Renderer3D.h>
 #include <renderer/Renderer.h>
+#include <renderer/Assets.h>
 #include <util/Time.h>
 #include <renderer/RenderCommand.h>
 #include <util/Timer.h>
+#include <util/io/FileSystem.h>
 #include <physics/2D/PhysicsController2D.h>
 #include <script/ScriptController.h>
 #include <core/Layer.h>
+#include <core/JobSystem.h>
 #include <desktop/ImGuiLayer.h>
 #include <events/WindowEvent.h>
 
@@ -50,6 +53,7 @@ void Game::shutdown()
     ScriptController::getInstance()->finalize();
     PhysicsController2D::getInstance()->finalize();
     AudioController::getInstance()->finalize();
+    JobSystem::getInstance()->finalize();
 
     m_window->close();
     Renderer::shutdown();
@@ -63,9 +67,14 @@ int Game::run()
     m_window->setEventCallback(BIND_EVENT_FN(Game::onEvent));
 
     math::random::init_seed();
+
+    // Before the renderer loads its shaders, which may be packed too
+    FileSystem::mountArchives("./");
+
     Renderer::init();
     Time::init();
 
+    JobSystem::getInstance()->initialize();
     AudioController::getInstance()->initialize();
     ScriptController::getInstance()->initialize();
     PhysicsController2D::getInstance()->initialize();
@@ -87,11 +96,20 @@ int Game::run()
 
         Time::update();
 
+        // Assets finished loading in the background are created before anything uses them this frame
+        Assets::update();
+
         for (auto& layer : m_layers)
         {
             layer->onUpdate(Time::getDelta());
         }
 
+        // ImGui's draw calls bypass the state cache and the renderer, so only the layers are counted
+        RenderCommand::resetStateStatistics();
+        RenderCommand::resetStatistics();
+
+        Renderer::nextFrame();
+
         m_imguiLayer->begin();
         for (auto& layer : m_layers)
         {
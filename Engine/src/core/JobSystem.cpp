@@ -0,0 +1,338 @@
+#include <core/JobSystem.h>
+#include <core/Logger.h>
+
+#include <algorithm>
+
+namespace Engine
+{
+
+static thread_local uint32_t s_threadIndex = 0;
+
+JobSystem::JobSystem()
+{
+
+}
+
+JobSystem::~JobSystem()
+{
+    finalize();
+}
+
+JobSystem* JobSystem::getInstance()
+{
+    static JobSystem system;
+    return &system;
+}
+
+uint32_t JobSystem::getThreadIndex()
+{
+    return s_threadIndex;
+}
+
+void JobSystem::initialize(uint32_t workerCount)
+{
+    if (m_running)
+    {
+        return;
+    }
+
+    if (workerCount == 0)
+    {
+        // Leave a core for the main thread
+        uint32_t cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    m_running = true;
+
+    // Queue 0 belongs to the main thread
+    for (uint32_t i = 0; i < workerCount + 1; i++)
+    {
+        m_queues.push_back(createOwned<WorkQueue>());
+    }
+
+    for (uint32_t i = 1; i <= workerCount; i++)
+    {
+        m_workers.emplace_back(&JobSystem::workerLoop_, this, i);
+    }
+
+    Logger::getCoreLogger()->info("Job system started with %u worker threads.", workerCount);
+}
+
+void JobSystem::finalize()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    m_workers.clear();
+
+    Job job;
+
+    while (popBackground_(job))
+    {
+        m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+
+        if (job.counter)
+        {
+            release_(*job.counter);
+        }
+    }
+
+    // Not running any more, so jobs these schedule run inline too
+    for (uint32_t index = 0; index < m_queues.size(); index++)
+    {
+        while (pop_(index, job))
+        {
+            m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+            run_(job);
+        }
+    }
+
+    m_queues.clear();
+}
+
+void JobSystem::execute(const std::function<void()>& function, JobCounter* counter)
+{
+    push_({ function, counter });
+}
+
+void JobSystem::executeAfter(const JobCounter& dependency, const std::function<void()>& function, JobCounter* counter)
+{
+    Job job = { function, counter };
+
+    if (counter)
+    {
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Checked under the lock release_() takes, so the job can't be parked after the waiting jobs were scheduled
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+
+        if (!dependency.isDone())
+        {
+            dependency.m_waiting.push_back(std::move(job));
+            return;
+        }
+    }
+
+    schedule_(std::move(job));
+}
+
+void JobSystem::executeBackground(const std::function<void()>& function, JobCounter* counter)
+{
+    Job job = { function, counter };
+
+    if (counter)
+    {
+        counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Not initialized: run inline
+    if (!m_running)
+    {
+        run_(job);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_backgroundQueue.mutex);
+        m_backgroundQueue.jobs.push_back(std::move(job));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_pendingJobs.fetch_add(1, std::memory_order_release);
+    }
+    m_wakeCondition.notify_one();
+}
+
+void JobSystem::wait(const JobCounter& counter)
+{
+    uint32_t index = s_threadIndex;
+
+    while (!counter.isDone())
+    {
+        if (!runNext_(index))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::push_(Job&& job)
+{
+    if (job.counter)
+    {
+        job.counter->m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    schedule_(std::move(job));
+}
+
+void JobSystem::schedule_(Job&& job)
+{
+    // Not initialized: run inline
+    if (!m_running)
+    {
+        run_(job);
+        return;
+    }
+
+    auto& queue = *m_queues[s_threadIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_pendingJobs.fetch_add(1, std::memory_order_release);
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool JobSystem::pop_(uint32_t index, Job& job)
+{
+    auto& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.jobs.empty())
+    {
+        return false;
+    }
+
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::steal_(uint32_t thief, Job& job)
+{
+    uint32_t count = static_cast<uint32_t>(m_queues.size());
+
+    for (uint32_t i = 1; i < count; i++)
+    {
+        auto& queue = *m_queues[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.jobs.empty())
+        {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::popBackground_(Job& job)
+{
+    std::lock_guard<std::mutex> lock(m_backgroundQueue.mutex);
+
+    if (m_backgroundQueue.jobs.empty())
+    {
+        return false;
+    }
+
+    job = std::move(m_backgroundQueue.jobs.front());
+    m_backgroundQueue.jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::runNext_(uint32_t index)
+{
+    Job job;
+
+    // Background jobs are oldest first and left to the workers
+    if (!pop_(index, job) && !steal_(index, job) && (index == 0 || !popBackground_(job)))
+    {
+        return false;
+    }
+
+    m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+
+    run_(job);
+    return true;
+}
+
+void JobSystem::run_(Job& job)
+{
+    job.function();
+
+    if (job.counter)
+    {
+        release_(*job.counter);
+    }
+}
+
+void JobSystem::release_(JobCounter& counter)
+{
+    // Without the lock unless this may be the last job, most jobs don't finish last
+    uint32_t count = counter.m_count.load(std::memory_order_relaxed);
+
+    while (count > 1)
+    {
+        if (counter.m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+
+    // Reaching zero under the lock parks nothing after the waiting jobs are taken, and keeps the counter alive until
+    // they are, as its destructor takes the lock too. The count may have risen again if the counter was reused.
+    std::vector<Job> waiting;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+
+        if (counter.m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            waiting.swap(counter.m_waiting);
+        }
+    }
+
+    for (auto& job : waiting)
+    {
+        schedule_(std::move(job));
+    }
+}
+
+void JobSystem::workerLoop_(uint32_t index)
+{
+    s_threadIndex = index;
+
+    while (true)
+    {
+        if (runNext_(index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]()
+        {
+            return !m_running || m_pendingJobs.load(std::memory_order_acquire) > 0;
+        });
+
+        if (!m_running)
+        {
+            return;
+        }
+    }
+}
+
+}
@@ -67,6 +67,9 @@ void ImGuiLayer::end()
 		ImGui::RenderPlatformWindowsDefault();
 		glfwMakeContextCurrent(backup_current_context);
 	}
+
+    // The backend sets GL state directly
+    RenderCommand::invalidateState();
 }
 
 void ImGuiLayer::onDetach()
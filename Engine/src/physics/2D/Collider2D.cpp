@@ -31,7 +31,7 @@ void Collider2D::onSceneSet(const Reference<Scene>& scene)
 {
     createFixture();
 
-    m_body = m_owner->getComponent<RigidBody2D>();
+    m_body = getOwner()->getComponent<RigidBody2D>();
     m_body->addCollider(this);
 }
 
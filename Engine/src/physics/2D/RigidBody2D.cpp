@@ -25,8 +25,10 @@ void RigidBody2D::onSceneSet(const Reference<Scene>& scene)
 
 void RigidBody2D::createBody()
 {
-    math::vec3 position = m_owner->getComponent<Transform>()->getWorldTranslation();
-    float rotation = m_owner->getComponent<Transform>()->getWorldRotation().z;
+    auto transform = getOwner()->getComponent<Transform>();
+
+    math::vec3 position = transform->getWorldTranslation();
+    float rotation = transform->getWorldRotation().z;
 
     m_def.position = b2Vec2{position.x, position.y};
     m_def.angle = math::radians(rotation);
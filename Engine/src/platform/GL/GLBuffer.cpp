@@ -1,8 +1,10 @@
 #include <platform/GL/GLBuffer.h>
+#include <platform/GL/GLStateCache.h>
 #include <renderer/Buffer.h>
 #include <core/Logger.h>
 
 #include <cstring>
+#include <algorithm>
 
 #include <GL/glew.h>
 
@@ -39,7 +41,7 @@ GLVertexBuffer::GLVertexBuffer(const void* data, size_t size)
 
 GLVertexBuffer::~GLVertexBuffer()
 {
-    glDeleteBuffers(1, &m_id);
+    GLStateCache::deleteBuffer(m_id);
 }
 
 void GLVertexBuffer::setData(const void* data, size_t size, size_t offset)
@@ -53,20 +55,26 @@ void GLVertexBuffer::setData(const void* data, size_t size, size_t offset)
     }
     else
     {
-        void* ptr = getBufferPtr(size, offset);
-        memcpy(ptr, data, size);
-        unmap();
+        // Mapping for every upload can wait on the GPU, per frame data should go through a StreamBuffer instead
+        glNamedBufferSubData(m_id, offset, size, data);
     }
 }
 
+void GLVertexBuffer::copyData(const VertexBuffer& source, size_t size, size_t readOffset, size_t writeOffset)
+{
+    const auto& glSource = static_cast<const GLVertexBuffer&>(source);
+
+    glCopyNamedBufferSubData(glSource.m_id, m_id, readOffset, writeOffset, size);
+}
+
 void GLVertexBuffer::bind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_id);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_id);
 }
 
 void GLVertexBuffer::unbind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 void* GLVertexBuffer::getBufferPtr(size_t size, size_t offset) const
@@ -117,7 +125,7 @@ GLIndexBuffer::GLIndexBuffer(const uint32_t* data, uint32_t count, IndexDataType
 
 GLIndexBuffer::~GLIndexBuffer()
 {
-    glDeleteBuffers(1, &m_id);
+    GLStateCache::deleteBuffer(m_id);
 }
 
 void GLIndexBuffer::setData(const uint32_t* data, uint32_t count, uint32_t offset)
@@ -131,20 +139,25 @@ void GLIndexBuffer::setData(const uint32_t* data, uint32_t count, uint32_t offse
     }
     else
     {
-        void* ptr = getBufferPtr(count, offset);
-        memcpy(ptr, data, count * m_typeSize);
-        unmap();
+        glNamedBufferSubData(m_id, offset * m_typeSize, count * m_typeSize, data);
     }
 }
 
+void GLIndexBuffer::copyData(const IndexBuffer& source, uint32_t count, uint32_t readOffset, uint32_t writeOffset)
+{
+    const auto& glSource = static_cast<const GLIndexBuffer&>(source);
+
+    glCopyNamedBufferSubData(glSource.m_id, m_id, readOffset * m_typeSize, writeOffset * m_typeSize, count * m_typeSize);
+}
+
 void GLIndexBuffer::bind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
 }
 
 void GLIndexBuffer::unbind() const
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void* GLIndexBuffer::getBufferPtr(uint32_t size, uint32_t offset) const
@@ -195,11 +208,11 @@ GLUniformBuffer::GLUniformBuffer(size_t size, uint32_t bindingPoint)
 {
     glCreateBuffers(1, &m_id);
 
-    glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+    GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_id);
     glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, 0);
 
-    glBindBufferRange(GL_UNIFORM_BUFFER, m_bindingPoint, m_id, 0, size);
+    bindRange();
 }
 
 GLUniformBuffer::GLUniformBuffer(const void* data, size_t size, uint32_t bindingPoint)
@@ -207,11 +220,16 @@ GLUniformBuffer::GLUniformBuffer(const void* data, size_t size, uint32_t binding
 {
     glCreateBuffers(1, &m_id);
 
-    glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+    GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_id);
     glBufferData(GL_UNIFORM_BUFFER, size, data, GL_STATIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    bindRange();
+}
 
-    glBindBufferRange(GL_UNIFORM_BUFFER, m_bindingPoint, m_id, 0, size);
+GLUniformBuffer::~GLUniformBuffer()
+{
+    GLStateCache::deleteBuffer(m_id);
 }
 
 void GLUniformBuffer::setBlockDeclaration(const Shader& shader)
@@ -238,12 +256,17 @@ void GLUniformBuffer::setBlockDeclaration(const Shader& shader)
 
 void GLUniformBuffer::bind() const
 {
-    glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+    GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, m_id);
 }
 
 void GLUniformBuffer::unbind() const
 {
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void GLUniformBuffer::bindRange() const
+{
+    GLStateCache::bindBufferRange(GL_UNIFORM_BUFFER, m_bindingPoint, m_id, 0, m_size);
 }
 
 void GLUniformBuffer::setData(const void* data, size_t size, size_t offset)
@@ -254,11 +277,11 @@ void GLUniformBuffer::setData(const void* data, size_t size, size_t offset)
         glBufferData(m_id, size, data, GL_STATIC_DRAW);
         unbind();
     }
-    else // Use memcpy (faster)
+    else
     {
-        void* ptr = getBufferPtr(offset);
-        memcpy(ptr, data, size);
-        unmap();
+        // Mapping with read access makes the driver wait for the GPU and keep the contents readable, only to copy a
+        // few bytes in
+        glNamedBufferSubData(m_id, offset, size, data);
     }
 }
 
@@ -306,4 +329,222 @@ void GLUniformBuffer::setVariable(const std::string& uniform, const void* data,
     setData(data, size, offset);
 }
 
+//------------------------------------------------------------------------------------------------//
+
+GLShaderStorageBuffer::GLShaderStorageBuffer(size_t size, uint32_t bindingPoint)
+    : m_bindingPoint(bindingPoint)
+{
+    glCreateBuffers(1, &m_id);
+
+    reserve(size);
+}
+
+GLShaderStorageBuffer::~GLShaderStorageBuffer()
+{
+    GLStateCache::deleteBuffer(m_id);
+}
+
+void GLShaderStorageBuffer::setData(const void* data, size_t size, size_t offset)
+{
+    if (offset + size > m_size)
+    {
+        reserve(std::max(offset + size, m_size * 2));
+    }
+
+    glNamedBufferSubData(m_id, offset, size, data);
+}
+
+void GLShaderStorageBuffer::reserve(size_t size)
+{
+    if (size <= m_size)
+    {
+        return;
+    }
+
+    m_size = size;
+    glNamedBufferData(m_id, m_size, nullptr, GL_DYNAMIC_DRAW);
+}
+
+void GLShaderStorageBuffer::bindRange() const
+{
+    GLStateCache::bindBufferRange(GL_SHADER_STORAGE_BUFFER, m_bindingPoint, m_id, 0, m_size);
+}
+
+//------------------------------------------------------------------------------------------------//
+
+GLIndirectBuffer::GLIndirectBuffer(uint32_t capacity)
+{
+    glCreateBuffers(1, &m_id);
+
+    reserve_(capacity);
+}
+
+GLIndirectBuffer::~GLIndirectBuffer()
+{
+    GLStateCache::deleteBuffer(m_id);
+}
+
+void GLIndirectBuffer::setData(const DrawIndirectCommand* commands, uint32_t count, uint32_t offset)
+{
+    if (offset + count > m_capacity)
+    {
+        reserve_(std::max(offset + count, m_capacity * 2));
+    }
+
+    glNamedBufferSubData(m_id, offset * sizeof(DrawIndirectCommand), count * sizeof(DrawIndirectCommand), commands);
+}
+
+void GLIndirectBuffer::bind() const
+{
+    GLStateCache::bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_id);
+}
+
+void GLIndirectBuffer::reserve_(uint32_t capacity)
+{
+    if (capacity <= m_capacity)
+    {
+        return;
+    }
+
+    m_capacity = capacity;
+    glNamedBufferData(m_id, m_capacity * sizeof(DrawIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+}
+
+//------------------------------------------------------------------------------------------------//
+
+static constexpr GLbitfield STREAM_MAP_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// Waits in steps so a lost context can't hang the thread forever
+static constexpr GLuint64 STREAM_WAIT_TIMEOUT = 1000000000;
+
+GLStreamBuffer::GLStreamBuffer(size_t regionSize)
+    : m_regionSize(regionSize)
+{
+    glCreateBuffers(1, &m_id);
+    glNamedBufferStorage(m_id, m_regionSize * FRAME_COUNT, nullptr, STREAM_MAP_FLAGS);
+
+    m_memory = static_cast<uint8_t*>(glMapNamedBufferRange(m_id, 0, m_regionSize * FRAME_COUNT, STREAM_MAP_FLAGS));
+
+    if (m_memory == nullptr)
+    {
+        Logger::getCoreLogger()->error("Nullptr returned from glMapNamedBufferRange().");
+    }
+}
+
+GLStreamBuffer::~GLStreamBuffer()
+{
+    for (GLsync fence : m_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+
+    glUnmapNamedBuffer(m_id);
+    GLStateCache::deleteBuffer(m_id);
+}
+
+StreamAllocation GLStreamBuffer::reserve(size_t size, size_t alignment)
+{
+    auto alignUp = [alignment](size_t offset)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    };
+
+    size_t regionStart = m_region * m_regionSize;
+    size_t start = alignUp(regionStart + m_head);
+
+    if (start + size > regionStart + m_regionSize && m_head > 0)
+    {
+        advance_();
+
+        regionStart = m_region * m_regionSize;
+        start = alignUp(regionStart);
+    }
+
+    if (m_memory == nullptr || start + size > regionStart + m_regionSize)
+    {
+        Logger::getCoreLogger()->error("Stream buffer allocation of %zu bytes doesn't fit in a %zu byte region.", size, m_regionSize);
+        return {};
+    }
+
+    m_reserved = start;
+
+    return { m_memory + start, start, regionStart + m_regionSize - start };
+}
+
+void GLStreamBuffer::commit(size_t size)
+{
+    m_head = m_reserved + size - m_region * m_regionSize;
+}
+
+void GLStreamBuffer::nextFrame()
+{
+    // Nothing was written, the region is still free
+    if (m_head == 0)
+    {
+        return;
+    }
+
+    advance_();
+}
+
+void GLStreamBuffer::advance_()
+{
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_region = (m_region + 1) % FRAME_COUNT;
+    m_head = 0;
+    m_reserved = m_region * m_regionSize;
+
+    wait_(m_region);
+}
+
+void GLStreamBuffer::wait_(uint32_t region)
+{
+    GLsync fence = m_fences[region];
+
+    if (!fence)
+    {
+        return;
+    }
+
+    // Poll first, then flush so the fence is guaranteed to signal
+    GLbitfield flags = 0;
+    GLuint64 timeout = 0;
+
+    while (true)
+    {
+        GLenum result = glClientWaitSync(fence, flags, timeout);
+
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+
+        if (result == GL_WAIT_FAILED)
+        {
+            Logger::getCoreLogger()->error("glClientWaitSync() failed on a stream buffer region.");
+            break;
+        }
+
+        flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        timeout = STREAM_WAIT_TIMEOUT;
+    }
+
+    glDeleteSync(fence);
+    m_fences[region] = nullptr;
+}
+
+void GLStreamBuffer::bind() const
+{
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, m_id);
+}
+
+void GLStreamBuffer::bindRange(uint32_t bindingPoint, size_t offset, size_t size) const
+{
+    GLStateCache::bindBufferRange(GL_SHADER_STORAGE_BUFFER, bindingPoint, m_id, offset, size);
+}
+
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <platform/GL/GLFramebuffer.h>
+#include <platform/GL/GLStateCache.h>
 #include <core/Logger.h>
 
 #include <GL/glew.h>
@@ -69,9 +70,9 @@ GLFramebuffer::~GLFramebuffer()
 {
     if (m_id != 0)
     {
-        glDeleteFramebuffers(1, &m_id);
-        glDeleteTextures(m_colorAttachments.size(), &m_colorAttachments[0]);
-        glDeleteTextures(1, &m_depthAttachment);
+        GLStateCache::deleteFramebuffer(m_id);
+        GLStateCache::deleteTextures(m_colorAttachments.size(), &m_colorAttachments[0]);
+        GLStateCache::deleteTextures(1, &m_depthAttachment);
     }
 }
 
@@ -104,9 +105,9 @@ void GLFramebuffer::invalidate()
 {
     if (m_id != 0)
     {
-        glDeleteFramebuffers(1, &m_id);
-        glDeleteTextures(m_colorAttachments.size(), &m_colorAttachments[0]);
-        glDeleteTextures(1, &m_depthAttachment);
+        GLStateCache::deleteFramebuffer(m_id);
+        GLStateCache::deleteTextures(m_colorAttachments.size(), &m_colorAttachments[0]);
+        GLStateCache::deleteTextures(1, &m_depthAttachment);
 
         m_colorAttachments.clear();
         m_depthAttachment = 0;
@@ -114,7 +115,7 @@ void GLFramebuffer::invalidate()
     
     // Create and bind the framebuffer
     glCreateFramebuffers(1, &m_id);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    GLStateCache::bindFramebuffer(m_id);
 
     if (m_colorAttachmentSpecs.size() > 0)
     {
@@ -125,7 +126,7 @@ void GLFramebuffer::invalidate()
         {
             auto format = Utils::getSizedTextureFormatEnumValue_(m_colorAttachmentSpecs[i].format);
 
-            glBindTextureUnit(0, m_colorAttachments[i]);
+            GLStateCache::bindTextureUnit(0, m_colorAttachments[i]);
             glTextureStorage2D(m_colorAttachments[i], 1, format, m_width, m_height);
 
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, m_colorAttachments[i], 0);
@@ -137,8 +138,17 @@ void GLFramebuffer::invalidate()
         auto format = Utils::getSizedTextureFormatEnumValue_(m_depthAttachmentSpec.format);
 
         glCreateTextures(GL_TEXTURE_2D, 1, &m_depthAttachment);
-        glBindTextureUnit(0, m_depthAttachment);
+        GLStateCache::bindTextureUnit(0, m_depthAttachment);
         glTextureStorage2D(m_depthAttachment, 1, format, m_width, m_height);
+
+        // Depth attachments are sampled as shadow maps, anything outside the map counts as unoccluded
+        const float border[] = { 1.f, 1.f, 1.f, 1.f };
+        glTextureParameteri(m_depthAttachment, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(m_depthAttachment, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTextureParameteri(m_depthAttachment, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTextureParameteri(m_depthAttachment, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTextureParameterfv(m_depthAttachment, GL_TEXTURE_BORDER_COLOR, border);
+
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, m_depthAttachment, 0);
     }
     
@@ -160,7 +170,7 @@ void GLFramebuffer::invalidate()
     }
 
     // Make sure to not leave framebuffer bound
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(0);
 }
 
 void GLFramebuffer::resize(uint32_t width, uint32_t height)
@@ -180,14 +190,14 @@ void GLFramebuffer::resize(uint32_t width, uint32_t height)
 void GLFramebuffer::bind() const
 {
     s_currentBound = this;
-    glViewport(0, 0, m_width, m_height);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_id);
+    GLStateCache::viewport(0, 0, m_width, m_height);
+    GLStateCache::bindFramebuffer(m_id);
 }
 
 void GLFramebuffer::unbind() const
 {
     s_currentBound = nullptr;
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    GLStateCache::bindFramebuffer(0);
 }
 
 void GLFramebuffer::drawBuffer(uint32_t buffer) const
@@ -1,4 +1,5 @@
 #include <platform/GL/GLRendererAPI.h>
+#include <platform/GL/GLStateCache.h>
 #include <core/Logger.h>
 
 namespace Engine
@@ -34,17 +35,23 @@ void GLRendererAPI::init()
     glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
     m_capabilities.maxTextureSize = maxTextureSize;
 
+    int storageBufferAlignment;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageBufferAlignment);
+    m_capabilities.storageBufferAlignment = storageBufferAlignment;
+
     m_capabilities.version = std::string(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
 
     int shaderVersion;
     m_capabilities.shaderVersion = std::stoi(reinterpret_cast<const char*>(glGetStringi(GL_SHADING_LANGUAGE_VERSION, 0)));
 
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    GLStateCache::invalidate();
 }
 
 void GLRendererAPI::setViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 {
-    glViewport(x, y, width, height);
+    GLStateCache::viewport(x, y, width, height);
 }
 
 void GLRendererAPI::setClearColor(const math::vec4& color)
@@ -71,18 +78,12 @@ void GLRendererAPI::clear(uint32_t buffer)
 
 void GLRendererAPI::setDepthTesting(bool enabled)
 {
-    if (enabled)
-        glEnable(GL_DEPTH_TEST);
-    else
-        glDisable(GL_DEPTH_TEST);
+    GLStateCache::setEnabled(GL_DEPTH_TEST, enabled);
 }
 
 void GLRendererAPI::setBlend(bool enabled)
 {
-    if (enabled)
-        glEnable(GL_BLEND);
-    else
-        glDisable(GL_BLEND);
+    GLStateCache::setEnabled(GL_BLEND, enabled);
 }
 
 void GLRendererAPI::setBlendFunction(BlendFunction src, BlendFunction dst)
@@ -109,10 +110,40 @@ void GLRendererAPI::setBlendFunction(BlendFunction src, BlendFunction dst)
         default: gldst = GL_ZERO; break;
     }
 
-    glBlendFunc(glsrc, gldst);
+    GLStateCache::blendFunc(glsrc, gldst);
 }
 
-void GLRendererAPI::renderIndexed(Reference<VertexArray> array, uint32_t count, uint32_t offset)
+void GLRendererAPI::setDepthFunction(DepthFunction function)
+{
+    GLenum func;
+
+    switch (function)
+    {
+        case DepthFunction::Less: func = GL_LESS; break;
+        case DepthFunction::Greater: func = GL_GREATER; break;
+        case DepthFunction::Equal: func = GL_EQUAL; break;
+        case DepthFunction::NotEqual: func = GL_NOTEQUAL; break;
+        case DepthFunction::LessOrEqual: func = GL_LEQUAL; break;
+        case DepthFunction::GreaterOrEqual: func = GL_GEQUAL; break;
+        case DepthFunction::Always: func = GL_ALWAYS; break;
+        case DepthFunction::Never: func = GL_NEVER; break;
+        default: func = GL_LESS; break;
+    }
+
+    GLStateCache::depthFunc(func);
+}
+
+void GLRendererAPI::bindTexture(uint32_t slot, uint32_t id)
+{
+    GLStateCache::bindTextureUnit(slot, id);
+}
+
+void GLRendererAPI::copyTexture(uint32_t source, uint32_t destination, uint32_t width, uint32_t height)
+{
+    glCopyImageSubData(source, GL_TEXTURE_2D, 0, 0, 0, 0, destination, GL_TEXTURE_2D, 0, 0, 0, 0, width, height, 1);
+}
+
+void GLRendererAPI::renderIndexed(Reference<VertexArray> array, uint32_t count, uint32_t offset, int32_t baseVertex)
 {
     if (count == 0)
     {
@@ -128,7 +159,17 @@ void GLRendererAPI::renderIndexed(Reference<VertexArray> array, uint32_t count,
         default: type = GL_UNSIGNED_INT; break;
     }
 
-    glDrawElements(GL_TRIANGLES, count, type, (void*)(offset * sizeof(uint32_t)));
+    if (baseVertex != 0)
+    {
+        glDrawElementsBaseVertex(GL_TRIANGLES, count, type, (void*)(offset * sizeof(uint32_t)), baseVertex);
+    }
+    else
+    {
+        glDrawElements(GL_TRIANGLES, count, type, (void*)(offset * sizeof(uint32_t)));
+    }
+
+    m_statistics.drawCalls++;
+    m_statistics.draws++;
 }
 
 void GLRendererAPI::renderInstanced(const Reference<VertexArray>& array, uint32_t instanceCount, uint32_t count, uint32_t offset)
@@ -148,6 +189,47 @@ void GLRendererAPI::renderInstanced(const Reference<VertexArray>& array, uint32_
     }
 
     glDrawElementsInstanced(GL_TRIANGLES, count, type, (void*)(offset * sizeof(uint32_t)), instanceCount);
+
+    m_statistics.drawCalls++;
+    m_statistics.draws++;
+}
+
+void GLRendererAPI::renderMultiIndirect(const Reference<VertexArray>& array, const IndirectBuffer& commands, uint32_t drawCount, uint32_t first)
+{
+    if (drawCount == 0)
+    {
+        return;
+    }
+
+    uint32_t type;
+    switch (array->getIndexBuffer()->getDataType())
+    {
+        case IndexDataType::UInt8:  type = GL_UNSIGNED_BYTE;  break;
+        case IndexDataType::UInt16: type = GL_UNSIGNED_SHORT; break;
+        case IndexDataType::UInt32: type = GL_UNSIGNED_INT;   break;
+        default: type = GL_UNSIGNED_INT; break;
+    }
+
+    commands.bind();
+    glMultiDrawElementsIndirect(GL_TRIANGLES, type, (void*)(first * sizeof(DrawIndirectCommand)), drawCount, 0);
+
+    m_statistics.drawCalls++;
+    m_statistics.draws += drawCount;
+}
+
+void GLRendererAPI::invalidateState()
+{
+    GLStateCache::invalidate();
+}
+
+void GLRendererAPI::resetStateStatistics()
+{
+    GLStateCache::resetStatistics();
+}
+
+RendererStateStatistics GLRendererAPI::getStateStatistics() const
+{
+    return { GLStateCache::getIssued(), GLStateCache::getFiltered() };
 }
 
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include <platform/GL/GLShader.h>
+#include <platform/GL/GLStateCache.h>
 #include <util/io/FileSystem.h>
 #include <core/Logger.h>
 #include <renderer/RenderCommand.h>
 
 #include <cstring>
+#include <vector>
 
 namespace Engine
 {
@@ -45,7 +47,7 @@ GLShader::~GLShader()
 {
     if (m_id != 0)
     {
-        glDeleteProgram(m_id);
+        GLStateCache::deleteProgram(m_id);
     }
 }
 
@@ -157,17 +159,99 @@ bool GLShader::compileShader(const ShaderSource& source)
     glDeleteShader(vertex);
     glDeleteShader(fragment);
 
+    if (success)
+    {
+        loadUniformLocations();
+    }
+
     return success;
 }
 
+void GLShader::loadUniformLocations()
+{
+    int32_t count = 0, maxLength = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> buffer(maxLength + 1);
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type;
+        glGetActiveUniform(m_id, i, buffer.size(), &length, &size, &type, buffer.data());
+
+        std::string name(buffer.data(), length);
+        int32_t location = glGetUniformLocation(m_id, name.c_str());
+
+        // Members of uniform blocks have no location
+        if (location == -1)
+        {
+            continue;
+        }
+
+        m_uniformLocations[name] = location;
+
+        // Arrays are reported as "name[0]", make the plain name and the other elements available as well
+        size_t bracket = name.rfind("[0]");
+        if (bracket != std::string::npos && bracket + 3 == name.size())
+        {
+            std::string base = name.substr(0, bracket);
+            m_uniformLocations[base] = location;
+
+            for (GLint element = 1; element < size; element++)
+            {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                m_uniformLocations[elementName] = glGetUniformLocation(m_id, elementName.c_str());
+            }
+        }
+    }
+}
+
 void GLShader::bind() const
 {
-    glUseProgram(m_id);
+    GLStateCache::useProgram(m_id);
 }
 
 void GLShader::unbind() const
 {
-    glUseProgram(0);
+    GLStateCache::useProgram(0);
+}
+
+UniformHandle GLShader::getUniformHandle(const std::string& name)
+{
+    return { getUniformLocation(name) };
+}
+
+void GLShader::setInt(UniformHandle handle, int value)
+{
+    glUniform1i(handle.location, value);
+}
+
+void GLShader::setFloat(UniformHandle handle, float value)
+{
+    glUniform1f(handle.location, value);
+}
+
+void GLShader::setFloat3(UniformHandle handle, const math::vec3& value)
+{
+    glUniform3f(handle.location, value.x, value.y, value.z);
+}
+
+void GLShader::setFloat4(UniformHandle handle, const math::vec4& value)
+{
+    glUniform4f(handle.location, value.x, value.y, value.z, value.w);
+}
+
+void GLShader::setMatrix3(UniformHandle handle, const math::mat3& value)
+{
+    glUniformMatrix3fv(handle.location, 1, GL_FALSE, math::buffer(value));
+}
+
+void GLShader::setMatrix4(UniformHandle handle, const math::mat4& value)
+{
+    glUniformMatrix4fv(handle.location, 1, GL_FALSE, math::buffer(value));
 }
 
 void GLShader::setInt(const std::string& name, int value)
@@ -314,14 +398,16 @@ void GLShader::setMatrix4Array(const std::string& name, math::mat4* matrices, ui
     glUniformMatrix4fv(location, count, GL_FALSE, math::buffer(matrices[0]));
 }
 
-uint32_t GLShader::getUniformLocation(const std::string& name)
+int32_t GLShader::getUniformLocation(const std::string& name)
 {
-    if (m_uniformLocations.find(name) == m_uniformLocations.end())
+    auto it = m_uniformLocations.find(name);
+
+    if (it == m_uniformLocations.end())
     {
-        m_uniformLocations.insert(std::make_pair(name, glGetUniformLocation(m_id, name.c_str())));
+        it = m_uniformLocations.emplace(name, glGetUniformLocation(m_id, name.c_str())).first;
     }
 
-    return m_uniformLocations.at(name);
+    return it->second;
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include <platform/GL/GLStateCache.h>
+
+namespace Engine
+{
+
+bool GLStateCache::update_(GLuint& cached, GLuint value)
+{
+    if (cached == value)
+    {
+        s_filtered++;
+        return false;
+    }
+
+    cached = value;
+    s_issued++;
+    return true;
+}
+
+int32_t GLStateCache::getCapabilityIndex_(GLenum capability)
+{
+    switch (capability)
+    {
+        case GL_DEPTH_TEST:   return DepthTest;
+        case GL_BLEND:        return Blend;
+        case GL_CULL_FACE:    return CullFace;
+        case GL_STENCIL_TEST: return StencilTest;
+        default:              return -1;
+    }
+}
+
+int32_t GLStateCache::getBufferIndex_(GLenum target)
+{
+    switch (target)
+    {
+        case GL_ARRAY_BUFFER:         return 0;
+        case GL_ELEMENT_ARRAY_BUFFER: return 1;
+        case GL_UNIFORM_BUFFER:       return 2;
+        case GL_DRAW_INDIRECT_BUFFER: return 3;
+        default:                      return -1;
+    }
+}
+
+std::array<GLStateCache::BufferRange, GLStateCache::MAX_BUFFER_BINDINGS>* GLStateCache::getBufferRanges_(GLenum target)
+{
+    switch (target)
+    {
+        case GL_UNIFORM_BUFFER:        return &s_uniformRanges;
+        case GL_SHADER_STORAGE_BUFFER: return &s_storageRanges;
+        default:                       return nullptr;
+    }
+}
+
+void GLStateCache::useProgram(GLuint program)
+{
+    if (update_(s_program, program))
+    {
+        glUseProgram(program);
+    }
+}
+
+void GLStateCache::bindVertexArray(GLuint array)
+{
+    if (update_(s_vertexArray, array))
+    {
+        glBindVertexArray(array);
+
+        // The element buffer binding is part of the vertex array
+        s_buffers[1] = UNKNOWN;
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    int32_t index = getBufferIndex_(target);
+
+    if (index == -1)
+    {
+        s_issued++;
+        glBindBuffer(target, buffer);
+    }
+    else if (update_(s_buffers[index], buffer))
+    {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    auto ranges = getBufferRanges_(target);
+
+    if (!ranges || index >= MAX_BUFFER_BINDINGS)
+    {
+        s_issued++;
+        glBindBufferRange(target, index, buffer, offset, size);
+        return;
+    }
+
+    BufferRange& range = (*ranges)[index];
+
+    if (range.buffer == buffer && range.offset == offset && range.size == size)
+    {
+        s_filtered++;
+        return;
+    }
+
+    range = { buffer, offset, size };
+    s_issued++;
+    glBindBufferRange(target, index, buffer, offset, size);
+
+    // Binding an indexed target also binds the generic one
+    int32_t generic = getBufferIndex_(target);
+    if (generic != -1)
+    {
+        s_buffers[generic] = buffer;
+    }
+}
+
+void GLStateCache::bindTextureUnit(GLuint unit, GLuint texture)
+{
+    if (unit >= MAX_TEXTURE_UNITS)
+    {
+        s_issued++;
+        glBindTextureUnit(unit, texture);
+    }
+    else if (update_(s_textures[unit], texture))
+    {
+        glBindTextureUnit(unit, texture);
+    }
+}
+
+void GLStateCache::bindFramebuffer(GLuint framebuffer)
+{
+    if (update_(s_framebuffer, framebuffer))
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    }
+}
+
+void GLStateCache::setEnabled(GLenum capability, bool enabled)
+{
+    int32_t index = getCapabilityIndex_(capability);
+
+    if (index == -1)
+    {
+        s_issued++;
+    }
+    else if (!update_(s_capabilities[index], enabled ? 1 : 0))
+    {
+        return;
+    }
+
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void GLStateCache::blendFunc(GLenum src, GLenum dst)
+{
+    if (s_blendSrc == src && s_blendDst == dst)
+    {
+        s_filtered++;
+        return;
+    }
+
+    s_blendSrc = src;
+    s_blendDst = dst;
+    s_issued++;
+    glBlendFunc(src, dst);
+}
+
+void GLStateCache::depthFunc(GLenum func)
+{
+    if (update_(s_depthFunc, func))
+    {
+        glDepthFunc(func);
+    }
+}
+
+void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    std::array<GLint, 4> viewport = { x, y, width, height };
+
+    if (s_viewport == viewport)
+    {
+        s_filtered++;
+        return;
+    }
+
+    s_viewport = viewport;
+    s_issued++;
+    glViewport(x, y, width, height);
+}
+
+void GLStateCache::deleteProgram(GLuint program)
+{
+    glDeleteProgram(program);
+
+    if (s_program == program)
+    {
+        s_program = UNKNOWN;
+    }
+}
+
+void GLStateCache::deleteVertexArray(GLuint array)
+{
+    glDeleteVertexArrays(1, &array);
+
+    if (s_vertexArray == array)
+    {
+        s_vertexArray = 0;
+        s_buffers[1] = UNKNOWN;
+    }
+}
+
+void GLStateCache::deleteBuffer(GLuint buffer)
+{
+    glDeleteBuffers(1, &buffer);
+
+    for (GLuint& bound : s_buffers)
+    {
+        if (bound == buffer)
+        {
+            bound = 0;
+        }
+    }
+
+    for (auto ranges : { &s_uniformRanges, &s_storageRanges })
+    {
+        for (BufferRange& range : *ranges)
+        {
+            if (range.buffer == buffer)
+            {
+                range = { 0, 0, 0 };
+            }
+        }
+    }
+}
+
+void GLStateCache::deleteTextures(GLsizei count, const GLuint* textures)
+{
+    glDeleteTextures(count, textures);
+
+    for (GLsizei i = 0; i < count; i++)
+    {
+        for (GLuint& bound : s_textures)
+        {
+            if (bound == textures[i])
+            {
+                bound = 0;
+            }
+        }
+    }
+}
+
+void GLStateCache::deleteFramebuffer(GLuint framebuffer)
+{
+    glDeleteFramebuffers(1, &framebuffer);
+
+    if (s_framebuffer == framebuffer)
+    {
+        s_framebuffer = 0;
+    }
+}
+
+void GLStateCache::invalidate()
+{
+    s_program = UNKNOWN;
+    s_vertexArray = UNKNOWN;
+    s_framebuffer = UNKNOWN;
+    s_buffers.fill(UNKNOWN);
+    s_uniformRanges.fill({ UNKNOWN, 0, 0 });
+    s_storageRanges.fill({ UNKNOWN, 0, 0 });
+    s_textures.fill(UNKNOWN);
+    s_capabilities.fill(UNKNOWN);
+    s_blendSrc = UNKNOWN;
+    s_blendDst = UNKNOWN;
+    s_depthFunc = UNKNOWN;
+    s_viewport.fill(-1);
+}
+
+void GLStateCache::resetStatistics()
+{
+    s_lastIssued = s_issued;
+    s_lastFiltered = s_filtered;
+
+    s_issued = 0;
+    s_filtered = 0;
+}
+
+}
\ No newline at end of file
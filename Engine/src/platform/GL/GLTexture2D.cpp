@@ -1,9 +1,11 @@
 #include <platform/GL/GLTexture2D.h>
+#include <platform/GL/GLStateCache.h>
 #include <core/Logger.h>
 #include <util/Image.h>
 
 #include <GL/glew.h>
 
+#include <algorithm>
 #include <iostream>
 
 namespace Engine
@@ -24,6 +26,14 @@ namespace Utils
             case SizedTextureFormat::RGBA16F: return GL_RGBA16F;
             case SizedTextureFormat::sRGB8: return GL_SRGB8;
             case SizedTextureFormat::sRGBA8: return GL_SRGB8_ALPHA8;
+            case SizedTextureFormat::R8: return GL_R8;
+            case SizedTextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case SizedTextureFormat::sBC1: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+            case SizedTextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case SizedTextureFormat::sBC3: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case SizedTextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+            case SizedTextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case SizedTextureFormat::sBC7: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
         };
         return 0;
     }
@@ -51,6 +61,53 @@ namespace Utils
         return 0;
     }
 
+    uint32_t getSizedTextureFormatSize_(SizedTextureFormat format)
+    {
+        // Three component formats are padded to four by drivers
+        switch (format)
+        {
+            case SizedTextureFormat::RGBA8: return 4;
+            case SizedTextureFormat::RGB8: return 4;
+            case SizedTextureFormat::Depth16: return 2;
+            case SizedTextureFormat::Depth24: return 4;
+            case SizedTextureFormat::Depth24Stencil8: return 4;
+            case SizedTextureFormat::RGB16F: return 8;
+            case SizedTextureFormat::RGBA16F: return 8;
+            case SizedTextureFormat::sRGB8: return 4;
+            case SizedTextureFormat::sRGBA8: return 4;
+            case SizedTextureFormat::R8: return 1;
+        };
+        return 0;
+    }
+
+    // Bytes per 4x4 block, 0 for uncompressed formats
+    uint32_t getCompressedBlockSize_(SizedTextureFormat format)
+    {
+        switch (format)
+        {
+            case SizedTextureFormat::BC1: return 8;
+            case SizedTextureFormat::sBC1: return 8;
+            case SizedTextureFormat::BC3: return 16;
+            case SizedTextureFormat::sBC3: return 16;
+            case SizedTextureFormat::BC5: return 16;
+            case SizedTextureFormat::BC7: return 16;
+            case SizedTextureFormat::sBC7: return 16;
+        };
+        return 0;
+    }
+
+    SizedTextureFormat getCompressedTextureFormat_(CompressedImage::Format format, bool isSRGB)
+    {
+        switch (format)
+        {
+            case CompressedImage::Format::BC1: return isSRGB ? SizedTextureFormat::sBC1 : SizedTextureFormat::BC1;
+            case CompressedImage::Format::BC3: return isSRGB ? SizedTextureFormat::sBC3 : SizedTextureFormat::BC3;
+            case CompressedImage::Format::BC5: return SizedTextureFormat::BC5;
+            case CompressedImage::Format::BC7: return isSRGB ? SizedTextureFormat::sBC7 : SizedTextureFormat::BC7;
+        };
+        return SizedTextureFormat::None;
+    }
+
     uint32_t getDataTypeEnumValue_(DataType type)
     {
         switch (type)
@@ -70,23 +127,27 @@ namespace Utils
 
 GLTexture2D::GLTexture2D(const GLTexture2D& other)
     : m_path(other.m_path), m_clamp(other.m_clamp), m_linear(other.m_linear), m_isSRGB(other.m_isSRGB)
-    , m_id(other.m_id), m_width(other.m_width), m_height(other.m_height), m_internalFormat(other.m_internalFormat)
+    , m_id(other.m_id), m_width(other.m_width), m_height(other.m_height), m_levels(other.m_levels), m_internalFormat(other.m_internalFormat)
     , m_dataFormat(other.m_dataFormat)
 {
 
 }
 
 GLTexture2D::GLTexture2D(const std::string& file, bool clamp, bool linear, bool isSRGB)
-    : m_path(file), m_clamp(clamp), m_linear(linear), m_isSRGB(isSRGB)
+    : GLTexture2D(*Image::create(file, true), clamp, linear, isSRGB)
 {
-    glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
-    glBindTextureUnit(0, m_id);
 
-    auto image = Image::create(file, true);
+}
 
-    if (image->getData())
+GLTexture2D::GLTexture2D(const Image& image, bool clamp, bool linear, bool isSRGB)
+    : m_path(image.getPath()), m_clamp(clamp), m_linear(linear), m_isSRGB(isSRGB)
+{
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
+    GLStateCache::bindTextureUnit(0, m_id);
+
+    if (image.getData())
     {
-        switch (image->getFormat())
+        switch (image.getFormat())
         {
             case Image::Format::RGB:
                 if (isSRGB)
@@ -105,10 +166,10 @@ GLTexture2D::GLTexture2D(const std::string& file, bool clamp, bool linear, bool
                 break;
         };
 
-        m_width = image->getWidth();
-        m_height = image->getHeight();
+        m_width = image.getWidth();
+        m_height = image.getHeight();
 
-        glTextureStorage2D(m_id, 1, Utils::getSizedTextureFormatEnumValue_(m_internalFormat), image->getWidth(), image->getHeight());
+        glTextureStorage2D(m_id, 1, Utils::getSizedTextureFormatEnumValue_(m_internalFormat), image.getWidth(), image.getHeight());
 
         glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, linear ? GL_LINEAR : GL_NEAREST);
         glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST);
@@ -123,7 +184,7 @@ GLTexture2D::GLTexture2D(const std::string& file, bool clamp, bool linear, bool
                      m_height,
                      Utils::getTextureFormatEnumValue_(m_dataFormat),
                      GL_UNSIGNED_BYTE, // TODO: custom type
-                     image->getData());
+                     image.getData());
 
         glGenerateTextureMipmap(m_id);
     }
@@ -132,16 +193,60 @@ GLTexture2D::GLTexture2D(const std::string& file, bool clamp, bool linear, bool
         Logger::getCoreLogger()->error("Image is corrupted or contains unknown formatted data!");
     }
 
-    glBindTextureUnit(0, 0);
+    GLStateCache::bindTextureUnit(0, 0);
+}
+
+GLTexture2D::GLTexture2D(const CompressedImage& image, bool clamp, bool linear)
+    : m_path(image.getPath()), m_clamp(clamp), m_linear(linear), m_isSRGB(image.isSRGB())
+{
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
+    GLStateCache::bindTextureUnit(0, m_id);
+
+    if (image.getData())
+    {
+        m_internalFormat = Utils::getCompressedTextureFormat_(image.getFormat(), image.isSRGB());
+        m_dataFormat = image.getFormat() == CompressedImage::Format::BC1 ? TextureFormat::RGB : TextureFormat::RGBA;
+
+        m_width = image.getWidth();
+        m_height = image.getHeight();
+        m_levels = image.getLevelCount();
+
+        uint32_t format = Utils::getSizedTextureFormatEnumValue_(m_internalFormat);
+
+        glTextureStorage2D(m_id, m_levels, format, m_width, m_height);
+
+        // Compressed textures can't generate their mipmaps, so only the levels of the file are sampled
+        bool mipmapped = m_levels > 1;
+
+        glTextureParameteri(m_id, GL_TEXTURE_MAG_FILTER, linear ? GL_LINEAR : GL_NEAREST);
+        glTextureParameteri(m_id, GL_TEXTURE_MIN_FILTER, mipmapped ? (linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST) : (linear ? GL_LINEAR : GL_NEAREST));
+        glTextureParameteri(m_id, GL_TEXTURE_MAX_LEVEL, m_levels - 1);
+        glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, clamp ? GL_CLAMP_TO_EDGE : GL_REPEAT);
+        glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, clamp ? GL_CLAMP_TO_EDGE : GL_REPEAT);
+
+        for (uint32_t level = 0; level < m_levels; level++)
+        {
+            const CompressedImage::Level& data = image.getLevel(level);
+
+            glCompressedTextureSubImage2D(m_id, level, 0, 0, data.width, data.height, format, static_cast<GLsizei>(data.size), image.getLevelData(level));
+        }
+    }
+    else
+    {
+        Logger::getCoreLogger()->error("Compressed image is corrupted or contains unknown formatted data!");
+    }
+
+    GLStateCache::bindTextureUnit(0, 0);
 }
 
 GLTexture2D::GLTexture2D(uint32_t width, uint32_t height, SizedTextureFormat dataFormat, bool clamp, bool linear)
     : m_internalFormat(dataFormat), m_path(""), m_clamp(clamp), m_linear(linear)
     , m_isSRGB(dataFormat == SizedTextureFormat::sRGB8 || dataFormat == SizedTextureFormat::sRGBA8)
+    , m_width(width), m_height(height)
 {
     glCreateTextures(GL_TEXTURE_2D, 1, &m_id);
 
-    glBindTextureUnit(0, m_id);
+    GLStateCache::bindTextureUnit(0, m_id);
 
     glTextureParameteri(m_id, GL_TEXTURE_WRAP_S, clamp ? GL_CLAMP_TO_EDGE : GL_REPEAT);
     glTextureParameteri(m_id, GL_TEXTURE_WRAP_T, clamp ? GL_CLAMP_TO_EDGE : GL_REPEAT);
@@ -150,29 +255,51 @@ GLTexture2D::GLTexture2D(uint32_t width, uint32_t height, SizedTextureFormat dat
 
     glTextureStorage2D(m_id, 1, Utils::getSizedTextureFormatEnumValue_(dataFormat), width, height);
 
-    glBindTextureUnit(0, 0);
+    GLStateCache::bindTextureUnit(0, 0);
 }
 
 GLTexture2D::~GLTexture2D()
 {
-    glDeleteTextures(1, &m_id);
+    GLStateCache::deleteTextures(1, &m_id);
 }
 
 void GLTexture2D::setData(uint32_t xoffset, uint32_t yoffset, uint32_t width, uint32_t height, const void* data, TextureFormat dataFormat, DataType type)
 {
-    glBindTextureUnit(0, m_id);
+    GLStateCache::bindTextureUnit(0, m_id);
     glTextureSubImage2D(m_id, 0, xoffset, yoffset, width, height, Utils::getTextureFormatEnumValue_(dataFormat), Utils::getDataTypeEnumValue_(type), data);
-    glBindTextureUnit(0, 0);
+    GLStateCache::bindTextureUnit(0, 0);
+}
+
+size_t GLTexture2D::getMemorySize() const
+{
+    uint32_t blockSize = Utils::getCompressedBlockSize_(m_internalFormat);
+
+    if (blockSize > 0)
+    {
+        size_t size = 0;
+
+        for (uint32_t level = 0; level < m_levels; level++)
+        {
+            uint32_t width = std::max(m_width >> level, 1u);
+            uint32_t height = std::max(m_height >> level, 1u);
+
+            size += static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+        }
+
+        return size;
+    }
+
+    return static_cast<size_t>(m_width) * m_height * Utils::getSizedTextureFormatSize_(m_internalFormat);
 }
 
 void GLTexture2D::bind(uint32_t slot) const
 {
-    glBindTextureUnit(slot, m_id);
+    GLStateCache::bindTextureUnit(slot, m_id);
 }
 
 void GLTexture2D::unbind(uint32_t slot) const
 {
-    glBindTextureUnit(slot, 0);
+    GLStateCache::bindTextureUnit(slot, 0);
 }
 
 bool GLTexture2D::operator==(const Texture2D& other)
@@ -1,4 +1,5 @@
 #include <platform/GL/GLTextureCube.h>
+#include <platform/GL/GLStateCache.h>
 #include <util/Image.h>
 #include <platform/GL/GLTexture2D.h>
 
@@ -48,7 +49,7 @@ GLTextureCube::GLTextureCube(const std::string* files, bool clamp, bool linear,
 GLTextureCube::GLTextureCube(uint32_t width, uint32_t height, SizedTextureFormat internalFormat, bool clamp, bool linear, bool mipmap)
 {
     glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_id);
-    glBindTextureUnit(0, m_id);
+    GLStateCache::bindTextureUnit(0, m_id);
 
     glTextureStorage2D(m_id, 5, Utils::getSizedTextureFormatEnumValue_(internalFormat), width, height);
 
@@ -69,26 +70,26 @@ GLTextureCube::GLTextureCube(uint32_t width, uint32_t height, SizedTextureFormat
 
 void GLTextureCube::generateMipmap() const
 {
-    glBindTextureUnit(0, m_id);
+    GLStateCache::bindTextureUnit(0, m_id);
     glGenerateTextureMipmap(m_id);
-    glBindTextureUnit(0, 0);
+    GLStateCache::bindTextureUnit(0, 0);
 }
 
 void GLTextureCube::bind(uint32_t slot) const
 {
-    glBindTextureUnit(slot, m_id);
+    GLStateCache::bindTextureUnit(slot, m_id);
 }
 
 void GLTextureCube::unbind(uint32_t slot) const
 {
-    glBindTextureUnit(slot, 0);
+    GLStateCache::bindTextureUnit(slot, 0);
 }
 
 uint32_t GLTextureCube::loadFromFile(const std::string& filepath)
 {
     uint32_t id = 0;
     glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &id);
-    glBindTextureUnit(0, id);
+    GLStateCache::bindTextureUnit(0, id);
 
     return id;
 }
@@ -97,7 +98,7 @@ uint32_t GLTextureCube::loadFromMultipleFiles(const std::string* files)
 {
     uint32_t id = 0;
     glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &id);
-    glBindTextureUnit(0, id);
+    GLStateCache::bindTextureUnit(0, id);
 
     for (unsigned int i = 0; i < 6; i++)
     {
@@ -1,4 +1,5 @@
 #include <platform/GL/GLVertexArray.h>
+#include <platform/GL/GLStateCache.h>
 #include <core/Logger.h>
 
 namespace Engine
@@ -11,28 +12,42 @@ GLVertexArray::GLVertexArray()
 
 GLVertexArray::~GLVertexArray()
 {
-    glDeleteVertexArrays(1, &m_id);
+    GLStateCache::deleteVertexArray(m_id);
 }
 
 void GLVertexArray::bind() const
 {
-    glBindVertexArray(m_id);
+    GLStateCache::bindVertexArray(m_id);
 }
 
 void GLVertexArray::unbind() const
 {
-    glBindVertexArray(0);
+    GLStateCache::bindVertexArray(0);
 }
 
 void GLVertexArray::addVertexBuffer(const Reference<VertexBuffer>& buffer)
 {
     bind();
     buffer->bind();
+
+    setAttributes_(buffer->getLayout());
+}
+
+void GLVertexArray::addVertexBuffer(const StreamBuffer& buffer, const BufferLayout& layout)
+{
+    bind();
+    buffer.bind();
+
+    setAttributes_(layout);
+}
+
+void GLVertexArray::setAttributes_(const BufferLayout& layout)
+{
     int i = 0;
-    for (m_attribCount ; m_attribCount < buffer->getLayout().size() ; m_attribCount++)
+    for (m_attribCount ; m_attribCount < layout.size() ; m_attribCount++)
     {
         GLenum type;
-        switch (buffer->getLayout()[i].type)
+        switch (layout[i].type)
         {
             using Type = Shader::DataType;
 
@@ -87,14 +102,14 @@ void GLVertexArray::addVertexBuffer(const Reference<VertexBuffer>& buffer)
             default:            Logger::getCoreLogger()->error("Unknown GLSL data type."); type = 0; break;
         }
 
-        bool normalized = buffer->getLayout()[i].normalized ? GL_TRUE : GL_FALSE;
+        bool normalized = layout[i].normalized ? GL_TRUE : GL_FALSE;
 
         glVertexAttribPointer(m_attribCount,
-                              buffer->getLayout()[i].componentCount(),
+                              layout[i].componentCount(),
                               type,
                               normalized,
-                              buffer->getLayout().getStride(),
-                              (const void*)buffer->getLayout()[i].offset);
+                              layout.getStride(),
+                              (const void*)layout[i].offset);
 
         glEnableVertexAttribArray(m_attribCount);
         i++;
@@ -1,8 +1,24 @@
 #include <renderer/Assets.h>
+#include <renderer/Model.h>
+#include <renderer/Mesh.h>
 
 namespace Engine
 {
 
+namespace Utils
+{
+    size_t getIndexSize_(IndexDataType type)
+    {
+        switch (type)
+        {
+            case IndexDataType::UInt8: return 1;
+            case IndexDataType::UInt16: return 2;
+            case IndexDataType::UInt32: return 4;
+        }
+        return 0;
+    }
+}
+
 Assets* Assets::m_instance = new Assets();
 
 Assets::Assets()
@@ -23,6 +39,134 @@ void Assets::flush()
     }
 
     m_instance->m_caches.clear();
+
+    std::lock_guard<std::mutex> lock(m_instance->m_uploadMutex);
+    m_instance->m_uploads.clear();
+}
+
+void Assets::update()
+{
+    size_t uploaded = 0;
+    bool first = true;
+
+    while (true)
+    {
+        AssetUpload upload;
+
+        {
+            std::lock_guard<std::mutex> lock(m_instance->m_uploadMutex);
+
+            if (m_instance->m_uploads.empty())
+            {
+                break;
+            }
+
+            // Always one, so an asset larger than the budget still gets through
+            if (!first && uploaded + m_instance->m_uploads.front().size > m_instance->m_uploadBudget)
+            {
+                break;
+            }
+
+            upload = std::move(m_instance->m_uploads.front());
+            m_instance->m_uploads.pop_front();
+        }
+
+        upload.function();
+
+        uploaded += upload.size;
+        first = false;
+    }
+
+    for (auto& cache : m_instance->m_caches)
+    {
+        cache.second->trim();
+    }
+}
+
+void Assets::queueUpload_(size_t size, const std::function<void()>& function)
+{
+    std::lock_guard<std::mutex> lock(m_instance->m_uploadMutex);
+    m_instance->m_uploads.push_back({ size, function });
+}
+
+AssetMemory AssetTraits<Texture2D>::getMemory(const Texture2D& asset)
+{
+    AssetMemory memory;
+    memory.gpu = asset.getMemorySize();
+
+    return memory;
+}
+
+std::function<Reference<Texture2D>()> AssetTraits<Texture2D>::getReloader(const Reference<Texture2D>& asset)
+{
+    // Textures created in code have no file to come back from
+    if (asset->getPath().empty())
+    {
+        return nullptr;
+    }
+
+    return [path = asset->getPath(), clamp = asset->isClamped(), linear = asset->isLinear(), isSRGB = asset->isSRGB(),
+            name = asset->name, uuid = asset->uuid]()
+    {
+        auto texture = Texture2D::create(path, clamp, linear, isSRGB);
+        texture->name = name;
+        texture->uuid = uuid;
+
+        return texture;
+    };
+}
+
+AssetMemory AssetTraits<Mesh>::getMemory(const Mesh& asset)
+{
+    AssetMemory memory;
+
+    if (asset.vertexBuffer)
+    {
+        memory.gpu += asset.vertexBuffer->getSize();
+    }
+
+    if (asset.indexBuffer)
+    {
+        memory.gpu += asset.indexBuffer->getCount() * Utils::getIndexSize_(asset.indexBuffer->getDataType());
+    }
+
+    return memory;
+}
+
+std::function<Reference<Mesh>()> AssetTraits<Mesh>::getReloader(const Reference<Mesh>& asset)
+{
+    if (asset->path.empty())
+    {
+        return nullptr;
+    }
+
+    // Cheap to come back from, the mesh is mapped from its cooked file
+    return [path = asset->path, id = asset->id, material = asset->material]()
+    {
+        auto mesh = Mesh::load(path, id);
+
+        if (mesh)
+        {
+            mesh->material = material;
+        }
+
+        return mesh;
+    };
+}
+
+AssetMemory AssetTraits<Model>::getMemory(const Model& asset)
+{
+    AssetMemory memory;
+
+    for (auto& mesh : asset.meshes)
+    {
+        if (mesh)
+        {
+            memory.gpu += AssetTraits<Mesh>::getMemory(*mesh).gpu;
+        }
+    }
+
+    return memory;
 }
 
 }
\ No newline at end of file
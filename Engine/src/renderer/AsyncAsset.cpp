@@ -0,0 +1,151 @@
+#include <renderer/AsyncAsset.h>
+#include <renderer/ModelLoader.h>
+#include <renderer/MeshCache.h>
+#include <renderer/Mesh.h>
+#include <util/Image.h>
+#include <util/CompressedImage.h>
+
+namespace Engine
+{
+
+DecodedTexture AsyncAssetLoader<Texture2D>::decode(const std::string& path)
+{
+    DecodedTexture decoded;
+
+    if (CompressedImage::isCompressedFile(path))
+    {
+        decoded.compressed = CompressedImage::create(path, true);
+    }
+    else
+    {
+        decoded.image = Image::create(path, true);
+    }
+
+    return decoded;
+}
+
+size_t AsyncAssetLoader<Texture2D>::getUploadSize(const DecodedTexture& decoded)
+{
+    if (decoded.compressed)
+    {
+        return decoded.compressed->getSize();
+    }
+
+    return static_cast<size_t>(decoded.image->getWidth()) * decoded.image->getHeight() * decoded.image->getChannels();
+}
+
+Reference<Texture2D> AsyncAssetLoader<Texture2D>::upload(const DecodedTexture& decoded, const std::string& path)
+{
+    if (decoded.compressed)
+    {
+        if (!decoded.compressed->getData())
+        {
+            return nullptr;
+        }
+
+        return Texture2D::create(*decoded.compressed);
+    }
+
+    if (!decoded.image->getData())
+    {
+        return nullptr;
+    }
+
+    return Texture2D::create(*decoded.image);
+}
+
+Reference<Texture2D> AsyncAssetLoader<Texture2D>::getPlaceholder()
+{
+    return Texture2D::createWhiteTexture();
+}
+
+Reference<MeshCache> AsyncAssetLoader<Mesh>::decode(const std::string& path)
+{
+    return ModelLoader::loadMeshCache(path);
+}
+
+size_t AsyncAssetLoader<Mesh>::getUploadSize(const Reference<MeshCache>& decoded)
+{
+    if (!decoded || decoded->getSubmeshCount() == 0)
+    {
+        return 0;
+    }
+
+    const MeshCacheSubmesh& submesh = decoded->getSubmesh(0);
+
+    return submesh.vertexCount * sizeof(ModelVertex) + submesh.indexCount * sizeof(uint32_t);
+}
+
+Reference<Mesh> AsyncAssetLoader<Mesh>::upload(const Reference<MeshCache>& decoded, const std::string& path)
+{
+    if (!decoded)
+    {
+        return nullptr;
+    }
+
+    return ModelLoader::createMesh(*decoded, 0, path, true);
+}
+
+Reference<Mesh> AsyncAssetLoader<Mesh>::getPlaceholder()
+{
+    return nullptr;
+}
+
+AudioData AsyncAssetLoader<AudioBuffer>::decode(const std::string& path)
+{
+    AudioData data;
+
+    if (!AudioBuffer::decode(path, data))
+    {
+        data.samples.clear();
+    }
+
+    return data;
+}
+
+size_t AsyncAssetLoader<AudioBuffer>::getUploadSize(const AudioData& decoded)
+{
+    return decoded.samples.size() * sizeof(int16_t);
+}
+
+Reference<AudioBuffer> AsyncAssetLoader<AudioBuffer>::upload(const AudioData& decoded, const std::string& path)
+{
+    if (decoded.samples.empty())
+    {
+        return nullptr;
+    }
+
+    return Reference<AudioBuffer>(new AudioBuffer(decoded));
+}
+
+Reference<AudioBuffer> AsyncAssetLoader<AudioBuffer>::getPlaceholder()
+{
+    return nullptr;
+}
+
+Reference<Image> AsyncAssetLoader<Image>::decode(const std::string& path)
+{
+    return Image::create(path);
+}
+
+size_t AsyncAssetLoader<Image>::getUploadSize(const Reference<Image>& decoded)
+{
+    return 0;
+}
+
+Reference<Image> AsyncAssetLoader<Image>::upload(const Reference<Image>& decoded, const std::string& path)
+{
+    if (!decoded->getData())
+    {
+        return nullptr;
+    }
+
+    return decoded;
+}
+
+Reference<Image> AsyncAssetLoader<Image>::getPlaceholder()
+{
+    return nullptr;
+}
+
+}
\ No newline at end of file
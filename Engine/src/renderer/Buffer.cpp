@@ -9,6 +9,11 @@ Reference<VertexBuffer> VertexBuffer::create(size_t size)
     return createReference<GLVertexBuffer>(size);
 }
 
+Reference<VertexBuffer> VertexBuffer::create(const void* data, size_t size)
+{
+    return createReference<GLVertexBuffer>(data, size);
+}
+
 Reference<IndexBuffer> IndexBuffer::create(uint32_t count, IndexDataType type)
 {
     return createReference<GLIndexBuffer>(count, type);
@@ -24,4 +29,19 @@ Reference<UniformBuffer> UniformBuffer::create(size_t size, uint32_t bindingPoin
     return createReference<GLUniformBuffer>(size, bindingPoint);
 }
 
+Reference<ShaderStorageBuffer> ShaderStorageBuffer::create(size_t size, uint32_t bindingPoint)
+{
+    return createReference<GLShaderStorageBuffer>(size, bindingPoint);
+}
+
+Reference<IndirectBuffer> IndirectBuffer::create(uint32_t capacity)
+{
+    return createReference<GLIndirectBuffer>(capacity);
+}
+
+Reference<StreamBuffer> StreamBuffer::create(size_t regionSize)
+{
+    return createReference<GLStreamBuffer>(regionSize);
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include <renderer/Frustum.h>
+
+namespace Engine
+{
+
+void SphereBatch::clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+}
+
+void SphereBatch::push(const BoundingSphere& sphere)
+{
+    x.push_back(sphere.center.x);
+    y.push_back(sphere.center.y);
+    z.push_back(sphere.center.z);
+    radius.push_back(sphere.radius);
+}
+
+Frustum Frustum::fromMatrix(const math::mat4& m)
+{
+    // Gribb/Hartmann: each plane is the last row of the matrix plus or minus one of the others
+    const auto& c0 = m[0];
+    const auto& c1 = m[1];
+    const auto& c2 = m[2];
+    const auto& c3 = m[3];
+
+    float rows[4][4] = {
+        { c0.x, c1.x, c2.x, c3.x },
+        { c0.y, c1.y, c2.y, c3.y },
+        { c0.z, c1.z, c2.z, c3.z },
+        { c0.w, c1.w, c2.w, c3.w }
+    };
+
+    Frustum frustum;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        const float* row = rows[i / 2];
+        float sign = (i % 2 == 0) ? 1.f : -1.f; // left, right, bottom, top, near, far
+
+        float a = rows[3][0] + sign * row[0];
+        float b = rows[3][1] + sign * row[1];
+        float c = rows[3][2] + sign * row[2];
+        float d = rows[3][3] + sign * row[3];
+
+        float length = std::sqrt(a * a + b * b + c * c);
+        float inverse = length > 0.f ? 1.f / length : 0.f;
+
+        frustum.m_planes[i].normal = math::vec3(a * inverse, b * inverse, c * inverse);
+        frustum.m_planes[i].distance = d * inverse;
+    }
+
+    return frustum;
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const
+{
+    if (!sphere.isValid())
+    {
+        return true;
+    }
+
+    for (auto& plane : m_planes)
+    {
+        float distance = plane.normal.x * sphere.center.x + plane.normal.y * sphere.center.y + plane.normal.z * sphere.center.z + plane.distance;
+
+        if (distance < -sphere.radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Frustum::intersects(const AABB& box) const
+{
+    if (!box.isValid())
+    {
+        return true;
+    }
+
+    for (auto& plane : m_planes)
+    {
+        // Corner furthest along the plane normal
+        float px = plane.normal.x >= 0.f ? box.max.x : box.min.x;
+        float py = plane.normal.y >= 0.f ? box.max.y : box.min.y;
+        float pz = plane.normal.z >= 0.f ? box.max.z : box.min.z;
+
+        if (plane.normal.x * px + plane.normal.y * py + plane.normal.z * pz + plane.distance < 0.f)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t Frustum::cull(const SphereBatch& spheres, std::vector<uint8_t>& visible) const
+{
+    uint32_t count = spheres.size();
+    visible.assign(count, 1);
+
+    const float* x = spheres.x.data();
+    const float* y = spheres.y.data();
+    const float* z = spheres.z.data();
+    const float* r = spheres.radius.data();
+    uint8_t* out = visible.data();
+
+    // Branch-free over the spheres so the compiler can vectorise the inner loop
+    for (auto& plane : m_planes)
+    {
+        float nx = plane.normal.x, ny = plane.normal.y, nz = plane.normal.z, d = plane.distance;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            float distance = nx * x[i] + ny * y[i] + nz * z[i] + d;
+            out[i] &= static_cast<uint8_t>((distance >= -r[i]) | (r[i] < 0.f));
+        }
+    }
+
+    uint32_t visibleCount = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        visibleCount += out[i];
+    }
+
+    return visibleCount;
+}
+
+}
\ No newline at end of file
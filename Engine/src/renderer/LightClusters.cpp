@@ -0,0 +1,239 @@
+#include <renderer/LightClusters.h>
+#include <renderer/Lighting.h>
+#include <renderer/Bounds.h>
+#include <core/JobSystem.h>
+
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <algorithm>
+
+namespace Engine
+{
+
+static constexpr float MIN_NEAR = 0.01f;
+
+void LightClusters::build(const math::mat4& projection)
+{
+    if (!m_minX.empty() && std::memcmp(math::buffer(projection), math::buffer(m_projection), sizeof(math::mat4)) == 0)
+    {
+        return;
+    }
+
+    m_projection = projection;
+
+    // Recover the clip planes, perspective projections have -1 in the w row
+    bool perspective = projection[2].w != 0.f;
+    float p22 = projection[2].z, p32 = projection[3].z;
+
+    float zNear = perspective ? p32 / (p22 - 1.f) : (p32 + 1.f) / p22;
+    float zFar = perspective ? p32 / (p22 + 1.f) : (p32 - 1.f) / p22;
+
+    zNear = std::max(zNear, MIN_NEAR);
+    zFar = std::max(zFar, zNear * 2.f);
+
+    float logRatio = std::log(zFar / zNear);
+
+    m_header.gridX = GRID_X;
+    m_header.gridY = GRID_Y;
+    m_header.gridZ = GRID_Z;
+    m_header.zNear = zNear;
+    m_header.zFar = zFar;
+    m_header.sliceScale = GRID_Z / logRatio;
+    m_header.sliceBias = -(GRID_Z * std::log(zNear)) / logRatio;
+
+    // Tile corners on the near plane, in view space
+    math::mat4 inverse = math::inverse<float>(projection);
+    std::vector<math::vec3> corners((GRID_X + 1) * (GRID_Y + 1));
+
+    for (uint32_t y = 0; y <= GRID_Y; y++)
+    {
+        for (uint32_t x = 0; x <= GRID_X; x++)
+        {
+            math::vec4 ndc(-1.f + 2.f * x / GRID_X, -1.f + 2.f * y / GRID_Y, -1.f, 1.f);
+            math::vec4 corner = inverse * ndc;
+
+            corners[x + y * (GRID_X + 1)] = math::vec3(corner) / corner.w;
+        }
+    }
+
+    auto pointAt = [perspective](const math::vec3& corner, float depth)
+    {
+        return perspective ? corner * (depth / -corner.z) : math::vec3(corner.x, corner.y, -depth);
+    };
+
+    m_minX.resize(CLUSTER_COUNT); m_minY.resize(CLUSTER_COUNT); m_minZ.resize(CLUSTER_COUNT);
+    m_maxX.resize(CLUSTER_COUNT); m_maxY.resize(CLUSTER_COUNT); m_maxZ.resize(CLUSTER_COUNT);
+
+    for (uint32_t z = 0; z < GRID_Z; z++)
+    {
+        float sliceNear = zNear * std::pow(zFar / zNear, static_cast<float>(z) / GRID_Z);
+        float sliceFar = zNear * std::pow(zFar / zNear, static_cast<float>(z + 1) / GRID_Z);
+
+        for (uint32_t y = 0; y < GRID_Y; y++)
+        {
+            for (uint32_t x = 0; x < GRID_X; x++)
+            {
+                AABB box;
+
+                for (uint32_t corner = 0; corner < 4; corner++)
+                {
+                    const math::vec3& point = corners[(x + (corner & 1)) + (y + (corner >> 1)) * (GRID_X + 1)];
+
+                    box.expand(pointAt(point, sliceNear));
+                    box.expand(pointAt(point, sliceFar));
+                }
+
+                uint32_t index = x + y * GRID_X + z * TILE_COUNT;
+
+                m_minX[index] = box.min.x; m_minY[index] = box.min.y; m_minZ[index] = box.min.z;
+                m_maxX[index] = box.max.x; m_maxY[index] = box.max.y; m_maxZ[index] = box.max.z;
+            }
+        }
+    }
+}
+
+uint32_t LightClusters::getTile_(float ndc, uint32_t count)
+{
+    float tile = std::floor((ndc * 0.5f + 0.5f) * count);
+
+    return std::min(static_cast<uint32_t>(std::max(tile, 0.f)), count - 1);
+}
+
+uint32_t LightClusters::getSlice(float depth) const
+{
+    if (depth <= m_header.zNear)
+    {
+        return 0;
+    }
+
+    float slice = std::floor(std::log(depth) * m_header.sliceScale + m_header.sliceBias);
+
+    return std::min(static_cast<uint32_t>(std::max(slice, 0.f)), GRID_Z - 1);
+}
+
+void LightClusters::assign(const std::vector<PointLightData>& lights, const math::mat4& view)
+{
+    m_lights.clear();
+
+    for (uint32_t i = 0; i < lights.size(); i++)
+    {
+        math::vec4 position = view * math::vec4(lights[i].position, 1.f);
+        float radius = lights[i].radius;
+
+        float minDepth = -position.z - radius;
+        float maxDepth = -position.z + radius;
+
+        if (maxDepth < m_header.zNear || minDepth > m_header.zFar)
+        {
+            continue;
+        }
+
+        ViewLight light = { position.x, position.y, position.z, radius, i, getSlice(minDepth), getSlice(maxDepth), 0, GRID_X - 1, 0, GRID_Y - 1 };
+
+        // Screen bounds from the corners of the light's box, unless it reaches behind the near plane
+        if (minDepth > m_header.zNear)
+        {
+            float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+            for (uint32_t corner = 0; corner < 8; corner++)
+            {
+                math::vec4 point(position.x + ((corner & 1) ? radius : -radius),
+                                 position.y + ((corner & 2) ? radius : -radius),
+                                 position.z + ((corner & 4) ? radius : -radius), 1.f);
+
+                math::vec4 clip = m_projection * point;
+
+                minX = std::min(minX, clip.x / clip.w); maxX = std::max(maxX, clip.x / clip.w);
+                minY = std::min(minY, clip.y / clip.w); maxY = std::max(maxY, clip.y / clip.w);
+            }
+
+            if (maxX < -1.f || minX > 1.f || maxY < -1.f || minY > 1.f)
+            {
+                continue;
+            }
+
+            light.firstX = getTile_(minX, GRID_X);
+            light.lastX = getTile_(maxX, GRID_X);
+            light.firstY = getTile_(minY, GRID_Y);
+            light.lastY = getTile_(maxY, GRID_Y);
+        }
+
+        m_lights.push_back(light);
+    }
+
+    m_clusterLights.resize(CLUSTER_COUNT);
+
+    // Every slice only writes its own clusters
+    JobSystem::getInstance()->parallelFor(GRID_Z, 1, [this](uint32_t slice)
+    {
+        assignSlice_(slice);
+    });
+
+    m_ranges.resize(CLUSTER_COUNT);
+    m_lightIndices.clear();
+
+    for (uint32_t i = 0; i < CLUSTER_COUNT; i++)
+    {
+        const auto& clusterLights = m_clusterLights[i];
+
+        m_ranges[i] = { static_cast<uint32_t>(m_lightIndices.size()), static_cast<uint32_t>(clusterLights.size()) };
+        m_lightIndices.insert(m_lightIndices.end(), clusterLights.begin(), clusterLights.end());
+    }
+}
+
+void LightClusters::assignSlice_(uint32_t slice)
+{
+    uint32_t base = slice * TILE_COUNT;
+
+    const float* minX = m_minX.data() + base;
+    const float* minY = m_minY.data() + base;
+    const float* minZ = m_minZ.data() + base;
+    const float* maxX = m_maxX.data() + base;
+    const float* maxY = m_maxY.data() + base;
+    const float* maxZ = m_maxZ.data() + base;
+
+    for (uint32_t i = 0; i < TILE_COUNT; i++)
+    {
+        m_clusterLights[base + i].clear();
+    }
+
+    uint8_t hits[TILE_COUNT];
+
+    for (const ViewLight& light : m_lights)
+    {
+        if (slice < light.firstSlice || slice > light.lastSlice)
+        {
+            continue;
+        }
+
+        float x = light.x, y = light.y, z = light.z;
+        float radiusSquared = light.radius * light.radius;
+
+        for (uint32_t row = light.firstY; row <= light.lastY; row++)
+        {
+            uint32_t first = row * GRID_X + light.firstX;
+            uint32_t last = row * GRID_X + light.lastX;
+
+            // Sphere against the boxes of the row, branch-free so the compiler can vectorise it
+            for (uint32_t i = first; i <= last; i++)
+            {
+                float dx = std::max(std::max(minX[i] - x, x - maxX[i]), 0.f);
+                float dy = std::max(std::max(minY[i] - y, y - maxY[i]), 0.f);
+                float dz = std::max(std::max(minZ[i] - z, z - maxZ[i]), 0.f);
+
+                hits[i] = static_cast<uint8_t>(dx * dx + dy * dy + dz * dz <= radiusSquared);
+            }
+
+            for (uint32_t i = first; i <= last; i++)
+            {
+                if (hits[i])
+                {
+                    m_clusterLights[base + i].push_back(light.index);
+                }
+            }
+        }
+    }
+}
+
+}
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <util/Transform.h>
 #include <scene/GameObject.h>
 
+#include <cmath>
+#include <algorithm>
+
 namespace Engine
 {
 
@@ -18,29 +21,62 @@ DirectionalLight::DirectionalLight(const math::vec3& radiance, float intensity,
     setShadowInfo(new ShadowInfo(math::ortho(-40.f, 40.f, -40.f, 40.f, -40.f, 40.f)));
 }
 
-void DirectionalLight::setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const
+void DirectionalLight::pack(LightBlock& block) const
 {
-    math::quat rotation = math::quat(math::radians(m_owner->getComponent<Transform>()->getRotation()));
-    auto direction = rotation * math::vec3(0, -1, 0);
+    if (block.header.numDirectionalLights == LightBlockHeader::MAX_DIRECTIONAL_LIGHTS)
+    {
+        return;
+    }
+
+    auto& data = block.header.directionalLights[block.header.numDirectionalLights++];
+
+    if (GameObject* owner = getOwner())
+    {
+        math::quat rotation = math::quat(math::radians(owner->getComponent<Transform>()->getWorldRotation()));
+        data.direction = rotation * math::vec3(0, -1, 0);
+    }
+    else
+    {
+        data.direction = direction;
+    }
 
-    shader->setFloat3("uDirectionalLight.radiance", radiance);
-    shader->setFloat("uDirectionalLight.intensity", intensity);
-    shader->setFloat3("uDirectionalLight.direction", direction);
+    data.radiance = radiance;
+    data.intensity = intensity;
 }
 
-void PointLight::setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const
+void PointLight::pack(LightBlock& block) const
 {
-    std::string idx = std::to_string(index);
+    // A point light is placed by its game object, without one it has no position
+    GameObject* owner = getOwner();
+
+    if (!owner)
+    {
+        return;
+    }
+
+    PointLightData data;
+    data.position = owner->getComponent<Transform>()->getWorldTranslation();
+    data.radiance = radiance;
+    data.intensity = intensity;
 
-    shader->setFloat3("uPointLights[" + idx + "].radiance", radiance);
-    shader->setFloat("uPointLights[" + idx + "].intensity", intensity);
-    shader->setFloat3("uPointLights[" + idx + "].position", m_owner->getComponent<Transform>()->getTranslation());
+    // Inverse square falloff reaches the cutoff at sqrt(power / cutoff)
+    float power = std::max(std::max(radiance.x, radiance.y), radiance.z) * intensity;
+    data.radius = std::sqrt(std::max(power, 0.f) / ATTENUATION_CUTOFF);
+
+    block.pointLights.push_back(data);
+    block.header.numPointLights = static_cast<int32_t>(block.pointLights.size());
+}
+
+void SkyLight::pack(LightBlock& block) const
+{
+    block.header.skyLight.radiance = radiance;
+    block.header.skyLight.intensity = intensity;
 }
 
-void SkyLight::setShaderUniforms(const Reference<Shader>& shader, uint32_t index) const
+void LightBlock::clear()
 {
-    shader->setFloat3("uSkyLight.radiance", radiance);
-    shader->setFloat("uSkyLight.intensity", intensity);
+    header = LightBlockHeader();
+    pointLights.clear();
 }
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <renderer/Renderer3D.h>
 #include <util/io/Deserializer.h>
 
+#include <cstring>
+
 namespace Engine
 {
 
@@ -18,33 +20,18 @@ void Material::bind() const
 
     if (albedoMap)
         albedoMap->bind(0);
-        
-    shader->setFloat3("uMaterial.albedoColor", albedoColor);
-    shader->setFloat("uMaterial.albedoMapToggle", (float)(albedoMap != nullptr));
 
     if (normalMap)
         normalMap->bind(1);
-    
-    shader->setFloat("uMaterial.normalMapToggle", (float)(normalMap != nullptr));
 
     if (metallicMap)
         metallicMap->bind(2);
-    
-    shader->setFloat("uMaterial.metallicMapToggle", (float)(metallicMap != nullptr));
-    shader->setFloat("uMaterial.metallic", metallicScalar);
-    
 
     if (roughnessMap)
         roughnessMap->bind(3);
-    
-    shader->setFloat("uMaterial.roughnessMapToggle", (float)(roughnessMap != nullptr));
-    shader->setFloat("uMaterial.roughness", roughnessScalar);
-    
 
     if (ambientOcclusionMap)
         ambientOcclusionMap->bind(4);
-
-    shader->setFloat("uMaterial.lightmapToggle", (float)(ambientOcclusionMap != nullptr));
     /*
     if (depthMap)
         depthMap->bind(5);*/
@@ -52,7 +39,36 @@ void Material::bind() const
     if (emissionMap)
         emissionMap->bind(6);
 
-    shader->setFloat("uMaterial.emissionMapToggle", (float)(emissionMap != nullptr));
+    updateUniformBuffer_();
+    m_uniformBuffer->bindRange();
+}
+
+void Material::updateUniformBuffer_() const
+{
+    MaterialBlock block;
+    block.metallic = metallicScalar;
+    block.roughness = roughnessScalar;
+    block.albedoMapToggle = (float)(albedoMap != nullptr);
+    block.normalMapToggle = (float)(normalMap != nullptr);
+    block.metallicMapToggle = (float)(metallicMap != nullptr);
+    block.roughnessMapToggle = (float)(roughnessMap != nullptr);
+    block.lightmapToggle = (float)(ambientOcclusionMap != nullptr);
+    block.emissionMapToggle = (float)(emissionMap != nullptr);
+    block.albedoColor = albedoColor;
+    block.normalMapTwoChannel = (float)(normalMap && normalMap->getFormat() == SizedTextureFormat::BC5);
+    block.padding[0] = block.padding[1] = block.padding[2] = 0.f;
+
+    if (!m_uniformBuffer)
+    {
+        m_uniformBuffer = UniformBuffer::create(sizeof(MaterialBlock), MaterialBlock::BINDING_POINT);
+    }
+    else if (std::memcmp(&block, &m_block, sizeof(MaterialBlock)) == 0)
+    {
+        return;
+    }
+
+    m_block = block;
+    m_uniformBuffer->setData(&m_block, sizeof(MaterialBlock));
 }
 
 void Material::unbind() const
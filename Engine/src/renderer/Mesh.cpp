@@ -64,6 +64,8 @@ void Mesh::setVertices(const std::vector<math::vec3>& positions, const std::vect
 
     }
 
+    AABB::fromVertices(vertices, bounds, boundingSphere);
+
     vertexBuffer->setData(&vertices[0], vertices.size() * sizeof(ModelVertex));
     indexBuffer->setData(&indices[0], indices.size());
 }
@@ -0,0 +1,290 @@
+#include <renderer/MeshCache.h>
+#include <core/Logger.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <random>
+
+namespace Engine
+{
+
+namespace Utils
+{
+    static constexpr char MESH_CACHE_MAGIC[4] = { 'E', 'M', 'S', 'H' };
+
+    size_t alignCacheOffset_(size_t offset)
+    {
+        return (offset + 15) & ~static_cast<size_t>(15);
+    }
+
+    bool getSourceStamp_(const std::string& path, uint64_t& size, int64_t& time)
+    {
+        std::error_code error;
+
+        size = std::filesystem::file_size(path, error);
+        if (error)
+        {
+            return false;
+        }
+
+        time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+        return !error;
+    }
+
+    // Unique per cook, so loaders cooking the same model at once (loading jobs, the editor and the game) don't write
+    // into each other's file. Each renames a complete file over the cooked one.
+    std::string getTemporaryPath_(const std::string& cookedPath)
+    {
+        static std::atomic<uint32_t> cookCount = 0;
+        static const uint32_t processId = std::random_device()();
+
+        return cookedPath + "." + std::to_string(processId) + "." + std::to_string(cookCount.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+    }
+}
+
+std::string MeshCache::getCookedPath(const std::string& sourcePath)
+{
+    return sourcePath + ".mesh";
+}
+
+Reference<MeshCache> MeshCache::open(const std::string& sourcePath)
+{
+    std::string cookedPath = getCookedPath(sourcePath);
+
+    auto cache = createReference<MeshCache>();
+
+    if (!cache->m_file.open(cookedPath))
+    {
+        return nullptr;
+    }
+
+    cache->m_data = cache->m_file.getData();
+    cache->m_size = cache->m_file.getSize();
+
+    if (!cache->validate_())
+    {
+        Logger::getCoreLogger()->warn("Ignoring invalid cooked mesh file: %s", cookedPath.c_str());
+        return nullptr;
+    }
+
+    uint64_t sourceSize;
+    int64_t sourceTime;
+
+    if (Utils::getSourceStamp_(sourcePath, sourceSize, sourceTime))
+    {
+        const MeshCacheHeader& header = cache->getHeader_();
+
+        if (header.sourceSize != sourceSize || header.sourceTime != sourceTime)
+        {
+            return nullptr;
+        }
+    }
+
+    return cache;
+}
+
+Reference<MeshCache> MeshCache::cook(const std::string& sourcePath, const std::vector<CookedSubmesh>& submeshes, const std::vector<uint32_t>& modelMeshes)
+{
+    MeshCacheHeader header;
+    std::memset(&header, 0, sizeof(MeshCacheHeader));
+    std::memcpy(header.magic, Utils::MESH_CACHE_MAGIC, sizeof(header.magic));
+
+    header.version = VERSION;
+    header.vertexStride = sizeof(ModelVertex);
+    header.submeshCount = static_cast<uint32_t>(submeshes.size());
+    header.modelMeshCount = static_cast<uint32_t>(modelMeshes.size());
+
+    Utils::getSourceStamp_(sourcePath, header.sourceSize, header.sourceTime);
+
+    std::vector<MeshCacheSubmesh> table(submeshes.size());
+    std::string strings;
+
+    for (size_t i = 0; i < submeshes.size(); i++)
+    {
+        const CookedSubmesh& submesh = submeshes[i];
+        MeshCacheSubmesh& entry = table[i];
+
+        // Zeroed so padding doesn't make identical cooks differ
+        std::memset(static_cast<void*>(&entry), 0, sizeof(MeshCacheSubmesh));
+
+        entry.vertexCount = static_cast<uint32_t>(submesh.vertices.size());
+        entry.indexCount = static_cast<uint32_t>(submesh.indices.size());
+        entry.hasMaterial = submesh.hasMaterial ? 1 : 0;
+
+        AABB::fromVertices(submesh.vertices, entry.bounds, entry.boundingSphere);
+
+        for (size_t texture = 0; texture < submesh.textures.size(); texture++)
+        {
+            if (submesh.textures[texture].empty())
+            {
+                entry.textures[texture] = NO_TEXTURE;
+                continue;
+            }
+
+            entry.textures[texture] = static_cast<uint32_t>(strings.size());
+            strings += submesh.textures[texture];
+            strings += '\0';
+        }
+    }
+
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+
+    size_t offset = sizeof(MeshCacheHeader) + sizeof(MeshCacheSubmesh) * table.size() + sizeof(uint32_t) * modelMeshes.size() + strings.size();
+
+    for (size_t i = 0; i < submeshes.size(); i++)
+    {
+        offset = Utils::alignCacheOffset_(offset);
+        table[i].vertexOffset = offset;
+        offset += sizeof(ModelVertex) * submeshes[i].vertices.size();
+
+        offset = Utils::alignCacheOffset_(offset);
+        table[i].indexOffset = offset;
+        offset += sizeof(uint32_t) * submeshes[i].indices.size();
+    }
+
+    auto cache = createReference<MeshCache>();
+    std::vector<uint8_t>& data = cache->m_memory;
+    data.assign(offset, 0);
+
+    uint8_t* write = data.data();
+    std::memcpy(write, &header, sizeof(MeshCacheHeader));
+    write += sizeof(MeshCacheHeader);
+
+    std::memcpy(write, table.data(), sizeof(MeshCacheSubmesh) * table.size());
+    write += sizeof(MeshCacheSubmesh) * table.size();
+
+    std::memcpy(write, modelMeshes.data(), sizeof(uint32_t) * modelMeshes.size());
+    write += sizeof(uint32_t) * modelMeshes.size();
+
+    std::memcpy(write, strings.data(), strings.size());
+
+    for (size_t i = 0; i < submeshes.size(); i++)
+    {
+        std::memcpy(data.data() + table[i].vertexOffset, submeshes[i].vertices.data(), sizeof(ModelVertex) * submeshes[i].vertices.size());
+        std::memcpy(data.data() + table[i].indexOffset, submeshes[i].indices.data(), sizeof(uint32_t) * submeshes[i].indices.size());
+    }
+
+    cache->m_data = data.data();
+    cache->m_size = data.size();
+
+    // Written under a temporary name, so a failed write never leaves a truncated cooked file behind
+    std::string cookedPath = getCookedPath(sourcePath);
+    std::string temporaryPath = Utils::getTemporaryPath_(cookedPath);
+
+    std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    file.close();
+
+    std::error_code error;
+
+    if (!file)
+    {
+        Logger::getCoreLogger()->warn("Could not write cooked mesh file: %s", cookedPath.c_str());
+        std::filesystem::remove(temporaryPath, error);
+        return cache;
+    }
+
+    std::filesystem::rename(temporaryPath, cookedPath, error);
+
+    if (!error && cache->m_file.open(cookedPath) && cache->m_file.getSize() == data.size())
+    {
+        cache->m_data = cache->m_file.getData();
+        cache->m_size = cache->m_file.getSize();
+
+        std::vector<uint8_t>().swap(cache->m_memory);
+    }
+    else
+    {
+        cache->m_file.close();
+    }
+
+    return cache;
+}
+
+std::string MeshCache::getTexture(const MeshCacheSubmesh& submesh, MeshTexture texture) const
+{
+    uint32_t offset = submesh.textures[static_cast<uint32_t>(texture)];
+
+    if (offset == NO_TEXTURE)
+    {
+        return "";
+    }
+
+    return std::string(getStrings_() + offset);
+}
+
+bool MeshCache::validate_() const
+{
+    if (m_size < sizeof(MeshCacheHeader))
+    {
+        return false;
+    }
+
+    const MeshCacheHeader& header = getHeader_();
+
+    if (std::memcmp(header.magic, Utils::MESH_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != VERSION || header.vertexStride != sizeof(ModelVertex))
+    {
+        return false;
+    }
+
+    uint64_t tablesSize = sizeof(MeshCacheHeader) + static_cast<uint64_t>(sizeof(MeshCacheSubmesh)) * header.submeshCount +
+                          static_cast<uint64_t>(sizeof(uint32_t)) * header.modelMeshCount + header.stringsSize;
+
+    if (tablesSize > m_size)
+    {
+        return false;
+    }
+
+    if (header.stringsSize > 0 && getStrings_()[header.stringsSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.submeshCount; i++)
+    {
+        const MeshCacheSubmesh& submesh = getSubmeshes_()[i];
+
+        uint64_t vertexSize = static_cast<uint64_t>(sizeof(ModelVertex)) * submesh.vertexCount;
+        uint64_t indexSize = static_cast<uint64_t>(sizeof(uint32_t)) * submesh.indexCount;
+
+        if (submesh.vertexOffset % 4 != 0 || submesh.vertexOffset > m_size || vertexSize > m_size - submesh.vertexOffset ||
+            submesh.indexOffset % 4 != 0 || submesh.indexOffset > m_size || indexSize > m_size - submesh.indexOffset)
+        {
+            return false;
+        }
+
+        for (uint32_t texture : submesh.textures)
+        {
+            if (texture != NO_TEXTURE && texture >= header.stringsSize)
+            {
+                return false;
+            }
+        }
+
+        // The indices are uploaded as they are, one out of range would read past the vertex buffer on the GPU
+        const uint32_t* indices = getIndices(submesh);
+
+        for (uint32_t index = 0; index < submesh.indexCount; index++)
+        {
+            if (indices[index] >= submesh.vertexCount)
+            {
+                return false;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < header.modelMeshCount; i++)
+    {
+        if (getModelMeshes_()[i] >= header.submeshCount)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
\ No newline at end of file
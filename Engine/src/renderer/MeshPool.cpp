@@ -0,0 +1,259 @@
+#include <renderer/MeshPool.h>
+#include <renderer/Mesh.h>
+#include <renderer/Model.h>
+
+#include <algorithm>
+
+namespace Engine
+{
+
+static BufferLayout modelLayout()
+{
+    return {
+        { Shader::DataType::Float3, "aPos"      },
+        { Shader::DataType::Float3, "aNormal"   },
+        { Shader::DataType::Float2, "aTexCoord" },
+        { Shader::DataType::Float3, "aTangent"  }
+    };
+}
+
+void MeshPool::init(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    grow_(vertexCapacity, indexCapacity);
+}
+
+bool MeshPool::get(const Mesh& mesh, Range& range)
+{
+    auto it = m_entries.find(&mesh);
+
+    if (it != m_entries.end())
+    {
+        if (isCurrent_(it->second, mesh))
+        {
+            range = it->second.range;
+            return true;
+        }
+
+        release_(it->second);
+        m_entries.erase(it);
+    }
+
+    if (!isPoolable(mesh))
+    {
+        return false;
+    }
+
+    uint32_t vertexCount = static_cast<uint32_t>(mesh.vertexBuffer->getSize() / sizeof(ModelVertex));
+    uint32_t indexCount = mesh.indexBuffer->getCount();
+
+    uint32_t firstVertex = 0, firstIndex = 0;
+
+    auto allocate = [&]()
+    {
+        if (!m_vertices.allocate(vertexCount, firstVertex))
+        {
+            return false;
+        }
+
+        if (!m_indices.allocate(indexCount, firstIndex))
+        {
+            m_vertices.release(firstVertex, vertexCount);
+            return false;
+        }
+
+        return true;
+    };
+
+    if (!allocate())
+    {
+        // Meshes that died since the last time the pool was full might have left enough room
+        releaseExpired_();
+
+        if (!allocate())
+        {
+            grow_(std::max(m_vertices.getCapacity() * 2, m_vertices.getCapacity() + vertexCount),
+                  std::max(m_indices.getCapacity() * 2, m_indices.getCapacity() + indexCount));
+            allocate();
+        }
+    }
+
+    m_vertexBuffer->copyData(*mesh.vertexBuffer, vertexCount * sizeof(ModelVertex), 0, firstVertex * sizeof(ModelVertex));
+    m_indexBuffer->copyData(*mesh.indexBuffer, indexCount, 0, firstIndex);
+
+    Entry& entry = m_entries[&mesh];
+    entry.vertexBuffer = mesh.vertexBuffer;
+    entry.indexBuffer = mesh.indexBuffer;
+    entry.vertexCount = vertexCount;
+    entry.range = { firstIndex, indexCount, static_cast<int32_t>(firstVertex) };
+
+    range = entry.range;
+    return true;
+}
+
+bool MeshPool::isPoolable(const Mesh& mesh)
+{
+    static const BufferLayout layout = modelLayout();
+
+    if (!mesh.vertexBuffer || !mesh.indexBuffer)
+    {
+        return false;
+    }
+
+    if (mesh.indexBuffer->getDataType() != IndexDataType::UInt32 || mesh.indexBuffer->getCount() == 0)
+    {
+        return false;
+    }
+
+    const BufferLayout& meshLayout = mesh.vertexBuffer->getLayout();
+
+    if (meshLayout.size() != layout.size() || meshLayout.getStride() != sizeof(ModelVertex))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < layout.size(); i++)
+    {
+        if (meshLayout[i].type != layout[i].type || meshLayout[i].offset != layout[i].offset)
+        {
+            return false;
+        }
+    }
+
+    return mesh.vertexBuffer->getSize() >= sizeof(ModelVertex);
+}
+
+bool MeshPool::isCurrent_(const Entry& entry, const Mesh& mesh) const
+{
+    // A different mesh can be allocated at a dead mesh's address, so the buffers have to match as well.
+    // Contents rewritten in place at the same size aren't noticed.
+    auto vertexBuffer = entry.vertexBuffer.lock();
+    auto indexBuffer = entry.indexBuffer.lock();
+
+    return vertexBuffer && vertexBuffer == mesh.vertexBuffer && indexBuffer && indexBuffer == mesh.indexBuffer
+        && vertexBuffer->getSize() / sizeof(ModelVertex) == entry.vertexCount && indexBuffer->getCount() == entry.range.indexCount;
+}
+
+void MeshPool::release_(const Entry& entry)
+{
+    m_vertices.release(static_cast<uint32_t>(entry.range.baseVertex), entry.vertexCount);
+    m_indices.release(entry.range.firstIndex, entry.range.indexCount);
+}
+
+void MeshPool::releaseExpired_()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->second.vertexBuffer.expired() || it->second.indexBuffer.expired())
+        {
+            release_(it->second);
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void MeshPool::grow_(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+    // Bound first, so creating the index buffer can't replace the element buffer of whatever array was bound before
+    auto vertexArray = VertexArray::create();
+    vertexArray->bind();
+
+    auto vertexBuffer = VertexBuffer::create(vertexCapacity * sizeof(ModelVertex));
+    vertexBuffer->setLayout(modelLayout());
+
+    auto indexBuffer = IndexBuffer::create(indexCapacity, IndexDataType::UInt32);
+
+    if (m_vertexBuffer)
+    {
+        vertexBuffer->copyData(*m_vertexBuffer, m_vertices.getCapacity() * sizeof(ModelVertex), 0, 0);
+        indexBuffer->copyData(*m_indexBuffer, m_indices.getCapacity(), 0, 0);
+    }
+
+    vertexArray->addVertexBuffer(vertexBuffer);
+    vertexArray->setIndexBuffer(indexBuffer);
+
+    m_vertices.grow(vertexCapacity);
+    m_indices.grow(indexCapacity);
+
+    m_vertexBuffer = vertexBuffer;
+    m_indexBuffer = indexBuffer;
+    m_vertexArray = vertexArray;
+}
+
+bool MeshPool::FreeList::allocate(uint32_t size, uint32_t& offset)
+{
+    for (auto it = m_blocks.begin(); it != m_blocks.end(); it++)
+    {
+        if (it->size < size)
+        {
+            continue;
+        }
+
+        offset = it->offset;
+        it->offset += size;
+        it->size -= size;
+
+        if (it->size == 0)
+        {
+            m_blocks.erase(it);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void MeshPool::FreeList::release(uint32_t offset, uint32_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    auto next = std::lower_bound(m_blocks.begin(), m_blocks.end(), offset, [](const Block& block, uint32_t value)
+    {
+        return block.offset < value;
+    });
+
+    // Merge with the neighbours where they touch
+    bool mergePrevious = next != m_blocks.begin() && std::prev(next)->offset + std::prev(next)->size == offset;
+    bool mergeNext = next != m_blocks.end() && offset + size == next->offset;
+
+    if (mergePrevious && mergeNext)
+    {
+        std::prev(next)->size += size + next->size;
+        m_blocks.erase(next);
+    }
+    else if (mergePrevious)
+    {
+        std::prev(next)->size += size;
+    }
+    else if (mergeNext)
+    {
+        next->offset = offset;
+        next->size += size;
+    }
+    else
+    {
+        m_blocks.insert(next, { offset, size });
+    }
+}
+
+void MeshPool::FreeList::grow(uint32_t capacity)
+{
+    if (capacity <= m_capacity)
+    {
+        return;
+    }
+
+    uint32_t previous = m_capacity;
+    m_capacity = capacity;
+
+    release(previous, capacity - previous);
+}
+
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <core/Logger.h>
 #include <renderer/Assets.h>
 
+#include <algorithm>
+
 namespace Engine
 {
 
@@ -14,78 +16,113 @@ Reference<Model> ModelLoader::load(const std::string& path)
 
     Reference<Model> model = createReference<Model>();
 
-    auto scene = setupAssimp_(path);
-
     model->path = path;
     model->directory = path.substr(0, path.find_last_of('/'));
 
-    processNode_(scene->mRootNode, scene, model);
+    auto cache = loadMeshCache(path);
+
+    if (!cache)
+    {
+        return model;
+    }
+
+    for (uint32_t i = 0; i < cache->getModelMeshCount(); i++)
+    {
+        model->meshes.push_back(createMesh(*cache, cache->getModelMesh(i), path));
+    }
 
     m_modelsLoaded.emplace(std::make_pair(path, model));
 
     return model;
 }
 
-const aiScene* ModelLoader::setupAssimp_(const std::string& modelPath)
+Reference<Mesh> ModelLoader::loadMesh(const std::string& path, unsigned int id)
+{
+    auto cache = loadMeshCache(path);
+
+    if (!cache)
+    {
+        return nullptr;
+    }
+
+    return createMesh(*cache, id, path);
+}
+
+const aiScene* ModelLoader::setupAssimp_(Assimp::Importer& importer, const std::string& modelPath)
 {
-    const aiScene* scene = m_importer.ReadFile(modelPath, aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals);
+    const aiScene* scene = importer.ReadFile(modelPath, aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals);
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
     {
-        Logger::getCoreLogger()->error("[ASSIMP] %s", m_importer.GetErrorString());
+        Logger::getCoreLogger()->error("[ASSIMP] %s", importer.GetErrorString());
+        return nullptr;
     }
 
     return scene;
 }
 
-Reference<Mesh> ModelLoader::loadMesh(const std::string& path, unsigned int id)
+Reference<MeshCache> ModelLoader::loadMeshCache(const std::string& path)
 {
-    auto scene = setupAssimp_(path);
+    auto cache = MeshCache::open(path);
+
+    if (cache)
+    {
+        return cache;
+    }
+
+    return cook_(path);
+}
 
-    Reference<Model> temp = createReference<Model>();
-    temp->path = path;
-    temp->directory = path.substr(0, path.find_last_of('/'));
+Reference<MeshCache> ModelLoader::cook_(const std::string& path)
+{
+    // An importer per cook, so models can be cooked on several threads at once
+    Assimp::Importer importer;
+    const aiScene* scene = setupAssimp_(importer, path);
 
-    if (id >= scene->mNumMeshes)
+    if (!scene)
     {
-        Logger::getCoreLogger()->error("Mesh ID (%i) greater than amount of meshes!", id);
+        return nullptr;
+    }
 
-        aiMesh* mesh = scene->mMeshes[0];
+    std::string directory = path.substr(0, path.find_last_of('/'));
 
-        return processMesh_(mesh, scene, temp);
+    std::vector<CookedSubmesh> submeshes(scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+    {
+        processMesh_(scene->mMeshes[i], scene, directory, submeshes[i]);
     }
 
-    aiMesh* mesh = scene->mMeshes[id];
+    std::vector<uint32_t> modelMeshes;
+    processNode_(scene->mRootNode, modelMeshes);
+
+    importer.FreeScene();
 
-    auto mesh_ = processMesh_(mesh, scene, temp);
-    mesh_->path = path;
-    mesh_->id = id;
-    return mesh_;
+    return MeshCache::cook(path, submeshes, modelMeshes);
 }
 
-void ModelLoader::processNode_(aiNode* node, const aiScene* scene, const Reference<Model>& model)
+void ModelLoader::processNode_(aiNode* node, std::vector<uint32_t>& modelMeshes)
 {
     for (unsigned int i = 0; i < node->mNumMeshes; i++)
     {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        model->meshes.push_back(processMesh_(mesh, scene, model));
+        modelMeshes.push_back(node->mMeshes[i]);
     }
 
     for (unsigned int i = 0; i < node->mNumChildren; i++)
     {
-        processNode_(node->mChildren[i], scene, model);
+        processNode_(node->mChildren[i], modelMeshes);
     }
 }
 
-Reference<Mesh> ModelLoader::processMesh_(aiMesh* mesh, const aiScene* scene, const Reference<Model>& model)
+void ModelLoader::processMesh_(aiMesh* mesh, const aiScene* scene, const std::string& directory, CookedSubmesh& submesh)
 {
-    Reference<Material> material;
-    std::vector<ModelVertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<ModelVertex>& vertices = submesh.vertices;
+    std::vector<uint32_t>& indices = submesh.indices;
+
+    vertices.resize(mesh->mNumVertices);
 
     for (unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
-        ModelVertex vertex;
+        ModelVertex& vertex = vertices[i];
 
         vertex.position.x = mesh->mVertices[i].x;
         vertex.position.y = mesh->mVertices[i].y;
@@ -102,7 +139,7 @@ Reference<Mesh> ModelLoader::processMesh_(aiMesh* mesh, const aiScene* scene, co
             vertex.normal = math::vec3(0.f);
         }
 
-        if (mesh->mTextureCoords)
+        if (mesh->mTextureCoords[0])
         {
             vertex.uv.x = mesh->mTextureCoords[0][i].x;
             vertex.uv.y = mesh->mTextureCoords[0][i].y;
@@ -122,59 +159,71 @@ Reference<Mesh> ModelLoader::processMesh_(aiMesh* mesh, const aiScene* scene, co
         {
             vertex.tangent = math::vec3(0.f);
         }
-
-        vertices.push_back(vertex);
     }
 
+    // Faces are triangles after aiProcess_Triangulate, apart from point and line primitives
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
+
     for (unsigned int i = 0; i < mesh->mNumFaces; i++)
     {
-        aiFace face = mesh->mFaces[i];
-        for (unsigned int j = 0; j < face.mNumIndices; j++)
-        {
-            indices.push_back(face.mIndices[j]);
-        }
+        const aiFace& face = mesh->mFaces[i];
+        indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
     }
-/*
-    bool needToLoadMaterial = true;
-    for (auto& materialLoaded : m_materialsLoaded)
+
+    if (mesh->mMaterialIndex > 0)
     {
-        if (mesh->mMaterialIndex == materialLoaded.first) // FIXME: doesn't work
-        {
-            needToLoadMaterial = false;
-            material = materialLoaded.second;
-            break;
-        }
+        aiMaterial* aimaterial = scene->mMaterials[mesh->mMaterialIndex];
+
+        submesh.hasMaterial = true;
+
+        auto& textures = submesh.textures;
+        textures[static_cast<size_t>(MeshTexture::Albedo)] = getMaterialTexture_(aimaterial, aiTextureType_DIFFUSE, directory);
+        textures[static_cast<size_t>(MeshTexture::Normal)] = getMaterialTexture_(aimaterial, aiTextureType_NORMALS, directory);
+        textures[static_cast<size_t>(MeshTexture::Metallic)] = getMaterialTexture_(aimaterial, aiTextureType_REFLECTION, directory);
+        textures[static_cast<size_t>(MeshTexture::Roughness)] = getMaterialTexture_(aimaterial, aiTextureType_SHININESS, directory);
+        textures[static_cast<size_t>(MeshTexture::AmbientOcclusion)] = getMaterialTexture_(aimaterial, aiTextureType_LIGHTMAP, directory);
+        textures[static_cast<size_t>(MeshTexture::Emission)] = getMaterialTexture_(aimaterial, aiTextureType_EMISSIVE, directory);
     }
+}
 
-    if (needToLoadMaterial)
-    {*/
-        if (mesh->mMaterialIndex > 0)
-        {
-            aiMaterial* aimaterial = scene->mMaterials[mesh->mMaterialIndex];
+std::string ModelLoader::getMaterialTexture_(aiMaterial* mat, aiTextureType type, const std::string& directory)
+{
+    if (mat->GetTextureCount(type) == 0)
+    {
+        return "";
+    }
 
-            auto albedo = loadMaterialTexture_(aimaterial, aiTextureType_DIFFUSE, model->directory);
-            auto normal = loadMaterialTexture_(aimaterial, aiTextureType_NORMALS, model->directory);
-            auto metallic = loadMaterialTexture_(aimaterial, aiTextureType_REFLECTION, model->directory);
-            auto roughness = loadMaterialTexture_(aimaterial, aiTextureType_SHININESS, model->directory);
-            auto ambientOcclusion = loadMaterialTexture_(aimaterial, aiTextureType_LIGHTMAP, model->directory);
-            auto emission = loadMaterialTexture_(aimaterial, aiTextureType_EMISSIVE, model->directory);
+    aiString str;
+    if (mat->GetTexture(type, 0, &str) == AI_FAILURE)
+    {
+        Logger::getCoreLogger()->error("[ASSIMP] Could not open texture material!");
+        return "";
+    }
 
-            material = Material::create(Assets::get<Shader>("EnginePBR_Static")); // TODO: material shaders
+    return directory + "/" + str.C_Str();
+}
 
-            material->albedoMap = albedo;
-            material->normalMap = normal;
-            material->metallicMap = metallic;
-            material->roughnessMap = roughness;
-            material->ambientOcclusionMap = ambientOcclusion;
-            material->emissionMap = emission;
+Reference<Mesh> ModelLoader::createMesh(const MeshCache& cache, uint32_t id, const std::string& path, bool asyncTextures)
+{
+    if (cache.getSubmeshCount() == 0)
+    {
+        Logger::getCoreLogger()->error("No meshes in %s", path.c_str());
+        return nullptr;
+    }
 
-            m_materialsLoaded.emplace(std::pair<int, Reference<Material>>(mesh->mMaterialIndex, material));
-        }
-    //}
+    uint32_t index = id;
+
+    if (index >= cache.getSubmeshCount())
+    {
+        Logger::getCoreLogger()->error("Mesh ID (%i) greater than amount of meshes!", id);
+        index = 0;
+    }
+
+    const MeshCacheSubmesh& submesh = cache.getSubmesh(index);
 
-    Reference<Mesh> mesh_ = createReference<Mesh>();
-    mesh_->vertexArray = VertexArray::create();
-    mesh_->vertexArray->bind();
+    Reference<Mesh> mesh = createReference<Mesh>();
+    mesh->vertexArray = VertexArray::create();
+    mesh->vertexArray->bind();
 
     BufferLayout layout = {
         { Shader::DataType::Float3, "aPos"      },
@@ -183,54 +232,99 @@ Reference<Mesh> ModelLoader::processMesh_(aiMesh* mesh, const aiScene* scene, co
         { Shader::DataType::Float3, "aTangent"  }
     };
 
-    mesh_->indexBuffer = IndexBuffer::create(indices.size(), IndexDataType::UInt32);
-    mesh_->indexBuffer->setData(&indices[0], indices.size());
-    
-    mesh_->vertexBuffer = VertexBuffer::create(vertices.size() * sizeof(ModelVertex));
-    mesh_->vertexBuffer->setData(&vertices[0], vertices.size() * sizeof(ModelVertex));
-    mesh_->vertexBuffer->setLayout(layout);
-    
-    mesh_->vertexArray->addVertexBuffer(mesh_->vertexBuffer);
-    mesh_->vertexArray->setIndexBuffer(mesh_->indexBuffer);
+    // Uploaded straight from the cooked file's mapping
+    mesh->indexBuffer = IndexBuffer::create(cache.getIndices(submesh), submesh.indexCount, IndexDataType::UInt32);
+
+    mesh->vertexBuffer = VertexBuffer::create(cache.getVertices(submesh), submesh.vertexCount * sizeof(ModelVertex));
+    mesh->vertexBuffer->setLayout(layout);
+
+    mesh->vertexArray->addVertexBuffer(mesh->vertexBuffer);
+    mesh->vertexArray->setIndexBuffer(mesh->indexBuffer);
+
+    if (submesh.hasMaterial)
+    {
+        auto material = Material::create(Assets::get<Shader>("EnginePBR_Static")); // TODO: material shaders
+
+        const std::pair<MeshTexture, Reference<Texture2D> Material::*> maps[] = {
+            { MeshTexture::Albedo,           &Material::albedoMap           },
+            { MeshTexture::Normal,           &Material::normalMap           },
+            { MeshTexture::Metallic,         &Material::metallicMap         },
+            { MeshTexture::Roughness,        &Material::roughnessMap        },
+            { MeshTexture::AmbientOcclusion, &Material::ambientOcclusionMap },
+            { MeshTexture::Emission,         &Material::emissionMap         }
+        };
+
+        for (auto& [texture, map] : maps)
+        {
+            if (asyncTextures)
+            {
+                loadTextureAsync_(cache.getTexture(submesh, texture), material, map);
+            }
+            else
+            {
+                (*material).*map = loadTexture_(cache.getTexture(submesh, texture));
+            }
+        }
+
+        mesh->material = material;
+    }
 
-    mesh_->material = material;
+    mesh->bounds = submesh.bounds;
+    mesh->boundingSphere = submesh.boundingSphere;
 
-    return mesh_;
+    mesh->path = path;
+    mesh->id = index;
+
+    return mesh;
 }
 
-Reference<Texture2D> ModelLoader::loadMaterialTexture_(aiMaterial* mat, aiTextureType type, const std::string& directory)
+Reference<Texture2D> ModelLoader::loadTexture_(const std::string& path)
 {
-    Reference<Texture2D> texture = nullptr;
+    if (path.empty())
+    {
+        return nullptr;
+    }
 
-    if (mat->GetTextureCount(type) == 0)
+    for (auto& texture : m_texturesLoaded)
     {
-        return texture;
+        if (texture->getPath() == path)
+        {
+            return texture;
+        }
     }
 
-    aiString str;
-    if (mat->GetTexture(type, 0, &str) == AI_FAILURE)
+    auto texture = Texture2D::create(path);
+    m_texturesLoaded.push_back(texture);
+
+    return texture;
+}
+
+void ModelLoader::loadTextureAsync_(const std::string& path, const Reference<Material>& material, Reference<Texture2D> Material::* map)
+{
+    if (path.empty())
     {
-        Logger::getCoreLogger()->error("[ASSIMP] Could not open texture material!");
+        return;
     }
 
-    bool skip = false;
-    for (unsigned int j = 0; j < m_texturesLoaded.size(); j++)
+    for (auto& texture : m_texturesLoaded)
     {
-        std::string texturePath = directory + "/" + std::string(str.C_Str());
-        if (std::strcmp(m_texturesLoaded[j]->getPath().c_str(), texturePath.c_str()) == 0)
+        if (texture->getPath() == path)
         {
-            texture = m_texturesLoaded[j];
-            skip = true;
-            break;
+            (*material).*map = texture;
+            return;
         }
     }
-    if (!skip)
-    {
-        texture = Texture2D::create(directory + "/" + str.C_Str());
 
-        m_texturesLoaded.push_back(texture);
-    }
+    // The map stays empty rather than taking the placeholder, so the material doesn't sample a white normal map meanwhile
+    Assets::loadAsync<Texture2D>(path, [material, map](const Reference<Texture2D>& texture)
+    {
+        if (std::find(m_texturesLoaded.begin(), m_texturesLoaded.end(), texture) == m_texturesLoaded.end())
+        {
+            m_texturesLoaded.push_back(texture);
+        }
 
-    return texture;
+        (*material).*map = texture;
+    });
 }
+
 }
\ No newline at end of file
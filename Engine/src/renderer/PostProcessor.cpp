@@ -49,7 +49,7 @@ Reference<Framebuffer> PostProcessor::finishHdr(const Reference<Framebuffer>& fr
     Assets::get<Shader>("EngineHDR_Pass")->bind();
     Assets::get<Shader>("EngineHDR_Pass")->setFloat("uExposure", Renderer::hdrExposure);
 
-    glBindTextureUnit(0, framebuffer->getColorAttachment()); // TODO: platform independent
+    RenderCommand::bindTexture(0, framebuffer->getColorAttachment());
 
     RenderCommand::renderIndexed(m_framebufferMesh->vertexArray);
 
@@ -70,7 +70,7 @@ Reference<Framebuffer> PostProcessor::finishHdrAndBloom(const Reference<Framebuf
         m_pingPongBuffers[horizontal]->bind();
 
         Assets::get<Shader>("EngineHDR_GaussianBlur")->setInt("uHorizontal", horizontal);
-        glBindTextureUnit(0, firstIteration ? framebuffer->getColorAttachment(1) : m_pingPongBuffers[!horizontal]->getColorAttachment());
+        RenderCommand::bindTexture(0, firstIteration ? framebuffer->getColorAttachment(1) : m_pingPongBuffers[!horizontal]->getColorAttachment());
 
         RenderCommand::renderIndexed(m_framebufferMesh->vertexArray);
 
@@ -89,8 +89,8 @@ Reference<Framebuffer> PostProcessor::finishHdrAndBloom(const Reference<Framebuf
     Assets::get<Shader>("EngineHDR_Bloom_Pass")->bind();
     Assets::get<Shader>("EngineHDR_Bloom_Pass")->setFloat("uExposure", Renderer::hdrExposure);
 
-    glBindTextureUnit(0, framebuffer->getColorAttachment()); // TODO: platform independent
-    glBindTextureUnit(1, m_pingPongBuffers[!horizontal]->getColorAttachment());
+    RenderCommand::bindTexture(0, framebuffer->getColorAttachment());
+    RenderCommand::bindTexture(1, m_pingPongBuffers[!horizontal]->getColorAttachment());
 
     RenderCommand::renderIndexed(m_framebufferMesh->vertexArray);
 
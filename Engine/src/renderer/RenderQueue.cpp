@@ -0,0 +1,47 @@
+#include <renderer/RenderQueue.h>
+#include <renderer/Mesh.h>
+#include <renderer/Material.h>
+#include <util/RadixSort.h>
+
+namespace Engine
+{
+
+void RenderQueue::clear()
+{
+    m_objects.clear();
+    m_keys.clear();
+}
+
+void RenderQueue::push(const Reference<Mesh>& mesh, const Reference<Material>& material, const math::mat4& transform, const BoundingSphere& bounds, Pass pass, float depth,
+                       bool castShadows, bool isStatic)
+{
+    uint32_t shader = material->shader ? material->shader->getId() : 0;
+
+    m_keys.push_back(makeKey(pass, shader, material->sortId, mesh->sortId, depth));
+    m_objects.push_back({ mesh, material, transform, bounds, castShadows, isStatic });
+}
+
+uint64_t RenderQueue::makeKey(Pass pass, uint32_t shader, uint32_t material, uint32_t mesh, float depth)
+{
+    // Ids only need to group equal state together; wrapping just costs an extra bind
+    uint64_t state = (static_cast<uint64_t>(shader & 0xFFF) << 26)
+                   | (static_cast<uint64_t>(material & 0x3FFF) << 12)
+                   | (static_cast<uint64_t>(mesh & 0xFFF));
+
+    depth = std::min(std::max(depth, 0.f), 1.f);
+    uint64_t quantizedDepth = static_cast<uint64_t>(depth * 0xFFFFFF);
+
+    if (pass == Pass::Transparent)
+    {
+        return (static_cast<uint64_t>(pass) << 62) | ((0xFFFFFF - quantizedDepth) << 38) | state;
+    }
+
+    return (static_cast<uint64_t>(pass) << 62) | (state << 24) | quantizedDepth;
+}
+
+void RenderQueue::sort()
+{
+    radixSort(m_keys, m_order, m_scratch);
+}
+
+}
\ No newline at end of file
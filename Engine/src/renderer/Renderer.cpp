@@ -44,7 +44,7 @@ void Renderer::endFrame()
 
     RenderCommand::clear(RenderCommand::defaultClearBits());
 
-    glBindTextureUnit(0, m_data.target->getColorAttachment());
+    RenderCommand::bindTexture(0, m_data.target->getColorAttachment());
     //m_data.target->getColorAttachment()->bind();
 
     m_data.fboShader->bind();
@@ -53,6 +53,12 @@ void Renderer::endFrame()
     RenderCommand::renderIndexed(m_data.fboMesh->vertexArray);
 }
 
+void Renderer::nextFrame()
+{
+    Renderer2D::nextFrame();
+    Renderer3D::nextFrame();
+}
+
 void Renderer::windowResize(WindowResizeEvent& event)
 {
     m_data.target->resize(event.getWidth(), event.getHeight());
@@ -5,25 +5,23 @@
 #include <maths/matrix/matrix_func.h>
 #include <renderer/RenderCommand.h>
 #include <renderer/Assets.h>
+#include <util/Utf8.h>
+
+#include <algorithm>
 
 namespace Engine
 {
 
+// A batch starts in a new stream region when less than this is left in the current one
+static constexpr uint32_t MIN_BATCH_VERTICES = 4 * 1024;
+
 void Renderer2D::init()
 {
     s_data.matrixData = UniformBuffer::create(sizeof(math::mat4) * 2, 2);
 
-    s_data.textShader = Shader::createFromFile("Engine/assets/shaders/Engine2D_Text.glsl");
-    s_data.textureShader = Shader::createFromFile("Engine/assets/shaders/Engine2D_Texture.glsl");
-
     s_data.textureShader = Assets::get<Shader>("Engine2D_Texture");
-    s_data.textShader = Assets::get<Shader>("Engine2D_Text");
-
-    s_data.textMesh = MeshFactory::textMesh(s_data.MAX_GLYPHS);
-    s_data.textVertexBase = new GlyphVertex[4 * s_data.MAX_GLYPHS];
-    s_data.textVertexPtr = s_data.textVertexBase;
 
-    s_data.vertexBase = new QuadVertex[s_data.MAX_VERTICES];
+    s_data.vertexStream = StreamBuffer::create(sizeof(QuadVertex) * s_data.MAX_VERTICES);
 
     s_data.mesh.vertexArray = VertexArray::create();
     s_data.mesh.vertexArray->bind();
@@ -32,7 +30,8 @@ void Renderer2D::init()
         { Shader::DataType::Float3,  "aPos"      },
         { Shader::DataType::Float2,  "aTexCoord" },
         { Shader::DataType::Float4,  "aColor"    },
-        { Shader::DataType::Float,   "aTexIndex" }
+        { Shader::DataType::Float,   "aTexIndex" },
+        { Shader::DataType::Float,   "aSampling" }
     };
     
     uint32_t* indices = new uint32_t[s_data.MAX_INDICES];
@@ -55,10 +54,7 @@ void Renderer2D::init()
 
     delete[] indices;
  
-    s_data.mesh.vertexBuffer = VertexBuffer::create(sizeof(QuadVertex) * 4 * s_data.MAX_SPRITES);
-    s_data.mesh.vertexBuffer->setLayout(layout);
-
-    s_data.mesh.vertexArray->addVertexBuffer(s_data.mesh.vertexBuffer);
+    s_data.mesh.vertexArray->addVertexBuffer(*s_data.vertexStream, layout);
     s_data.mesh.vertexArray->setIndexBuffer(s_data.mesh.indexBuffer);
 
     int32_t samplers[s_data.MAX_TEXTURE_SLOTS];
@@ -75,23 +71,35 @@ void Renderer2D::init()
 
 void Renderer2D::shutdown()
 {
-    delete[] s_data.vertexBase;
-    delete[] s_data.textVertexBase;
+    s_data.vertexStream.reset();
 }
 
-void Renderer2D::beginScene(Camera& camera)
+void Renderer2D::nextFrame()
+{
+    s_data.vertexStream->nextFrame();
+
+    TrueTypeFont::nextFrame();
+}
+
+void Renderer2D::beginScene(Camera& camera, SpriteQueue::Order order)
 {
     s_data.matrixData->setData(math::buffer(camera.getProjectionMatrix()), sizeof(math::mat4), 0);
     s_data.matrixData->setData(math::buffer(camera.getViewMatrix()), sizeof(math::mat4), sizeof(math::mat4));
 
+    s_data.spriteOrder = order;
+    s_data.layer = 0;
+
     startBatch();
 }
 
-void Renderer2D::beginScene(Camera& camera, const math::mat4& transform)
+void Renderer2D::beginScene(Camera& camera, const math::mat4& transform, SpriteQueue::Order order)
 {
     s_data.matrixData->setData(math::buffer(camera.getProjectionMatrix()), sizeof(math::mat4), 0);
     s_data.matrixData->setData(math::buffer(math::inverse<float>(transform)), sizeof(math::mat4), sizeof(math::mat4));
 
+    s_data.spriteOrder = order;
+    s_data.layer = 0;
+
     startBatch();
 }
 
@@ -102,11 +110,7 @@ void Renderer2D::endScene()
 
 void Renderer2D::startBatch()
 {
-    s_data.textureSlotIndex = 1;
-    s_data.vertexPointer = s_data.vertexBase;
-    s_data.indexCount = 0;
-
-    s_data.textVertexPtr = s_data.textVertexBase;
+    s_data.spriteQueue.clear();
 }
 
 void Renderer2D::nextBatch()
@@ -116,16 +120,116 @@ void Renderer2D::nextBatch()
 }
 
 void Renderer2D::flushBatch()
+{
+    if (s_data.spriteQueue.empty())
+    {
+        return;
+    }
+
+    s_data.spriteQueue.sort();
+
+    if (!beginBatch_())
+    {
+        s_data.spriteQueue.clear();
+        return;
+    }
+
+    const Texture2D* lastTexture = nullptr;
+    float textureIndex = 0.f;
+
+    for (uint32_t i = 0; i < s_data.spriteQueue.size(); i++)
+    {
+        const Sprite& sprite = s_data.spriteQueue[i];
+
+        if (s_data.vertexPointer + 4 > s_data.vertexLimit)
+        {
+            drawBatch_();
+
+            if (!beginBatch_())
+            {
+                break;
+            }
+
+            lastTexture = nullptr;
+        }
+
+        // Sorted sprites mostly share the previous sprite's texture
+        if (sprite.texture.get() != lastTexture)
+        {
+            textureIndex = getTextureSlot_(sprite.texture);
+            lastTexture = sprite.texture.get();
+
+            // Running out of texture slots starts a new batch, which can fail the same way
+            if (!s_data.vertexBase)
+            {
+                break;
+            }
+        }
+
+        const math::vec2 texCoords[] = {
+            { sprite.texRect.x, sprite.texRect.y },
+            { sprite.texRect.x, sprite.texRect.w },
+            { sprite.texRect.z, sprite.texRect.w },
+            { sprite.texRect.z, sprite.texRect.y }
+        };
+
+        for (uint32_t vertex = 0; vertex < 4; vertex++)
+        {
+            s_data.vertexPointer->position = sprite.positions[vertex];
+            s_data.vertexPointer->texCoord = texCoords[vertex];
+            s_data.vertexPointer->color = sprite.color;
+            s_data.vertexPointer->texIndex = textureIndex;
+            s_data.vertexPointer->sampling = static_cast<float>(sprite.sampling);
+            s_data.vertexPointer++;
+        }
+
+        s_data.indexCount += 6;
+    }
+
+    drawBatch_();
+
+    s_data.spriteQueue.clear();
+}
+
+bool Renderer2D::beginBatch_()
+{
+    s_data.textureSlotIndex = 1;
+    s_data.indexCount = 0;
+
+    StreamAllocation vertices = s_data.vertexStream->reserve(sizeof(QuadVertex) * MIN_BATCH_VERTICES, sizeof(QuadVertex));
+
+    // The stream has logged why, the sprites are dropped rather than written through a null pointer
+    if (!vertices.data)
+    {
+        s_data.vertexBase = nullptr;
+        s_data.vertexPointer = nullptr;
+        s_data.vertexLimit = nullptr;
+
+        return false;
+    }
+    size_t capacity = std::min<size_t>(vertices.size / sizeof(QuadVertex), Renderer2DData::MAX_VERTICES);
+
+    s_data.vertexBase = static_cast<QuadVertex*>(vertices.data);
+    s_data.vertexPointer = s_data.vertexBase;
+    s_data.vertexLimit = s_data.vertexBase + capacity;
+    s_data.vertexOffset = vertices.offset;
+
+    return true;
+}
+
+void Renderer2D::drawBatch_()
 {
     if (s_data.indexCount == 0)
         return;
 
     RenderCommand::setDepthTesting(false);
+    RenderCommand::setBlend(true);
+    RenderCommand::setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
 
     s_data.mesh.vertexArray->bind();
 
     size_t dataSize = static_cast<size_t>(reinterpret_cast<uint8_t*>(s_data.vertexPointer) - reinterpret_cast<uint8_t*>(s_data.vertexBase));
-    s_data.mesh.vertexBuffer->setData(s_data.vertexBase, dataSize);
+    s_data.vertexStream->commit(dataSize);
 
     s_data.textureShader->bind();
     
@@ -134,7 +238,31 @@ void Renderer2D::flushBatch()
         s_data.textureSlots[i]->bind(i);
     }
 
-    RenderCommand::renderIndexed(s_data.mesh.vertexArray, s_data.indexCount);
+    int32_t baseVertex = static_cast<int32_t>(s_data.vertexOffset / sizeof(QuadVertex));
+    RenderCommand::renderIndexed(s_data.mesh.vertexArray, s_data.indexCount, 0, baseVertex);
+
+    RenderCommand::setBlend(false);
+}
+
+float Renderer2D::getTextureSlot_(const Reference<Texture2D>& texture)
+{
+    for (uint32_t i = 0; i < s_data.textureSlotIndex; i++)
+    {
+        if (*(s_data.textureSlots[i]) == *texture)
+        {
+            return static_cast<float>(i);
+        }
+    }
+
+    if (s_data.textureSlotIndex >= Renderer2DData::MAX_TEXTURE_SLOTS)
+    {
+        drawBatch_();
+        beginBatch_();
+    }
+
+    s_data.textureSlots[s_data.textureSlotIndex] = texture;
+
+    return static_cast<float>(s_data.textureSlotIndex++);
 }
 
 void Renderer2D::renderSprite(const Reference<Texture2D>& texture, const math::vec2& position, const math::vec2& size, const math::vec4& color)
@@ -154,58 +282,21 @@ void Renderer2D::renderSprite(const Reference<Texture2D>& texture, const math::v
 
 void Renderer2D::renderSprite(const Reference<Texture2D>& texture, const math::mat4& transform, const math::frect& texRect, const math::vec4& color)
 {
-    constexpr size_t quadVertexCount = 4;
-
-    const float x1 = texRect.x / texture->getWidth();
-    const float y1 = texRect.y / texture->getHeight();
-    const float x2 = (texRect.x + texRect.w) / texture->getWidth();
-    const float y2 = (texRect.y + texRect.h) / texture->getHeight();
-
-    const math::vec2 texCoords[] = {
-        { x1, y1 },
-        { x1, y2 },
-        { x2, y2 },
-        { x2, y1 }
-    };
-
-    float textureIndex = 0.f;
-    for (uint32_t i = 0; i < s_data.textureSlotIndex; i++)
-    {
-        if (*(s_data.textureSlots[i]) == *texture)
-        {
-            textureIndex = static_cast<float>(i);
-            break;
-        }
-    }
-
-    if (textureIndex == 0.f)
-    {
-        if (s_data.textureSlotIndex >= Renderer2DData::MAX_TEXTURE_SLOTS)
-        {
-            nextBatch();
-        }
+    Sprite sprite;
+    sprite.texture = texture;
+    sprite.color = color;
 
-        textureIndex = static_cast<float>(s_data.textureSlotIndex);
-        s_data.textureSlots[s_data.textureSlotIndex] = texture;
-        s_data.textureSlotIndex++;
-    }
+    sprite.texRect.x = texRect.x / texture->getWidth();
+    sprite.texRect.y = texRect.y / texture->getHeight();
+    sprite.texRect.z = (texRect.x + texRect.w) / texture->getWidth();
+    sprite.texRect.w = (texRect.y + texRect.h) / texture->getHeight();
 
-    if (s_data.indexCount >= s_data.MAX_INDICES)
-    {
-        nextBatch();
-    }
-    
-    // Populate the vertices array with the sprite's vertices
-    for (size_t i = 0 ; i < quadVertexCount ; i++)
+    for (size_t i = 0; i < 4; i++)
     {
-        s_data.vertexPointer->position = transform * math::vec4(s_data.quadPositions[i], 0, 1);
-        s_data.vertexPointer->texCoord = texCoords[i];
-        s_data.vertexPointer->color = color;
-        s_data.vertexPointer->texIndex = textureIndex;
-        s_data.vertexPointer++;
+        sprite.positions[i] = transform * math::vec4(s_data.quadPositions[i], 0, 1);
     }
 
-    s_data.indexCount += 6;
+    s_data.spriteQueue.push(sprite, s_data.layer, transform[3].z, s_data.spriteOrder);
 }
 
 void Renderer2D::renderSprite(const Reference<Texture2D>& texture, const math::mat4& transform)
@@ -237,20 +328,18 @@ void Renderer2D::renderQuad(const math::vec2& position, const math::vec2& size,
 
 void Renderer2D::renderQuad(const math::mat4& transform, const math::vec4& color)
 {
-    constexpr uint32_t quadVertexCount = 4;
-    constexpr float textureIndex = 0.f;
-    constexpr math::vec2 texCoords[] = { {0, 0}, {0, 1}, {1, 1}, {1, 0} };
+    // Quads are sprites of the white texture
+    Sprite sprite;
+    sprite.texture = s_data.textureSlots[0];
+    sprite.texRect = math::vec4(0, 0, 1, 1);
+    sprite.color = color;
 
-    for (uint32_t i = 0 ; i < quadVertexCount ; i++)
+    for (uint32_t i = 0; i < 4; i++)
     {
-        s_data.vertexPointer->position = math::vec3(transform * math::vec4(s_data.quadPositions[i]));
-        s_data.vertexPointer->texCoord = texCoords[i];
-        s_data.vertexPointer->color = color;
-        s_data.vertexPointer->texIndex = textureIndex;
-        s_data.vertexPointer++;
+        sprite.positions[i] = math::vec3(transform * math::vec4(s_data.quadPositions[i]));
     }
 
-    s_data.indexCount += 6;
+    s_data.spriteQueue.push(sprite, s_data.layer, transform[3].z, s_data.spriteOrder);
 }
 
 void Renderer2D::renderText(const std::string& text, const Reference<TrueTypeFont>& font, const math::vec2& position, const math::vec4& color)
@@ -260,72 +349,57 @@ void Renderer2D::renderText(const std::string& text, const Reference<TrueTypeFon
 
 void Renderer2D::renderText(const std::string& text, const Reference<TrueTypeFont>& font, const math::vec2& position, const math::vec2& size, const math::vec4& color)
 {
-    math::vec2 scale = size / (float)font->getCharacterSize();
+    // Glyph metrics are in pixels of the atlas' glyph size
+    math::vec2 scale = size / static_cast<float>(TrueTypeFont::GLYPH_SIZE);
 
-    int x = position.x;
-    int y = position.y;
+    Sprite sprite;
+    sprite.texture = font->getTextureAtlas();
+    sprite.color = color;
+    sprite.sampling = SpriteSampling::Distance;
 
-    // Loop through each character in the string, and add its texCoords to the mesh
-    for (auto& c : text)
+    if (!sprite.texture)
     {
-        auto& ch = font->getGlyphs().at(c);
+        return;
+    }
 
-        math::vec2 pos = { x + ch.pos.x * scale.x, -y - ch.pos.y * scale.y };
-        math::vec2 size = ch.size * scale;
+    float x = position.x;
+    float y = position.y;
 
-        x += ch.advance.x * scale.x;
-        y += ch.advance.y * scale.y;
+    // Every visible character becomes a quad of its region in the atlas
+    for (size_t i = 0; i < text.size();)
+    {
+        const Glyph* glyph = font->getGlyph(decodeUtf8(text, i));
 
-        float x1 = pos.x;
-        float y1 = -pos.y;
-        float x2 = pos.x + size.x;
-        float y2 = -pos.y - size.y;
+        if (!glyph)
+        {
+            continue;
+        }
+
+        math::vec2 pos = { x + glyph->pos.x * scale.x, -y - glyph->pos.y * scale.y };
+        math::vec2 size = glyph->size * scale;
 
-        float u1 = ch.texOffset;
-        float v1 = 0;
-        float u2 = ch.texOffset + ch.size.x / font->getAtlasSize().x;
-        float v2 = ch.size.y / font->getAtlasSize().y;
+        x += glyph->advance.x * scale.x;
+        y += glyph->advance.y * scale.y;
 
         if (!size.x || !size.y)
         {
             continue;
         }
 
-        s_data.textVertexPtr->position = { x1, y1 };
-        s_data.textVertexPtr->texCoord = { u1, v1 };
-        s_data.textVertexPtr++;
+        float x1 = pos.x;
+        float y1 = -pos.y;
+        float x2 = pos.x + size.x;
+        float y2 = -pos.y - size.y;
 
-        s_data.textVertexPtr->position = { x2, y1 };
-        s_data.textVertexPtr->texCoord = { u2, v1 };
-        s_data.textVertexPtr++;
+        sprite.positions[0] = { x1, y1, 0 };
+        sprite.positions[1] = { x1, y2, 0 };
+        sprite.positions[2] = { x2, y2, 0 };
+        sprite.positions[3] = { x2, y1, 0 };
 
-        s_data.textVertexPtr->position = { x2, y2 };
-        s_data.textVertexPtr->texCoord = { u2, v2 };
-        s_data.textVertexPtr++;
+        sprite.texRect = glyph->texRect;
 
-        s_data.textVertexPtr->position = { x1, y2 };
-        s_data.textVertexPtr->texCoord = { u1, v2 };
-        s_data.textVertexPtr++;
+        s_data.spriteQueue.push(sprite, s_data.layer, 0, s_data.spriteOrder);
     }
-
-    size_t dataSize = static_cast<size_t>(reinterpret_cast<uint8_t*>(s_data.textVertexPtr) - reinterpret_cast<uint8_t*>(s_data.textVertexBase));
-
-    s_data.textMesh->vertexArray->bind();
-    s_data.textMesh->vertexBuffer->setData(s_data.textVertexBase, dataSize);
-
-    s_data.textShader->bind();
-    s_data.textShader->setFloat4("uTextColor", color);
-    font->getTextureAtlas()->bind();
-
-    RenderCommand::setBlend(true);
-    RenderCommand::setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
-    RenderCommand::setDepthTesting(false);
-
-    RenderCommand::renderIndexed(s_data.textMesh->vertexArray, 6 * text.size());
-
-    RenderCommand::setBlend(false);
-
-    s_data.textVertexPtr = s_data.textVertexBase;
 }
 
 }
\ No newline at end of file
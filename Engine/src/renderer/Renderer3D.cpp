@@ -9,9 +9,14 @@
 #include <maths/vector/vec_func.h>
 #include <util/io/FileSystem.h>
 
+#include <algorithm>
+
 namespace Engine
 {
 
+// Transforms per stream region before it has to grow
+static constexpr uint32_t INITIAL_TRANSFORM_CAPACITY = 1 << 14;
+
 void Renderer3D::init()
 {
     math::ivec2 windowSize = Game::getInstance()->getWindow().getSize();
@@ -22,42 +27,131 @@ void Renderer3D::init()
     s_data.matrixData = UniformBuffer::create(sizeof(math::mat4) * 2, 0);
     s_data.matrixData->setBlockDeclaration(*Assets::get<Shader>("EnginePBR_Static"));
 
+    s_data.lightData = ShaderStorageBuffer::create(sizeof(LightBlockHeader) + 16 * sizeof(PointLightData), LightBlock::BINDING_POINT);
+    s_data.clusterData = ShaderStorageBuffer::create(sizeof(ClusterHeader) + LightClusters::CLUSTER_COUNT * sizeof(ClusterRange), LightClusters::CLUSTER_BINDING_POINT);
+    s_data.lightIndexData = ShaderStorageBuffer::create(LightClusters::CLUSTER_COUNT * sizeof(uint32_t), LightClusters::INDEX_BINDING_POINT);
+
     s_data.skyboxMesh = MeshFactory::skyboxMesh();
     s_data.environment = EnvironmentMap::create("Sandbox/assets/environment.hdr");
 
     Framebuffer::Specification spec = {
-        1024, 1024,
+        ShadowCascades::MAP_SIZE, ShadowCascades::MAP_SIZE,
         {
             { Framebuffer::Attachment::Depth, Framebuffer::TextureSpecification(SizedTextureFormat::Depth24Stencil8) }
         }
     };
 
-    s_data.shadowMap = Texture2D::create(1024, 1024, SizedTextureFormat::Depth16, false, false);
-    s_data.shadowMapFramebuffer = Framebuffer::create(spec);
-    s_data.shadowMapFramebuffer->drawBuffer((uint32_t)ColorBuffer::None);
-    s_data.shadowMapFramebuffer->readBuffer((uint32_t)ColorBuffer::None);
+    for (uint32_t cascade = 0; cascade < ShadowCascades::CASCADE_COUNT; cascade++)
+    {
+        s_data.shadowMaps[cascade] = Framebuffer::create(spec);
+        s_data.shadowMaps[cascade]->drawBuffer((uint32_t)ColorBuffer::None);
+        s_data.shadowMaps[cascade]->readBuffer((uint32_t)ColorBuffer::None);
+
+        if (ShadowCascades::isCached(cascade))
+        {
+            s_data.staticShadowMaps[cascade] = Framebuffer::create(spec);
+            s_data.staticShadowMaps[cascade]->drawBuffer((uint32_t)ColorBuffer::None);
+            s_data.staticShadowMaps[cascade]->readBuffer((uint32_t)ColorBuffer::None);
+        }
+    }
 
-    s_data.lightProjection = math::ortho(-10.f, 10.f, -10.f, 10.f, 1.f, 7.5f);
-    s_data.lightView = math::lookAt(math::vec3(-2.0f, 4.0f, -1.0f), 
-                                    math::vec3( 0.0f, 0.0f,  0.0f), 
-                                    math::vec3( 0.0f, 1.0f,  0.0f));
+    s_data.shadowData = UniformBuffer::create(sizeof(ShadowBlock), ShadowBlock::BINDING_POINT);
 
-    s_data.lightMatrix = s_data.lightProjection * s_data.lightView;
+    s_data.meshPool.init(1 << 18, 1 << 20);
+    s_data.transformStream = StreamBuffer::create(INITIAL_TRANSFORM_CAPACITY * sizeof(math::mat4));
+    s_data.storageAlignment = RenderCommand::getCapabilities().storageBufferAlignment;
+    s_data.drawCommandData = IndirectBuffer::create(1024);
 }
 
 void Renderer3D::shutdown()
 {
-    
+    s_data.transformStream.reset();
+}
+
+void Renderer3D::nextFrame()
+{
+    s_data.transformStream->nextFrame();
 }
 
 void Renderer3D::startBatch()
 {
-    s_data.renderObjects.clear();
+    s_data.renderQueue.clear();
+}
+
+void Renderer3D::cull()
+{
+    s_data.cullingSpheres.clear();
+
+    for (uint32_t i = 0; i < s_data.renderQueue.size(); i++)
+    {
+        s_data.cullingSpheres.push(s_data.renderQueue[i].bounds);
+    }
+
+    uint32_t count = s_data.cullingSpheres.size();
+
+    s_cullingStatistics.visible = s_data.cameraFrustum.cull(s_data.cullingSpheres, s_data.cameraVisibility);
+    s_cullingStatistics.culled = count - s_cullingStatistics.visible;
+
+    s_cullingStatistics.shadowVisible = 0;
+    s_cullingStatistics.shadowCulled = count;
+    s_data.shadowCasters.assign(count, 0);
+
+    if (!s_data.usingShadows)
+    {
+        return;
+    }
+
+    s_data.casters.resize(count);
+    s_data.staticCasters.resize(count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto& renderObject = s_data.renderQueue[i];
+
+        s_data.casters[i] = renderObject.castShadows;
+        s_data.staticCasters[i] = renderObject.castShadows && renderObject.isStatic;
+    }
+
+    // Cached cascades split their casters, the static ones are kept in the cached map and the rest drawn over it
+    for (uint32_t cascade = 0; cascade < ShadowCascades::CASCADE_COUNT; cascade++)
+    {
+        auto& visibility = s_data.shadowVisibility[cascade];
+        auto& staticVisibility = s_data.staticShadowVisibility[cascade];
+
+        s_data.shadowCascades.getCascade(cascade).frustum.cull(s_data.cullingSpheres, visibility);
+        staticVisibility.assign(count, 0);
+
+        bool cached = ShadowCascades::isCached(cascade);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            visibility[i] &= s_data.casters[i];
+
+            if (cached)
+            {
+                staticVisibility[i] = visibility[i] & s_data.staticCasters[i];
+                visibility[i] &= !s_data.staticCasters[i];
+            }
+
+            s_data.shadowCasters[i] |= visibility[i] | staticVisibility[i];
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        s_cullingStatistics.shadowVisible += s_data.shadowCasters[i];
+    }
+
+    s_cullingStatistics.shadowCulled = count - s_cullingStatistics.shadowVisible;
 }
 
 void Renderer3D::flushBatch()
 {
     RenderCommand::setDepthTesting(true);
+
+    s_data.renderQueue.sort();
+    cull();
+    prepareDraws();
     
     // Shadows
     renderShadows();
@@ -65,55 +159,361 @@ void Renderer3D::flushBatch()
     s_data.environment->getIrradiance()->bind(7);
     s_data.environment->getPrefilter()->bind(8);
     s_data.environment->getBRDF()->bind(9);
-    s_data.shadowMap->bind(10);
 
-    for (auto& group : s_data.renderObjects)
+    for (uint32_t cascade = 0; cascade < ShadowCascades::CASCADE_COUNT; cascade++)
     {
-        group.first->bind();
-        group.first->shader->setFloat3("uCameraPos", s_data.cameraPos);
-        group.first->shader->setMatrix4("uLightSpaceMatrix", s_data.lightMatrix);
+        RenderCommand::bindTexture(10 + cascade, s_data.shadowMaps[cascade]->getDepthAttachment());
+    }
+
+    s_data.shadowData->setData(&s_data.shadowCascades.getBlock(), sizeof(ShadowBlock));
+    s_data.shadowData->bindRange();
+
+    uploadLights();
+
+    const Shader* lastShader = nullptr;
+    const Material* lastMaterial = nullptr;
+    const VertexArray* lastArray = nullptr;
+    UniformHandle transformUniform;
+    UniformHandle indirectUniform;
+    int32_t indirect = -1;
+    bool blending = false;
 
-        setLightingUniforms(group.first->shader);
+    for (const DrawBatch& batch : s_data.drawBatches)
+    {
+        auto& renderObject = s_data.renderQueue[batch.object];
+        auto& material = renderObject.material;
 
-        for (auto& renderObject : group.second)
+        if (!blending && s_data.renderQueue.getPass(batch.object) == RenderQueue::Pass::Transparent)
         {
-            group.first->shader->setMatrix4("uTransform", renderObject.transform);
-            renderObject.mesh->vertexArray->bind();
+            RenderCommand::setBlend(true);
+            RenderCommand::setBlendFunction(BlendFunction::SourceAlpha, BlendFunction::OneMinusSourceAlpha);
+            blending = true;
+        }
+
+        if (material.get() != lastMaterial)
+        {
+            material->bind();
+            lastMaterial = material.get();
+
+            // Per shader uniforms only need setting once per program
+            if (material->shader.get() != lastShader)
+            {
+                material->shader->setFloat3("uCameraPos", s_data.cameraPos);
+
+                transformUniform = material->shader->getUniformHandle("uTransform");
+                indirectUniform = material->shader->getUniformHandle("uIndirect");
+                indirect = -1;
+                lastShader = material->shader.get();
+            }
+        }
+
+        bool multiDraw = batch.commandCount > 0;
+        const Reference<VertexArray>& vertexArray = multiDraw ? s_data.meshPool.getVertexArray() : renderObject.mesh->vertexArray;
+
+        if (indirectUniform.isValid() && indirect != static_cast<int32_t>(multiDraw))
+        {
+            indirect = static_cast<int32_t>(multiDraw);
+            material->shader->setInt(indirectUniform, indirect);
+        }
+
+        if (vertexArray.get() != lastArray)
+        {
+            vertexArray->bind();
+            lastArray = vertexArray.get();
+        }
+
+        if (multiDraw)
+        {
+            RenderCommand::renderMultiIndirect(vertexArray, *s_data.drawCommandData, batch.commandCount, batch.firstCommand);
+        }
+        else
+        {
+            material->shader->setMatrix4(transformUniform, renderObject.transform);
+            RenderCommand::renderIndexed(vertexArray);
+        }
+    }
+
+    if (blending)
+    {
+        RenderCommand::setBlend(false);
+    }
+}
+
+void Renderer3D::prepareDraws()
+{
+    uint32_t count = s_data.renderQueue.size();
+
+    s_data.meshRanges.resize(count);
+    s_data.pooled.resize(count);
+    s_data.transformCount = 0;
+    s_data.drawCommands.clear();
+    s_data.drawBatches.clear();
+
+    // Every pooled draw is at most one instance per pass it's visible in
+    size_t maxInstances = 0;
+    bool shadowInstances = s_data.usingShadows && s_data.shadowMapShader->getUniformHandle("uIndirect").isValid();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto& renderObject = s_data.renderQueue[i];
+
+        s_data.pooled[i] = (s_data.cameraVisibility[i] || s_data.shadowCasters[i]) && s_data.meshPool.get(*renderObject.mesh, s_data.meshRanges[i]);
+
+        if (s_data.pooled[i])
+        {
+            maxInstances += s_data.cameraVisibility[i];
+
+            for (uint32_t cascade = 0; shadowInstances && cascade < ShadowCascades::CASCADE_COUNT; cascade++)
+            {
+                maxInstances += s_data.shadowVisibility[cascade][i] + s_data.staticShadowVisibility[cascade][i];
+            }
+        }
+    }
+
+    if (maxInstances > 0)
+    {
+        size_t size = maxInstances * sizeof(math::mat4);
+
+        // The stream is only read through storage buffer ranges, so it can be replaced by a bigger one at any time
+        if (size > s_data.transformStream->getRegionSize())
+        {
+            s_data.transformStream = StreamBuffer::create(std::max(size, s_data.transformStream->getRegionSize() * 2));
+        }
+
+        StreamAllocation allocation = s_data.transformStream->reserve(size, s_data.storageAlignment);
+        s_data.transforms = static_cast<math::mat4*>(allocation.data);
+        s_data.transformOffset = allocation.offset;
+
+        if (!s_data.transforms)
+        {
+            std::fill(s_data.pooled.begin(), s_data.pooled.end(), 0);
+        }
+    }
+
+    uint32_t commandObject = 0; // Render queue index of the last command's first instance
+
+    // Adds the object as another instance of the last command when both draw the same mesh. Returns whether a command was started.
+    auto pushDraw = [&commandObject](uint32_t object, bool extend)
+    {
+        uint32_t instance = s_data.transformCount++;
+        s_data.transforms[instance] = s_data.renderQueue[object].transform;
+
+        if (extend && s_data.renderQueue[commandObject].mesh == s_data.renderQueue[object].mesh)
+        {
+            s_data.drawCommands.back().instanceCount++;
+            return false;
+        }
+
+        const MeshPool::Range& range = s_data.meshRanges[object];
+        s_data.drawCommands.push_back({ range.indexCount, 1, range.firstIndex, range.baseVertex, instance });
+        commandObject = object;
+
+        return true;
+    };
+
+    // Shadow casters, one multi draw per cascade plus one for the static casters of a cached cascade
+    s_data.indirectShadows = shadowInstances;
+
+    auto pushShadowDraws = [&](DrawRange& draws, const std::vector<uint8_t>& visibility)
+    {
+        draws.firstCommand = static_cast<uint32_t>(s_data.drawCommands.size());
+        draws.commandCount = 0;
+
+        for (uint32_t i = 0; s_data.indirectShadows && i < count; i++)
+        {
+            if (visibility[i] && s_data.pooled[i])
+            {
+                draws.commandCount += pushDraw(i, draws.commandCount > 0);
+            }
+        }
+    };
+
+    for (uint32_t cascade = 0; cascade < ShadowCascades::CASCADE_COUNT; cascade++)
+    {
+        pushShadowDraws(s_data.shadowDraws[cascade], s_data.shadowVisibility[cascade]);
+        pushShadowDraws(s_data.staticShadowDraws[cascade], s_data.staticShadowVisibility[cascade]);
+    }
+
+    // Camera pass. Consecutive pooled draws with the same material join a multi draw, which keeps the queue's order.
+    // The queue sorts by mesh within a material, so repeated props end up as one instanced command.
+    const Shader* lastShader = nullptr;
+    bool shaderIndirect = false;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!s_data.cameraVisibility[i])
+        {
+            continue;
+        }
+
+        const auto& renderObject = s_data.renderQueue[i];
 
-            RenderCommand::renderIndexed(renderObject.mesh->vertexArray);
+        if (renderObject.material->shader.get() != lastShader)
+        {
+            lastShader = renderObject.material->shader.get();
+            shaderIndirect = lastShader->getUniformHandle("uIndirect").isValid();
+        }
+
+        if (!shaderIndirect || !s_data.pooled[i])
+        {
+            s_data.drawBatches.push_back({ i, 0, 0 });
+            continue;
         }
+
+        if (!s_data.drawBatches.empty())
+        {
+            DrawBatch& last = s_data.drawBatches.back();
+
+            if (last.commandCount > 0 && s_data.renderQueue[last.object].material == renderObject.material &&
+                s_data.renderQueue.getPass(last.object) == s_data.renderQueue.getPass(i))
+            {
+                last.commandCount += pushDraw(i, true);
+                continue;
+            }
+        }
+
+        s_data.drawBatches.push_back({ i, static_cast<uint32_t>(s_data.drawCommands.size()), 1 });
+        pushDraw(i, false);
+    }
+
+    if (!s_data.drawCommands.empty())
+    {
+        size_t size = s_data.transformCount * sizeof(math::mat4);
+
+        s_data.transformStream->commit(size);
+        s_data.transformStream->bindRange(TRANSFORM_BINDING_POINT, s_data.transformOffset, size);
+
+        s_data.drawCommandData->setData(s_data.drawCommands.data(), static_cast<uint32_t>(s_data.drawCommands.size()));
     }
 }
 
 void Renderer3D::renderShadows()
 {
+    if (!s_data.usingShadows)
+    {
+        return;
+    }
+
     RenderCommand::setDepthTesting(true);
     
     auto prevFbo = Framebuffer::getCurrentBoundFramebuffer();
 
-    // Shadows
-    RenderCommand::setViewport(0, 0, 1024, 1024);
-    s_data.shadowMapFramebuffer->bind();
-    RenderCommand::clear((uint32_t)RendererBufferType::Depth);
-
     s_data.shadowMapShader->bind();
-    s_data.shadowMapShader->setMatrix4("uLightSpaceMatrix", s_data.lightMatrix);
 
-    for (auto& group : s_data.renderObjects)
+    UniformHandle lightSpaceUniform = s_data.shadowMapShader->getUniformHandle("uLightSpaceMatrix");
+
+    for (uint32_t cascade = 0; cascade < ShadowCascades::CASCADE_COUNT; cascade++)
     {
-        for (auto& renderObject : group.second)
+        const auto& visibility = s_data.shadowVisibility[cascade];
+
+        s_data.shadowMapShader->setMatrix4(lightSpaceUniform, s_data.shadowCascades.getCascade(cascade).matrix);
+
+        if (!ShadowCascades::isCached(cascade))
         {
-            renderObject.mesh->vertexArray->bind();
+            s_data.shadowMaps[cascade]->bind();
+            RenderCommand::clear((uint32_t)RendererBufferType::Depth);
+
+            renderCasters(s_data.shadowDraws[cascade], visibility);
+            continue;
+        }
+
+        // The static casters are kept in their own map until they change, or update() moved the cascade
+        const auto& staticVisibility = s_data.staticShadowVisibility[cascade];
+        uint64_t hash = 0;
+        bool dynamicShadows = false;
+
+        for (uint32_t i = 0; i < s_data.renderQueue.size(); i++)
+        {
+            if (staticVisibility[i])
+            {
+                hash += ShadowCascades::hashCaster(s_data.renderQueue[i].mesh.get(), s_data.renderQueue[i].transform);
+            }
+
+            dynamicShadows |= visibility[i] != 0;
+        }
 
-            s_data.shadowMapShader->setMatrix4("uTransform", renderObject.transform);
+        bool staticUpdate = s_data.shadowCascades.needsUpdate(cascade, hash);
 
-            RenderCommand::renderIndexed(renderObject.mesh->vertexArray);
+        if (staticUpdate)
+        {
+            s_data.staticShadowMaps[cascade]->bind();
+            RenderCommand::clear((uint32_t)RendererBufferType::Depth);
+
+            renderCasters(s_data.staticShadowDraws[cascade], staticVisibility);
+        }
+
+        // The map is left alone while it holds exactly the static casters
+        if (!staticUpdate && !dynamicShadows && !s_data.dynamicShadows[cascade])
+        {
+            continue;
+        }
+
+        RenderCommand::copyTexture(s_data.staticShadowMaps[cascade]->getDepthAttachment(), s_data.shadowMaps[cascade]->getDepthAttachment(),
+                                   ShadowCascades::MAP_SIZE, ShadowCascades::MAP_SIZE);
+        s_data.dynamicShadows[cascade] = dynamicShadows;
+
+        if (dynamicShadows)
+        {
+            s_data.shadowMaps[cascade]->bind();
+            renderCasters(s_data.shadowDraws[cascade], visibility);
         }
     }
 
-    s_data.shadowMapFramebuffer->unbind();
+    if (prevFbo)
+    {
+        prevFbo->bind();
+    }
+    else
+    {
+        s_data.shadowMaps[0]->unbind();
 
-    prevFbo->bind();
+        math::ivec2 windowSize = Game::getInstance()->getWindow().getSize();
+        RenderCommand::setViewport(0, 0, windowSize.x, windowSize.y);
+    }
+}
+
+void Renderer3D::renderCasters(const DrawRange& draws, const std::vector<uint8_t>& visibility)
+{
+    UniformHandle transformUniform = s_data.shadowMapShader->getUniformHandle("uTransform");
+    UniformHandle indirectUniform = s_data.shadowMapShader->getUniformHandle("uIndirect");
+    const VertexArray* lastArray = nullptr;
+
+    // Pooled casters in one call, the rest one by one
+    if (draws.commandCount > 0)
+    {
+        auto& vertexArray = s_data.meshPool.getVertexArray();
+
+        s_data.shadowMapShader->setInt(indirectUniform, 1);
+        vertexArray->bind();
+        lastArray = vertexArray.get();
+
+        RenderCommand::renderMultiIndirect(vertexArray, *s_data.drawCommandData, draws.commandCount, draws.firstCommand);
+    }
+
+    if (indirectUniform.isValid())
+    {
+        s_data.shadowMapShader->setInt(indirectUniform, 0);
+    }
+
+    for (uint32_t i = 0; i < s_data.renderQueue.size(); i++)
+    {
+        if (!visibility[i] || (s_data.indirectShadows && s_data.pooled[i]))
+        {
+            continue;
+        }
+
+        auto& renderObject = s_data.renderQueue[i];
+
+        if (renderObject.mesh->vertexArray.get() != lastArray)
+        {
+            renderObject.mesh->vertexArray->bind();
+            lastArray = renderObject.mesh->vertexArray.get();
+        }
+
+        s_data.shadowMapShader->setMatrix4(transformUniform, renderObject.transform);
+
+        RenderCommand::renderIndexed(renderObject.mesh->vertexArray);
+    }
 }
 
 void Renderer3D::nextBatch()
@@ -135,6 +535,12 @@ void Renderer3D::beginScene(EditorCamera& camera)
     s_data.matrixData->setVariable("uView", math::buffer(camera.getViewMatrix()), sizeof(math::mat4));
 
     s_data.cameraPos = camera.getPosition();
+    s_data.cameraView = camera.getViewMatrix();
+    s_data.cameraFrustum = Frustum::fromMatrix(camera.getProjectionMatrix() * camera.getViewMatrix());
+    s_data.lightClusters.build(camera.getProjectionMatrix());
+
+    packLights();
+    updateShadows(camera.getViewMatrix(), camera.getProjectionMatrix());
 
     startBatch();
 }
@@ -149,9 +555,16 @@ void Renderer3D::beginScene(Camera& camera, const math::mat4& transform)
     s_data.sceneStarted = true;
 
     s_data.matrixData->setVariable("uProjection", math::buffer(camera.getProjectionMatrix()), sizeof(math::mat4));
-    s_data.matrixData->setVariable("uView", math::buffer(math::inverse<float>(transform)), sizeof(math::mat4));
+    math::mat4 view = math::inverse<float>(transform);
+    s_data.matrixData->setVariable("uView", math::buffer(view), sizeof(math::mat4));
 
     s_data.cameraPos = transform[3];
+    s_data.cameraView = view;
+    s_data.cameraFrustum = Frustum::fromMatrix(camera.getProjectionMatrix() * view);
+    s_data.lightClusters.build(camera.getProjectionMatrix());
+
+    packLights();
+    updateShadows(view, camera.getProjectionMatrix());
 
     startBatch();
 }
@@ -164,33 +577,18 @@ void Renderer3D::endScene()
 
     if (s_data.usingSkybox)
     {
-        glDepthFunc(GL_LEQUAL);
+        RenderCommand::setDepthFunction(DepthFunction::LessOrEqual);
         s_data.environmentShader->bind();
         s_data.skyboxMesh->vertexArray->bind();
         s_data.environment->getEnvMap()->bind();
         RenderCommand::renderIndexed(s_data.skyboxMesh->vertexArray);
-        glDepthFunc(GL_LESS);
+        RenderCommand::setDepthFunction(DepthFunction::Less);
     }
 }
 
 void Renderer3D::submit(const Reference<Mesh>& mesh, const math::mat4& transform)
 {
-    if (!s_data.sceneStarted)
-    {
-        Logger::getCoreLogger()->error("beginScene() must be called before executing draw calls!");
-    }
-
-    if (!mesh->material->shader)
-    {
-        return;
-    }
-
-    if (s_data.renderObjects.find(mesh->material) == s_data.renderObjects.end())
-    {
-        s_data.renderObjects.emplace(std::make_pair(mesh->material, std::vector<RenderObject>()));
-    }
-
-    s_data.renderObjects.at(mesh->material).push_back({ mesh, transform });
+    submit(mesh, transform, mesh->material);
 }
 
 void Renderer3D::submit(const Reference<Model>& model, const math::mat4& transform)
@@ -201,51 +599,40 @@ void Renderer3D::submit(const Reference<Model>& model, const math::mat4& transfo
     }
 }
 
-void Renderer3D::submit(const Reference<Mesh>& mesh, const math::mat4& transform, const Reference<Material>& material)
+void Renderer3D::submit(const Reference<Mesh>& mesh, const math::mat4& transform, const Reference<Material>& material, bool castShadows, bool isStatic)
 {
     if (!s_data.sceneStarted)
     {
         Logger::getCoreLogger()->error("beginScene() must be called before executing draw calls!");
     }
 
-    if (!material->shader)
+    if (!material || !material->shader)
     {
         return;
     }
 
-    if (s_data.renderObjects.find(material) == s_data.renderObjects.end())
-    {
-        s_data.renderObjects.emplace(std::make_pair(material, std::vector<RenderObject>()));
-    }
+    BoundingSphere bounds = mesh->boundingSphere.transformed(transform);
+
+    // Distance from the camera, mapped monotonically into [0, 1) for the sort key
+    math::vec3 position = bounds.isValid() ? bounds.center : math::vec3(transform[3]);
+    float dx = position.x - s_data.cameraPos.x;
+    float dy = position.y - s_data.cameraPos.y;
+    float dz = position.z - s_data.cameraPos.z;
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
 
-    s_data.renderObjects.at(material).push_back({ mesh, transform });
+    auto pass = material->isTransparent() ? RenderQueue::Pass::Transparent : RenderQueue::Pass::Opaque;
+    s_data.renderQueue.push(mesh, material, transform, bounds, pass, distance / (distance + 10.f), castShadows, isStatic);
 }
 
 void Renderer3D::submit(const Reference<InstancedRenderer>& instance)
 {
-    if (!s_data.sceneStarted)
-    {
-        Logger::getCoreLogger()->error("beginScene() must be called before executing draw calls!");
-    }
-
-    RenderCommand::setDepthTesting(true);
-
-    Reference<Material> lastMaterial = nullptr;
+    // Goes through the render queue like any other draw, prepareDraws() turns the copies into instanced commands
     for (auto& mesh : instance->getInstance())
     {
-        if (mesh->material != lastMaterial)
+        for (auto& renderingInstance : instance->getInstances())
         {
-            mesh->material->bind();
-            mesh->material->shader->setFloat("uExposure", Renderer::hdrExposure);
-            
-            setLightingUniforms(mesh->material->shader);
-
-            lastMaterial = mesh->material;
+            submit(mesh, renderingInstance.transform);
         }
-
-        mesh->vertexArray->bind();
-
-        RenderCommand::renderInstanced(mesh->vertexArray, instance->getInstances().size());
     }
 }
 
@@ -272,36 +659,57 @@ void Renderer3D::submitOutline(const Reference<Mesh>& mesh, const math::mat4& tr
     */
 }
 
-void Renderer3D::setLightingUniforms(const Reference<Shader>& shader)
+void Renderer3D::packLights()
 {
-    uint32_t pointLights = 0;
-    uint32_t directionalLights = 0;
+    s_data.lightBlock.clear();
+
     for (auto& light : s_data.lights)
     {
-        if (dynamic_cast<const PointLight*>(light))
-        {
-            light->setShaderUniforms(shader, pointLights);
-            pointLights++;
-        }
-        else if (dynamic_cast<const DirectionalLight*>(light))
-        {
-            light->setShaderUniforms(shader, 0);
+        light->pack(s_data.lightBlock);
+    }
+}
 
-            /*auto dirLight = static_cast<const DirectionalLight*>(light);
-            s_data.lightView = math::lookAt(dirLight->direction * 10, dirLight->direction, math::vec3(0, 1, 0));
-            s_data.lightMatrix = s_data.lightProjection * s_data.lightView;*/
+void Renderer3D::updateShadows(const math::mat4& view, const math::mat4& projection)
+{
+    s_data.usingShadows = s_data.lightBlock.header.numDirectionalLights > 0;
 
-            directionalLights++;
-        }
-        else if (dynamic_cast<const SkyLight*>(light))
-        {
-            light->setShaderUniforms(shader, 0);
-        }
-        
+    if (!s_data.usingShadows)
+    {
+        s_data.lightFrustum = s_data.cameraFrustum;
+        return;
+    }
+
+    s_data.shadowCascades.update(view, projection, s_data.lightBlock.header.directionalLights[0].direction);
+    s_data.lightFrustum = s_data.shadowCascades.getFrustum();
+}
+
+void Renderer3D::uploadLights()
+{
+    size_t pointLightsSize = s_data.lightBlock.pointLights.size() * sizeof(PointLightData);
+
+    s_data.lightData->reserve(sizeof(LightBlockHeader) + pointLightsSize);
+    s_data.lightData->setData(&s_data.lightBlock.header, sizeof(LightBlockHeader));
+
+    if (pointLightsSize > 0)
+    {
+        s_data.lightData->setData(s_data.lightBlock.pointLights.data(), pointLightsSize, sizeof(LightBlockHeader));
+    }
+
+    s_data.lightData->bindRange();
+
+    auto& clusters = s_data.lightClusters;
+    clusters.assign(s_data.lightBlock.pointLights, s_data.cameraView);
+
+    s_data.clusterData->setData(&clusters.getHeader(), sizeof(ClusterHeader));
+    s_data.clusterData->setData(clusters.getRanges().data(), clusters.getRanges().size() * sizeof(ClusterRange), sizeof(ClusterHeader));
+
+    if (!clusters.getLightIndices().empty())
+    {
+        s_data.lightIndexData->setData(clusters.getLightIndices().data(), clusters.getLightIndices().size() * sizeof(uint32_t));
     }
 
-    shader->setInt("uNumPointLights", pointLights);
-    shader->setInt("uUsingDirectionalLight", directionalLights); // TODO: multiple directional lights
+    s_data.clusterData->bindRange();
+    s_data.lightIndexData->bindRange();
 }
 
 void Renderer3D::removeLight(const BaseLight* light)
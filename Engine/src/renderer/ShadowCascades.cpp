@@ -0,0 +1,176 @@
+#include <renderer/ShadowCascades.h>
+#include <maths/matrix/matrix_transform.h>
+#include <maths/vector/vec_func.h>
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace Engine
+{
+
+static constexpr float MIN_NEAR = 0.01f;
+
+// Bounding sphere of the camera's view between two depths, in view space
+static void fitSphere(const math::vec3* nearCorners, bool perspective, float sliceNear, float sliceFar, math::vec3& center, float& radius)
+{
+    math::vec3 points[8];
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        const math::vec3& corner = nearCorners[i];
+
+        points[i] = perspective ? corner * (sliceNear / -corner.z) : math::vec3(corner.x, corner.y, -sliceNear);
+        points[i + 4] = perspective ? corner * (sliceFar / -corner.z) : math::vec3(corner.x, corner.y, -sliceFar);
+    }
+
+    center = math::vec3(0.f);
+
+    for (const auto& point : points)
+    {
+        center = center + point * 0.125f;
+    }
+
+    radius = 0.f;
+
+    for (const auto& point : points)
+    {
+        radius = std::max(radius, math::length(point - center));
+    }
+
+    // Rounded up so float noise can't change the cascade's size between frames
+    radius = std::ceil(radius * 16.f) / 16.f;
+}
+
+void ShadowCascades::update(const math::mat4& view, const math::mat4& projection, const math::vec3& direction)
+{
+    // Recover the clip planes, perspective projections have -1 in the w row
+    bool perspective = projection[2].w != 0.f;
+    float p22 = projection[2].z, p32 = projection[3].z;
+
+    float zNear = perspective ? p32 / (p22 - 1.f) : (p32 + 1.f) / p22;
+    float zFar = perspective ? p32 / (p22 + 1.f) : (p32 - 1.f) / p22;
+
+    zNear = std::max(zNear, MIN_NEAR);
+    zFar = std::max(std::min(zFar, MAX_DISTANCE), zNear * 2.f);
+
+    // Corners of the near plane, in view space
+    math::mat4 inverseProjection = math::inverse<float>(projection);
+    math::vec3 nearCorners[4];
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        math::vec4 corner = inverseProjection * math::vec4((i & 1) ? 1.f : -1.f, (i & 2) ? 1.f : -1.f, -1.f, 1.f);
+        nearCorners[i] = math::vec3(corner) / corner.w;
+    }
+
+    // Only the light's rotation, the cascades are positioned by their projections
+    math::vec3 forward = math::normalize(direction);
+    math::vec3 up = std::fabs(forward.y) > 0.99f ? math::vec3(0.f, 0.f, 1.f) : math::vec3(0.f, 1.f, 0.f);
+
+    math::mat4 lightView = math::lookAt(math::vec3(0.f), forward, up);
+    math::mat4 cameraToLight = lightView * math::inverse<float>(view);
+
+    float sliceNear = zNear;
+
+    for (uint32_t i = 0; i < CASCADE_COUNT; i++)
+    {
+        // Practical split scheme
+        float fraction = static_cast<float>(i + 1) / CASCADE_COUNT;
+        float logSplit = zNear * std::pow(zFar / zNear, fraction);
+        float uniformSplit = zNear + (zFar - zNear) * fraction;
+        float sliceFar = SPLIT_LAMBDA * logSplit + (1.f - SPLIT_LAMBDA) * uniformSplit;
+
+        math::vec3 center;
+        float radius;
+        fitSphere(nearCorners, perspective, sliceNear, sliceFar, center, radius);
+
+        // The map is enlarged by the snap step, so the sphere stays inside wherever the snapped center lands
+        uint32_t snapTexels = isCached(i) ? CACHED_SNAP_TEXELS : 1;
+        float texelSize = 2.f * radius / (MAP_SIZE - 2 * snapTexels);
+        float step = texelSize * snapTexels;
+        float extent = texelSize * MAP_SIZE * 0.5f;
+
+        math::vec3 lightCenter = math::vec3(cameraToLight * math::vec4(center, 1.f));
+        lightCenter.x = std::round(lightCenter.x / step) * step;
+        lightCenter.y = std::round(lightCenter.y / step) * step;
+        lightCenter.z = std::round(lightCenter.z / step) * step;
+
+        // The light looks down -z, casters in front of the cascade have a larger z
+        math::mat4 lightProjection = math::ortho(lightCenter.x - extent, lightCenter.x + extent,
+                                                 lightCenter.y - extent, lightCenter.y + extent,
+                                                 -(lightCenter.z + extent + CASTER_DISTANCE), -(lightCenter.z - extent));
+
+        math::mat4 matrix = lightProjection * lightView;
+        Cascade& cascade = m_cascades[i];
+
+        if (std::memcmp(math::buffer(matrix), math::buffer(cascade.matrix), sizeof(math::mat4)) != 0)
+        {
+            cascade.valid = false;
+        }
+
+        cascade.matrix = matrix;
+        cascade.frustum = Frustum::fromMatrix(matrix);
+
+        m_block.cascadeMatrices[i] = matrix;
+        (&m_block.cascadeSplits.x)[i] = sliceFar;
+        (&m_block.texelSizes.x)[i] = texelSize;
+
+        sliceNear = sliceFar;
+    }
+
+    // Everything that can cast into any cascade
+    math::vec3 center;
+    float radius;
+    fitSphere(nearCorners, perspective, zNear, zFar, center, radius);
+
+    math::vec3 lightCenter = math::vec3(cameraToLight * math::vec4(center, 1.f));
+    math::mat4 lightProjection = math::ortho(lightCenter.x - radius, lightCenter.x + radius,
+                                             lightCenter.y - radius, lightCenter.y + radius,
+                                             -(lightCenter.z + radius + CASTER_DISTANCE), -(lightCenter.z - radius));
+
+    m_frustum = Frustum::fromMatrix(lightProjection * lightView);
+}
+
+bool ShadowCascades::needsUpdate(uint32_t cascade, uint64_t casterHash)
+{
+    Cascade& data = m_cascades[cascade];
+
+    bool dirty = !data.valid || data.casterHash != casterHash;
+
+    data.valid = true;
+    data.casterHash = casterHash;
+
+    return dirty;
+}
+
+void ShadowCascades::invalidate()
+{
+    for (auto& cascade : m_cascades)
+    {
+        cascade.valid = false;
+    }
+}
+
+uint64_t ShadowCascades::hashCaster(const void* mesh, const math::mat4& transform)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+
+    auto append = [&hash](const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    append(&mesh, sizeof(mesh));
+    append(math::buffer(transform), sizeof(math::mat4));
+
+    return hash;
+}
+
+}
\ No newline at end of file
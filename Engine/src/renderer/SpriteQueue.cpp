@@ -0,0 +1,47 @@
+#include <renderer/SpriteQueue.h>
+#include <util/RadixSort.h>
+
+#include <cstring>
+#include <algorithm>
+
+namespace Engine
+{
+
+void SpriteQueue::clear()
+{
+    m_sprites.clear();
+    m_keys.clear();
+}
+
+void SpriteQueue::push(const Sprite& sprite, int32_t layer, float depth, Order order)
+{
+    m_keys.push_back(makeKey(layer, depth, sprite.texture->getId(), order));
+    m_sprites.push_back(sprite);
+}
+
+uint64_t SpriteQueue::makeKey(int32_t layer, float depth, uint32_t texture, Order order)
+{
+    // Signed layers are offset so negative layers sort first
+    layer = std::min(std::max(layer, static_cast<int32_t>(INT16_MIN)), static_cast<int32_t>(INT16_MAX));
+    uint64_t key = static_cast<uint64_t>(layer - INT16_MIN) << 48;
+
+    if (order == Order::Submission)
+    {
+        return key;
+    }
+
+    // Flipping the sign bit of positive floats and every bit of negative ones makes them compare as unsigned integers
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(float));
+    bits ^= (bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+
+    // Ids only need to group equal textures together; wrapping just costs an extra slot
+    return key | (static_cast<uint64_t>(bits) << 16) | (texture & 0xFFFF);
+}
+
+void SpriteQueue::sort()
+{
+    radixSort(m_keys, m_order, m_scratch);
+}
+
+}
\ No newline at end of file
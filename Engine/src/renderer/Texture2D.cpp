@@ -1,10 +1,10 @@
 #include <renderer/Texture2D.h>
 
 #include <util/Image.h>
+#include <util/CompressedImage.h>
 #include <platform/GL/GLTexture2D.h>
 
 #include <iostream>
-#include <thread>
 
 namespace Engine
 {
@@ -18,9 +18,25 @@ Reference<Texture2D> Texture2D::create(const Reference<Texture2D>& other)
 
 Reference<Texture2D> Texture2D::create(const std::string& file, bool clamp, bool linear, bool isSRGB)
 {
+    // Compressed files bring their own mip chain and color space
+    if (CompressedImage::isCompressedFile(file))
+    {
+        return createReference<GLTexture2D>(*CompressedImage::create(file, true), clamp, linear);
+    }
+
     return createReference<GLTexture2D>(file, clamp, linear, isSRGB);
 }
 
+Reference<Texture2D> Texture2D::create(const Image& image, bool clamp, bool linear, bool isSRGB)
+{
+    return createReference<GLTexture2D>(image, clamp, linear, isSRGB);
+}
+
+Reference<Texture2D> Texture2D::create(const CompressedImage& image, bool clamp, bool linear)
+{
+    return createReference<GLTexture2D>(image, clamp, linear);
+}
+
 Reference<Texture2D> Texture2D::create(uint32_t width, uint32_t height, SizedTextureFormat dataFormat, bool clamp, bool linear)
 {
     return createReference<GLTexture2D>(width, height, dataFormat, clamp, linear);
@@ -38,17 +54,4 @@ Reference<Texture2D> Texture2D::createWhiteTexture()
     return s_whiteTexture;
 }
 
-Reference<Texture2D> Texture2D::asyncCreate(const std::string& file, bool isSRGB)
-{
-    Reference<Image> img;
-    std::thread thr([&]
-    {
-        img = Image::create(file, true);
-    });
-    
-
-    Reference<Texture2D> texture = createReference<GLTexture2D>(img->getWidth(), img->getHeight());
-    texture->setData(0, 0, img->getWidth(), img->getHeight(), img->getData());
-}
-
 }
\ No newline at end of file
@@ -23,7 +23,6 @@ void ShaderLibrary::setupShaders()
     addShader("Engine/assets/shaders/EngineFX_Outline.glsl", "EngineFX_Outline");
     addShader("Engine/assets/shaders/EngineShadow_Map.glsl", "EngineShadow_Map");
     addShader("Engine/assets/shaders/EngineIBL_Environment.glsl", "EngineIBL_Environment");
-    addShader("Engine/assets/shaders/Engine2D_Text.glsl", "Engine2D_Text");
     addShader("Engine/assets/shaders/Engine2D_Texture.glsl", "Engine2D_Texture");
 }
 
@@ -1,95 +1,382 @@
 #include <renderer/text/TrueTypeFont.h>
 #include <core/Logger.h>
+#include <util/Timer.h>
 
 #include <algorithm>
+#include <cmath>
 
-#include <GL/glew.h>
 #include <ft2build.h>
 #include <freetype/freetype.h>
 
 namespace Engine
 {
 
+namespace Utils
+{
+    static constexpr double DISTANCE_INFINITY = 1e20;
+
+    // Squared distance transform of one row or column (Felzenszwalb and Huttenlocher), 'v' and 'z' are scratch space
+    void distanceTransform1D_(const double* f, double* d, int32_t n, int32_t* v, double* z)
+    {
+        int32_t k = 0;
+        v[0] = 0;
+        z[0] = -DISTANCE_INFINITY;
+        z[1] = DISTANCE_INFINITY;
+
+        for (int32_t q = 1; q < n; q++)
+        {
+            double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+
+            while (s <= z[k])
+            {
+                k--;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            }
+
+            k++;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = DISTANCE_INFINITY;
+        }
+
+        k = 0;
+        for (int32_t q = 0; q < n; q++)
+        {
+            while (z[k + 1] < q)
+            {
+                k++;
+            }
+
+            d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+        }
+    }
+
+    // Replaces every value with the squared distance to the nearest zero
+    void distanceTransform2D_(std::vector<double>& grid, int32_t width, int32_t height)
+    {
+        int32_t n = std::max(width, height);
+
+        std::vector<double> f(n);
+        std::vector<double> d(n);
+        std::vector<double> z(n + 1);
+        std::vector<int32_t> v(n);
+
+        for (int32_t x = 0; x < width; x++)
+        {
+            for (int32_t y = 0; y < height; y++)
+            {
+                f[y] = grid[y * width + x];
+            }
+
+            distanceTransform1D_(f.data(), d.data(), height, v.data(), z.data());
+
+            for (int32_t y = 0; y < height; y++)
+            {
+                grid[y * width + x] = d[y];
+            }
+        }
+
+        for (int32_t y = 0; y < height; y++)
+        {
+            distanceTransform1D_(&grid[y * width], d.data(), width, v.data(), z.data());
+            std::copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+        }
+    }
+
+    // Writes the distance field of a coverage bitmap, padded by 'spread' on every side, into 'field'.
+    // 0.5 is the outline, values fall off to 0 outside and rise to 1 inside over 'spread' pixels.
+    void generateDistanceField_(const uint8_t* coverage, int32_t pitch, int32_t width, int32_t height, int32_t spread,
+                                uint8_t* field, int32_t fieldStride)
+    {
+        int32_t fieldWidth = width + 2 * spread;
+        int32_t fieldHeight = height + 2 * spread;
+
+        auto sample = [&](int32_t x, int32_t y) -> uint8_t
+        {
+            x -= spread;
+            y -= spread;
+
+            if (x < 0 || y < 0 || x >= width || y >= height)
+            {
+                return 0;
+            }
+
+            return coverage[y * pitch + x];
+        };
+
+        std::vector<double> toInside(fieldWidth * fieldHeight);
+        std::vector<double> toOutside(fieldWidth * fieldHeight);
+
+        for (int32_t y = 0; y < fieldHeight; y++)
+        {
+            for (int32_t x = 0; x < fieldWidth; x++)
+            {
+                bool inside = sample(x, y) >= 128;
+
+                toInside[y * fieldWidth + x] = inside ? 0.0 : DISTANCE_INFINITY;
+                toOutside[y * fieldWidth + x] = inside ? DISTANCE_INFINITY : 0.0;
+            }
+        }
+
+        distanceTransform2D_(toInside, fieldWidth, fieldHeight);
+        distanceTransform2D_(toOutside, fieldWidth, fieldHeight);
+
+        for (int32_t y = 0; y < fieldHeight; y++)
+        {
+            for (int32_t x = 0; x < fieldWidth; x++)
+            {
+                uint8_t value = sample(x, y);
+                double distance;
+
+                // Anti-aliased pixels lie on the outline, their coverage places it more precisely than the transform
+                if (value > 0 && value < 255)
+                {
+                    distance = value / 255.0 - 0.5;
+                }
+                else if (value >= 128)
+                {
+                    distance = std::sqrt(toOutside[y * fieldWidth + x]) - 0.5;
+                }
+                else
+                {
+                    distance = 0.5 - std::sqrt(toInside[y * fieldWidth + x]);
+                }
+
+                double normalized = std::clamp(0.5 + distance / (2.0 * spread), 0.0, 1.0);
+                field[y * fieldStride + x] = static_cast<uint8_t>(normalized * 255.0 + 0.5);
+            }
+        }
+    }
+}
+
 TrueTypeFont::TrueTypeFont()
 {
-    
+
+}
+
+TrueTypeFont::~TrueTypeFont()
+{
+    release_();
 }
 
-Reference<TrueTypeFont> TrueTypeFont::create(const std::string& path, int characterSize)
+Reference<TrueTypeFont> TrueTypeFont::create(const std::string& path, int characterSize, uint32_t atlasSize)
 {
     auto ptr = createReference<TrueTypeFont>();
-    ptr->load(path, characterSize);
+    ptr->load(path, characterSize, atlasSize);
     return ptr;
 }
 
-void TrueTypeFont::load(const std::string& path, int characterSize)
+void TrueTypeFont::load(const std::string& path, int characterSize, uint32_t atlasSize)
 {
-    m_characterSize = characterSize;
+    release_();
 
-    FT_Library library;
-    FT_Face face;
+    m_characterSize = characterSize;
 
-    if (FT_Init_FreeType(&library))
+    if (FT_Init_FreeType(&m_library))
     {
         Logger::getCoreLogger()->error("Could not initialize FreeType.");
+        m_library = nullptr;
         return;
     }
 
-    if (FT_New_Face(library, path.c_str(), 0, &face))
+    if (FT_New_Face(m_library, path.c_str(), 0, &m_face))
     {
-        Logger::getCoreLogger()->error("Could not load font: %s", path);
+        Logger::getCoreLogger()->error("Could not load font: %s", path.c_str());
+        m_face = nullptr;
+        release_();
         return;
     }
 
-    FT_Set_Pixel_Sizes(face, 0, characterSize);
+    FT_Set_Pixel_Sizes(m_face, 0, GLYPH_SIZE);
+
+    m_cellsPerRow = std::max(atlasSize / CELL_SIZE, 1u);
+    atlasSize = m_cellsPerRow * CELL_SIZE;
+
+    m_texture = Texture2D::create(atlasSize, atlasSize, SizedTextureFormat::R8, true, true);
+    m_cellData.assign(CELL_SIZE * CELL_SIZE, 0);
+
+    uint32_t cellCount = m_cellsPerRow * m_cellsPerRow;
+
+    // Handed out from the back, so the atlas fills from its first cell
+    m_freeCells.resize(cellCount);
+    for (uint32_t i = 0; i < cellCount; i++)
+    {
+        m_freeCells[i] = cellCount - 1 - i;
+    }
+
+    m_statistics = FontStatistics();
+    m_statistics.capacity = cellCount;
+    m_statistics.atlasMemory = static_cast<size_t>(atlasSize) * atlasSize;
+
+    // Printable ASCII is almost always needed, so it is generated up front
+    for (uint32_t codePoint = 32; codePoint < 127; codePoint++)
+    {
+        getGlyph(codePoint);
+    }
+}
+
+void TrueTypeFont::release_()
+{
+    if (m_face)
+    {
+        FT_Done_Face(m_face);
+        m_face = nullptr;
+    }
+
+    if (m_library)
+    {
+        FT_Done_FreeType(m_library);
+        m_library = nullptr;
+    }
+
+    m_texture.reset();
+    m_glyphs.clear();
+    m_recent.clear();
+    m_freeCells.clear();
+    m_statistics = FontStatistics();
+}
 
-    FT_GlyphSlot g = face->glyph;
-    int w = 0;
-    int h = 0;
+const Glyph* TrueTypeFont::getGlyph(uint32_t codePoint)
+{
+    auto found = m_glyphs.find(codePoint);
 
-    for (unsigned int i = 32; i < 255; i++)
+    if (found != m_glyphs.end())
     {
-        if (FT_Load_Char(face, i, FT_LOAD_RENDER))
+        CachedGlyph& cached = found->second;
+
+        if (cached.cell != NO_CELL)
         {
-            Logger::getCoreLogger()->error("Could not load character: %s" + static_cast<char>(i));
+            m_recent.splice(m_recent.begin(), m_recent, cached.recent);
+            cached.lastUsed = s_frame;
         }
 
-        w += g->bitmap.width;
-        h = std::max(h, static_cast<int>(g->bitmap.rows));
+        m_statistics.hits++;
+        return &cached.glyph;
+    }
+
+    m_statistics.misses++;
+
+    if (!m_face)
+    {
+        return nullptr;
     }
 
-    m_atlasSize.x = w;
-    m_atlasSize.y = h;
+    Glyph glyph = {};
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    m_texture = Texture2D::create(m_atlasSize.x, m_atlasSize.y, SizedTextureFormat::RGBA8, true, false);
+    Timer timer;
+    bool loaded = rasterize_(codePoint, glyph);
+    m_statistics.rasterizeMillis += timer.getMillis();
 
-    int x = 0;
-    for (unsigned int i = 32; i < 255; i++)
+    // Failed and empty glyphs are cached without a cell, so they aren't loaded again
+    if (!loaded || glyph.size.x == 0 || glyph.size.y == 0)
     {
-        if (FT_Load_Char(face, i, FT_LOAD_RENDER))
+        if (!loaded)
         {
-            continue;
+            glyph = {};
         }
 
-        m_texture->setData(x, 0, g->bitmap.width, g->bitmap.rows, g->bitmap.buffer, TextureFormat::Red);
+        CachedGlyph& cached = m_glyphs[codePoint];
+        cached.glyph = glyph;
+        return &cached.glyph;
+    }
+
+    uint32_t cell = acquireCell_();
+
+    if (cell == NO_CELL)
+    {
+        m_statistics.dropped++;
+        return nullptr;
+    }
+
+    uint32_t cellX = (cell % m_cellsPerRow) * CELL_SIZE;
+    uint32_t cellY = (cell / m_cellsPerRow) * CELL_SIZE;
+    float atlasSize = static_cast<float>(m_cellsPerRow * CELL_SIZE);
+
+    // The whole cell is uploaded, which also clears what the previous glyph left around this one
+    m_texture->setData(cellX, cellY, CELL_SIZE, CELL_SIZE, m_cellData.data(), TextureFormat::Red);
 
-        m_glyphs[i].advance.x = g->advance.x >> 6;
-        m_glyphs[i].advance.y = g->advance.y >> 6;
+    glyph.texRect.x = cellX / atlasSize;
+    glyph.texRect.y = cellY / atlasSize;
+    glyph.texRect.z = (cellX + glyph.size.x) / atlasSize;
+    glyph.texRect.w = (cellY + glyph.size.y) / atlasSize;
 
-        m_glyphs[i].size.x = g->bitmap.width;
-        m_glyphs[i].size.y = g->bitmap.rows;
+    m_recent.push_front(codePoint);
 
-        m_glyphs[i].pos.x = g->bitmap_left;
-        m_glyphs[i].pos.y = g->bitmap_top;
+    CachedGlyph& cached = m_glyphs[codePoint];
+    cached.glyph = glyph;
+    cached.cell = cell;
+    cached.lastUsed = s_frame;
+    cached.recent = m_recent.begin();
 
-        m_glyphs[i].texOffset = static_cast<float>(x) / m_atlasSize.x;
+    m_statistics.rasterized++;
+    m_statistics.residentGlyphs = static_cast<uint32_t>(m_recent.size());
 
-        x += g->bitmap.width;
+    return &cached.glyph;
+}
+
+bool TrueTypeFont::rasterize_(uint32_t codePoint, Glyph& glyph)
+{
+    if (FT_Load_Char(m_face, codePoint, FT_LOAD_RENDER))
+    {
+        return false;
+    }
+
+    FT_GlyphSlot slot = m_face->glyph;
+
+    glyph.advance.x = slot->advance.x / 64.f;
+    glyph.advance.y = slot->advance.y / 64.f;
+
+    // Glyphs taller or wider than the cell allows are cut off
+    int32_t maxSize = CELL_SIZE - 2 * SPREAD;
+    int32_t width = std::min(static_cast<int32_t>(slot->bitmap.width), maxSize);
+    int32_t height = std::min(static_cast<int32_t>(slot->bitmap.rows), maxSize);
+
+    if (width == 0 || height == 0 || slot->bitmap.pixel_mode != FT_PIXEL_MODE_GRAY)
+    {
+        return true;
+    }
+
+    std::fill(m_cellData.begin(), m_cellData.end(), 0);
+    Utils::generateDistanceField_(slot->bitmap.buffer, slot->bitmap.pitch, width, height, SPREAD, m_cellData.data(), CELL_SIZE);
+
+    glyph.size.x = static_cast<float>(width + 2 * SPREAD);
+    glyph.size.y = static_cast<float>(height + 2 * SPREAD);
+
+    glyph.pos.x = static_cast<float>(slot->bitmap_left - static_cast<int32_t>(SPREAD));
+    glyph.pos.y = static_cast<float>(slot->bitmap_top + static_cast<int32_t>(SPREAD));
+
+    return true;
+}
+
+uint32_t TrueTypeFont::acquireCell_()
+{
+    if (!m_freeCells.empty())
+    {
+        uint32_t cell = m_freeCells.back();
+        m_freeCells.pop_back();
+        return cell;
+    }
+
+    if (m_recent.empty())
+    {
+        return NO_CELL;
     }
 
-    FT_Done_Face(face);
-    FT_Done_FreeType(library);
+    // Sprites queued this frame still point at the glyphs used this frame
+    auto evicted = m_glyphs.find(m_recent.back());
+
+    if (evicted->second.lastUsed == s_frame)
+    {
+        return NO_CELL;
+    }
+
+    uint32_t cell = evicted->second.cell;
+
+    m_recent.pop_back();
+    m_glyphs.erase(evicted);
+    m_statistics.evicted++;
+
+    return cell;
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,443 @@
+#include <scene/BoundingVolumeHierarchy.h>
+#include <core/Logger.h>
+
+namespace Engine
+{
+
+static AABB combine(const AABB& a, const AABB& b)
+{
+    AABB box = a;
+    box.expand(b);
+    return box;
+}
+
+static float surfaceArea(const AABB& box)
+{
+    float dx = box.max.x - box.min.x;
+    float dy = box.max.y - box.min.y;
+    float dz = box.max.z - box.min.z;
+
+    return 2.f * (dx * dy + dy * dz + dz * dx);
+}
+
+static bool contains(const AABB& outer, const AABB& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z
+        && outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+static bool overlaps(const AABB& a, const AABB& b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x
+        && a.min.y <= b.max.y && a.max.y >= b.min.y
+        && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+static bool overlaps(const AABB& box, const BoundingSphere& sphere)
+{
+    // Squared distance from the sphere centre to the closest point on the box
+    float dx = std::max(box.min.x - sphere.center.x, std::max(0.f, sphere.center.x - box.max.x));
+    float dy = std::max(box.min.y - sphere.center.y, std::max(0.f, sphere.center.y - box.max.y));
+    float dz = std::max(box.min.z - sphere.center.z, std::max(0.f, sphere.center.z - box.max.z));
+
+    return dx * dx + dy * dy + dz * dz <= sphere.radius * sphere.radius;
+}
+
+// Slab test. Returns the entry distance, or a negative value on a miss.
+static float intersectRay(const AABB& box, const math::vec3& origin, const math::vec3& inverseDirection, float maxDistance)
+{
+    float t1 = (box.min.x - origin.x) * inverseDirection.x;
+    float t2 = (box.max.x - origin.x) * inverseDirection.x;
+    float tmin = std::min(t1, t2), tmax = std::max(t1, t2);
+
+    t1 = (box.min.y - origin.y) * inverseDirection.y;
+    t2 = (box.max.y - origin.y) * inverseDirection.y;
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+
+    t1 = (box.min.z - origin.z) * inverseDirection.z;
+    t2 = (box.max.z - origin.z) * inverseDirection.z;
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+
+    if (tmax < std::max(tmin, 0.f) || tmin > maxDistance)
+    {
+        return -1.f;
+    }
+
+    return std::max(tmin, 0.f);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+{
+
+}
+
+uint32_t BoundingVolumeHierarchy::allocateNode_()
+{
+    if (m_freeList == NULL_NODE)
+    {
+        m_nodes.emplace_back();
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    uint32_t index = m_freeList;
+    m_freeList = m_nodes[index].parent;
+    m_nodes[index] = Node();
+
+    return index;
+}
+
+void BoundingVolumeHierarchy::freeNode_(uint32_t index)
+{
+    m_nodes[index] = Node();
+    m_nodes[index].parent = m_freeList;
+    m_freeList = index;
+}
+
+uint32_t BoundingVolumeHierarchy::insert(const AABB& box, GameObject* object)
+{
+    uint32_t proxy = allocateNode_();
+
+    Node& node = m_nodes[proxy];
+    node.tight = box;
+    node.box = box;
+    node.box.min = math::vec3(box.min.x - FAT_MARGIN, box.min.y - FAT_MARGIN, box.min.z - FAT_MARGIN);
+    node.box.max = math::vec3(box.max.x + FAT_MARGIN, box.max.y + FAT_MARGIN, box.max.z + FAT_MARGIN);
+    node.object = object;
+    node.height = 0;
+
+    insertLeaf_(proxy);
+    m_count++;
+
+    return proxy;
+}
+
+void BoundingVolumeHierarchy::remove(uint32_t proxy)
+{
+    if (proxy >= m_nodes.size() || !m_nodes[proxy].isLeaf() || m_nodes[proxy].height != 0)
+    {
+        Logger::getCoreLogger()->error("Invalid BVH proxy (%u)!", proxy);
+        return;
+    }
+
+    removeLeaf_(proxy);
+    freeNode_(proxy);
+    m_count--;
+}
+
+bool BoundingVolumeHierarchy::move(uint32_t proxy, const AABB& box)
+{
+    Node& node = m_nodes[proxy];
+    node.tight = box;
+
+    if (contains(node.box, box))
+    {
+        return false;
+    }
+
+    removeLeaf_(proxy);
+
+    node.box.min = math::vec3(box.min.x - FAT_MARGIN, box.min.y - FAT_MARGIN, box.min.z - FAT_MARGIN);
+    node.box.max = math::vec3(box.max.x + FAT_MARGIN, box.max.y + FAT_MARGIN, box.max.z + FAT_MARGIN);
+
+    insertLeaf_(proxy);
+
+    return true;
+}
+
+void BoundingVolumeHierarchy::insertLeaf_(uint32_t leaf)
+{
+    if (m_root == NULL_NODE)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Walk down picking the child that grows the least (surface area heuristic)
+    AABB leafBox = m_nodes[leaf].box;
+    uint32_t index = m_root;
+
+    while (!m_nodes[index].isLeaf())
+    {
+        const Node& node = m_nodes[index];
+
+        float area = surfaceArea(node.box);
+        float combinedArea = surfaceArea(combine(node.box, leafBox));
+
+        // Cost of making a new parent for this node and the leaf
+        float cost = 2.f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down
+        float inheritanceCost = 2.f * (combinedArea - area);
+
+        auto childCost = [&](uint32_t child)
+        {
+            const Node& c = m_nodes[child];
+            float grown = surfaceArea(combine(c.box, leafBox));
+
+            return c.isLeaf() ? grown + inheritanceCost : grown - surfaceArea(c.box) + inheritanceCost;
+        };
+
+        float cost1 = childCost(node.child1);
+        float cost2 = childCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    uint32_t sibling = index;
+
+    // New parent for the sibling and the leaf
+    uint32_t oldParent = m_nodes[sibling].parent;
+    uint32_t newParent = allocateNode_();
+
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].box = combine(leafBox, m_nodes[sibling].box);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE)
+    {
+        if (m_nodes[oldParent].child1 == sibling)
+        {
+            m_nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            m_nodes[oldParent].child2 = newParent;
+        }
+    }
+    else
+    {
+        m_root = newParent;
+    }
+
+    // Refit and rebalance the ancestors
+    index = m_nodes[leaf].parent;
+    while (index != NULL_NODE)
+    {
+        index = balance_(index);
+
+        Node& node = m_nodes[index];
+        node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+        node.box = combine(m_nodes[node.child1].box, m_nodes[node.child2].box);
+
+        index = node.parent;
+    }
+}
+
+void BoundingVolumeHierarchy::removeLeaf_(uint32_t leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    uint32_t parent = m_nodes[leaf].parent;
+    uint32_t grandParent = m_nodes[parent].parent;
+    uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent == NULL_NODE)
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode_(parent);
+        return;
+    }
+
+    // Replace the parent with the sibling
+    if (m_nodes[grandParent].child1 == parent)
+    {
+        m_nodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        m_nodes[grandParent].child2 = sibling;
+    }
+
+    m_nodes[sibling].parent = grandParent;
+    freeNode_(parent);
+
+    uint32_t index = grandParent;
+    while (index != NULL_NODE)
+    {
+        index = balance_(index);
+
+        Node& node = m_nodes[index];
+        node.box = combine(m_nodes[node.child1].box, m_nodes[node.child2].box);
+        node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+
+        index = node.parent;
+    }
+}
+
+// Rotates the taller grandchild up if the subtree at 'a' is out of balance. Returns the subtree's new root.
+uint32_t BoundingVolumeHierarchy::balance_(uint32_t a)
+{
+    Node& A = m_nodes[a];
+
+    if (A.isLeaf() || A.height < 2)
+    {
+        return a;
+    }
+
+    uint32_t b = A.child1;
+    uint32_t c = A.child2;
+
+    int32_t balance = m_nodes[c].height - m_nodes[b].height;
+
+    auto rotate = [&](uint32_t up, uint32_t other)
+    {
+        // 'up' (a child of a) becomes the parent of a
+        Node& U = m_nodes[up];
+        uint32_t f = U.child1;
+        uint32_t g = U.child2;
+
+        U.child1 = a;
+        U.parent = A.parent;
+        A.parent = up;
+
+        if (U.parent != NULL_NODE)
+        {
+            if (m_nodes[U.parent].child1 == a)
+            {
+                m_nodes[U.parent].child1 = up;
+            }
+            else
+            {
+                m_nodes[U.parent].child2 = up;
+            }
+        }
+        else
+        {
+            m_root = up;
+        }
+
+        // Keep the taller of f/g under 'up', move the other under a
+        uint32_t keep = m_nodes[f].height > m_nodes[g].height ? f : g;
+        uint32_t give = keep == f ? g : f;
+
+        U.child2 = keep;
+
+        if (A.child1 == up)
+        {
+            A.child1 = give;
+        }
+        else
+        {
+            A.child2 = give;
+        }
+
+        m_nodes[give].parent = a;
+
+        A.box = combine(m_nodes[other].box, m_nodes[give].box);
+        A.height = 1 + std::max(m_nodes[other].height, m_nodes[give].height);
+
+        U.box = combine(A.box, m_nodes[keep].box);
+        U.height = 1 + std::max(A.height, m_nodes[keep].height);
+
+        return up;
+    };
+
+    if (balance > 1)
+    {
+        return rotate(c, b);
+    }
+
+    if (balance < -1)
+    {
+        return rotate(b, c);
+    }
+
+    return a;
+}
+
+int32_t BoundingVolumeHierarchy::getHeight() const
+{
+    return m_root == NULL_NODE ? 0 : m_nodes[m_root].height;
+}
+
+void BoundingVolumeHierarchy::queryFrustum(const Frustum& frustum, std::vector<GameObject*>& objects) const
+{
+    query([&frustum](const AABB& box) { return frustum.intersects(box); },
+          [&objects](GameObject* object, const AABB&) { objects.push_back(object); });
+}
+
+void BoundingVolumeHierarchy::queryBox(const AABB& box, std::vector<GameObject*>& objects) const
+{
+    query([&box](const AABB& other) { return overlaps(box, other); },
+          [&objects](GameObject* object, const AABB&) { objects.push_back(object); });
+}
+
+void BoundingVolumeHierarchy::querySphere(const BoundingSphere& sphere, std::vector<GameObject*>& objects) const
+{
+    query([&sphere](const AABB& box) { return overlaps(box, sphere); },
+          [&objects](GameObject* object, const AABB&) { objects.push_back(object); });
+}
+
+GameObject* BoundingVolumeHierarchy::raycast(const math::vec3& origin, const math::vec3& direction, float maxDistance, float* distance) const
+{
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+
+    if (m_root == NULL_NODE || length == 0.f)
+    {
+        return nullptr;
+    }
+
+    // Division by zero gives +-inf, which the slab test handles
+    math::vec3 inverseDirection(length / direction.x, length / direction.y, length / direction.z);
+
+    GameObject* closest = nullptr;
+    float closestDistance = maxDistance;
+
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (intersectRay(node.box, origin, inverseDirection, closestDistance) < 0.f)
+        {
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            float t = intersectRay(node.tight, origin, inverseDirection, closestDistance);
+
+            if (t >= 0.f && t <= closestDistance)
+            {
+                closest = node.object;
+                closestDistance = t;
+            }
+        }
+        else
+        {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+
+    if (closest && distance)
+    {
+        *distance = closestDistance;
+    }
+
+    return closest;
+}
+
+}
\ No newline at end of file
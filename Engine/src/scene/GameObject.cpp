@@ -7,7 +7,17 @@ namespace Engine
 GameObject::GameObject(GameObject* parent)
     : m_parent(parent)
 {
-    m_components.clear();
+    m_storage = parent ? parent->m_storage : createReference<ComponentStorage>();
+
+    if (parent)
+    {
+        parent->markTransformsDirty_();
+    }
+    else
+    {
+        m_handle = { GameObjectHandle::ROOT_INDEX, 0 };
+        m_storage->getObjects().setRoot(this);
+    }
 }
 
 GameObject::~GameObject()
@@ -22,76 +32,173 @@ GameObject* GameObject::getParent() const
 
 void GameObject::onTransformChange(const Transform& transform)
 {
-    for (auto& child : m_children)
+    for (auto& slot : m_components)
     {
-        child->onTransformChange(transform);
+        if (slot.component && slot.component != &transform)
+        {
+            slot.component->onTransformChange(transform);
+        }
     }
-    
-    for (auto& component : m_components)
+}
+
+void GameObject::updateTransforms()
+{
+    updateTransforms_(nullptr);
+}
+
+void GameObject::updateTransforms(std::vector<GameObject*>& changed)
+{
+    updateTransforms_(&changed);
+}
+
+void GameObject::updateTransforms_(std::vector<GameObject*>* changed)
+{
+    if (!m_transformsDirty)
     {
-        if (component.first != typeid(Transform))
+        return;
+    }
+
+    m_transformsDirty = false;
+
+    auto transform = getComponent<Transform>();
+    if (transform && transform->m_changed)
+    {
+        transform->updateWorld_();
+        transform->m_changed = false;
+
+        if (changed)
         {
-            component.second->onTransformChange(transform);
+            changed->push_back(this);
         }
+        else
+        {
+            onTransformChange(*transform);
+            m_storage->onTransformChanged(this);
+        }
+    }
+
+    for (auto child : m_children)
+    {
+        child->updateTransforms_(changed);
     }
+}
 
-    if (getComponent<Transform>() != &transform)
-        getComponent<Transform>()->onTransformChange(transform);
+void GameObject::markTransformsDirty_()
+{
+    for (GameObject* object = this; object != nullptr && !object->m_transformsDirty; object = object->m_parent)
+    {
+        object->m_transformsDirty = true;
+    }
+}
+
+void GameObject::invalidateChildTransforms_()
+{
+    for (auto child : m_children)
+    {
+        child->m_transformsDirty = true;
+
+        if (auto transform = child->getComponent<Transform>())
+        {
+            transform->invalidateWorld_();
+        }
+        else
+        {
+            child->invalidateChildTransforms_();
+        }
+    }
 }
 
 void GameObject::removeChild(GameObject* child)
 {
-    child->destroy_();
+    if (child->m_parent != this || child->m_childIndex >= m_children.size() || m_children[child->m_childIndex] != child)
+        return;
+
+    GameObject* last = m_children.back();
+    last->m_childIndex = child->m_childIndex;
+    m_children[child->m_childIndex] = last;
+    m_children.pop_back();
 
-    auto it = std::find(m_children.begin(), m_children.end(), child);
-    if (it != m_children.end())
-        m_children.erase(it);
+    child->destroy_();
+    m_storage->getObjects().destroy(child);
 }
 
 GameObject* GameObject::createChild()
 {
-    auto object = new GameObject(this);
+    auto object = m_storage->getObjects().create(this);
     object->createComponent<Transform>();
+    object->m_childIndex = static_cast<uint32_t>(m_children.size());
     m_children.push_back(object);
     return m_children.back();
 }
 
-std::vector<GameObject*> GameObject::getChildren()
+std::vector<GameObject*> GameObject::getChildrenRecursive()
 {
-    return m_children;
+    std::vector<GameObject*> children;
+    collectChildren_(children);
+    return children;
 }
 
-std::vector<GameObject*> GameObject::getChildrenRecursive()
+void GameObject::collectChildren_(std::vector<GameObject*>& children) const
 {
-    std::vector<GameObject*> children;
+    for (auto child : m_children)
+    {
+        children.push_back(child);
+        child->collectChildren_(children);
+    }
+}
 
-    std::function<void(GameObject*)> recurse;
-    recurse = [&children, &recurse](GameObject* current)
+void GameObject::setComponent_(ComponentId id, GameComponent* component, IComponentPool* pool)
+{
+    if (id >= m_components.size())
     {
-        for (auto child : current->getChildren())
-        {
-            children.push_back(child);
-            recurse(child);
-        }
-    };
+        m_components.resize(id + 1);
+    }
 
-    recurse(this);
+    component->setOwner(m_handle, &m_storage->getObjects());
+    m_components[id] = { component, pool };
 
-    return children;
+    if (!pool)
+    {
+        m_storage->onHeapComponentAdded_(id);
+    }
+
+    m_storage->onComponentsChanged(this, id);
+}
+
+void GameObject::releaseComponent_(ComponentId id)
+{
+    auto& slot = m_components[id];
+
+    if (slot.pool)
+    {
+        slot.pool->release(slot.component);
+    }
+    else
+    {
+        delete slot.component;
+        m_storage->onHeapComponentRemoved_(id);
+    }
+
+    slot = ComponentSlot();
+
+    m_storage->onComponentsChanged(this, id);
 }
 
 void GameObject::destroy_()
 {
-    for (auto& component : m_components)
+    for (ComponentId id = 0; id < m_components.size(); id++)
     {
-        delete component.second;
+        if (m_components[id].component)
+        {
+            releaseComponent_(id);
+        }
     }
     m_components.clear();
 
     for (auto& child : m_children)
     {
         child->destroy_();
-        delete child;
+        m_storage->getObjects().destroy(child);
     }
     m_children.clear();
 }
@@ -0,0 +1,104 @@
+#include <scene/GameObjectPool.h>
+#include <scene/GameObject.h>
+
+#include <new>
+
+namespace Engine
+{
+
+struct GameObjectPool::Chunk
+{
+    alignas(GameObject) unsigned char data[CHUNK_SIZE * sizeof(GameObject)];
+    bool alive[CHUNK_SIZE] = {};
+};
+
+GameObjectPool::~GameObjectPool()
+{
+    for (uint32_t i = 0; i < m_generations.size(); i++)
+    {
+        if (m_chunks[i / CHUNK_SIZE]->alive[i % CHUNK_SIZE])
+        {
+            at(i)->~GameObject();
+        }
+    }
+
+    for (auto chunk : m_chunks)
+    {
+        delete chunk;
+    }
+}
+
+GameObject* GameObjectPool::create(GameObject* parent)
+{
+    uint32_t index;
+
+    if (!m_freeList.empty())
+    {
+        index = m_freeList.back();
+        m_freeList.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_generations.size());
+
+        if (index == m_chunks.size() * CHUNK_SIZE)
+        {
+            m_chunks.push_back(new Chunk());
+        }
+
+        m_generations.push_back(0);
+    }
+
+    GameObject* object = new (at(index)) GameObject(parent);
+    object->m_handle = { index, m_generations[index] };
+
+    m_chunks[index / CHUNK_SIZE]->alive[index % CHUNK_SIZE] = true;
+    m_count++;
+
+    return object;
+}
+
+void GameObjectPool::destroy(GameObject* object)
+{
+    uint32_t index = object->m_handle.index;
+
+    if (index >= m_generations.size() || at(index) != object || !m_chunks[index / CHUNK_SIZE]->alive[index % CHUNK_SIZE])
+    {
+        Logger::getCoreLogger()->error("GameObject does not belong to this pool!");
+        return;
+    }
+
+    object->~GameObject();
+
+    m_chunks[index / CHUNK_SIZE]->alive[index % CHUNK_SIZE] = false;
+    m_generations[index]++;
+    m_freeList.push_back(index);
+    m_count--;
+}
+
+GameObject* GameObjectPool::get(GameObjectHandle handle) const
+{
+    if (handle.index == GameObjectHandle::ROOT_INDEX)
+    {
+        return m_root;
+    }
+
+    if (handle.index >= m_generations.size() || m_generations[handle.index] != handle.generation)
+    {
+        return nullptr;
+    }
+
+    return m_chunks[handle.index / CHUNK_SIZE]->alive[handle.index % CHUNK_SIZE] ? at(handle.index) : nullptr;
+}
+
+GameObject* GameObjectPool::at(uint32_t index) const
+{
+    return reinterpret_cast<GameObject*>(m_chunks[index / CHUNK_SIZE]->data) + (index % CHUNK_SIZE);
+}
+
+GameObject* GameObjectPool::getAlive_(uint32_t index) const
+{
+    return m_chunks[index / CHUNK_SIZE]->alive[index % CHUNK_SIZE] ? at(index) : nullptr;
+}
+
+}
\ No newline at end of file
@@ -20,9 +20,9 @@ void GameSerializer::saveProject(const std::string& path)
     {
         YAML::Node matNode;
 
-        matNode["uuid"] = material.first;
+        matNode["uuid"] = material.getKey();
 
-        std::ofstream fout(path + "/Materials/" + material.second->name + ".material");
+        std::ofstream fout(path + "/Materials/" + material.get()->name + ".material");
         fout << matNode;
     }
 
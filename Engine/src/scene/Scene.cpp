@@ -4,6 +4,7 @@
 #include <renderer/Renderer3D.h>
 #include <scene/Components.h>
 #include <scene/NativeScript.h>
+#include <scene/Systems.h>
 #include <script/ScriptController.h>
 #include <scene/SceneCamera.h>
 #include <util/Timer.h>
@@ -14,16 +15,24 @@ namespace Engine
 {
 
 Scene::Scene()
+    : m_systems(*this)
 {
-    
+    m_systems.addSystem<NativeScriptSystem>();
+    m_systems.addSystem<ScriptSystem>();
+    m_systems.addSystem<TransformSystem>();
+    m_systems.addSystem<LightSystem>();
+
+    m_rootObject.getStorage().addListener(&m_spatialIndex);
 }
 
 Scene::~Scene()
 {
-    for (auto child : m_rootObject.getChildren())
+    while (!m_rootObject.getChildren().empty())
     {
-        m_rootObject.removeChild(child);
+        m_rootObject.removeChild(m_rootObject.getChildren().back());
     }
+
+    m_rootObject.getStorage().removeListener(&m_spatialIndex);
 }
 
 Reference<Scene> Scene::create()
@@ -34,6 +43,9 @@ Reference<Scene> Scene::create()
 
 void Scene::onUpdateEditor(float dt, EditorCamera& camera)
 {
+    m_rootObject.updateTransforms();
+    m_spatialIndex.update();
+
     this->setLights();
 
     Renderer3D::beginScene(camera);
@@ -57,6 +69,7 @@ void Scene::recurseRender2D(GameObject* object)
 
         math::frect textureRect = sprite->usingTexRect ? sprite->textureRect : math::frect(0, 0, sprite->texture->getWidth(), sprite->texture->getHeight());
 
+        Renderer2D::setLayer(sprite->layer);
         Renderer2D::renderSprite(sprite->texture, transform, textureRect);
     }
 
@@ -66,41 +79,36 @@ void Scene::recurseRender2D(GameObject* object)
     }
 }
 
-void Scene::recurseRender3D(GameObject* object)
+void Scene::render3DEntities()
 {
-    if (object->hasComponents<MeshComponent, Transform, MeshRendererComponent>())
-    {
-        auto& mesh = object->getComponent<MeshComponent>()->mesh;
-        auto transform = object->getComponent<Transform>()->worldMatrix();
-        auto& material = object->getComponent<MeshRendererComponent>()->material;
+    // Only objects in view of the camera or the shadow casting light. Renderer3D culls each pass more tightly.
+    const Frustum& cameraFrustum = Renderer3D::getCameraFrustum();
+    const Frustum& lightFrustum = Renderer3D::getLightFrustum();
 
-        if (material && mesh)
+    m_spatialIndex.query([&](const AABB& box)
+    {
+        return cameraFrustum.intersects(box) || lightFrustum.intersects(box);
+    },
+    [](GameObject* object)
+    {
+        if (!object->hasComponent<MeshRendererComponent>())
         {
-            Renderer3D::submit(mesh, transform, material);
+            return;
         }
-    }
-
-    for (auto& child : object->getChildren())
-    {
-        recurseRender3D(child);
-    }
-}
 
-void Scene::render3DEntities()
-{
-    auto objects = m_rootObject.getChildren();
+        auto& mesh = object->getComponent<MeshComponent>()->mesh;
+        auto renderer = object->getComponent<MeshRendererComponent>();
 
-    for (auto& object : objects)
-    {
-        recurseRender3D(object);
-    }
+        if (renderer->material && mesh)
+        {
+            Renderer3D::submit(mesh, object->getComponent<Transform>()->worldMatrix(), renderer->material, renderer->castShadows, renderer->isStatic);
+        }
+    });
 }
 
 void Scene::render2DEntities()
 {
-    auto renderables = m_rootObject.getChildren();
-
-    for (auto& object : renderables)
+    for (auto& object : m_rootObject.getChildren())
     {
         recurseRender2D(object);
     }
@@ -110,24 +118,21 @@ void Scene::setLights()
 {
     Renderer3D::clearLights();
     {
-        auto skylights = m_rootObject.getChildrenWithComponent<SkyLight>();
-        for (auto& object : skylights)
+        for (auto object : view<SkyLight>())
         {   
             auto light = object->getComponent<SkyLight>();
 
             Renderer3D::addLight(light);
         }
         
-        auto directionalLights = m_rootObject.getChildrenWithComponents<DirectionalLight, Transform>();
-        for (auto& object : directionalLights)
+        for (auto object : view<DirectionalLight, Transform>())
         {
             auto light = object->getComponent<DirectionalLight>();
 
             Renderer3D::addLight(light);
         }
 
-        auto pointLightObjects = m_rootObject.getChildrenWithComponents<PointLight, Transform>();
-        for (auto& object : pointLightObjects)
+        for (auto object : view<PointLight, Transform>())
         {
             auto light = object->getComponent<PointLight>();
 
@@ -145,15 +150,13 @@ GameObject* Scene::createGameObject(const std::string& name)
 
 void Scene::onSceneStart()
 {
-    auto csscripts = m_rootObject.getChildrenWithComponent<ScriptInstance>();
-    for (auto& object : csscripts)
+    for (auto object : view<ScriptInstance>())
     {
         auto script = object->getComponent<ScriptInstance>();
         //script.setScript(ScriptController::getInstance()->loadScript(script.getScript()->getPath()));
     }
 
-    auto sources = m_rootObject.getChildrenWithComponentsRecursive<AudioSource, Transform>();
-    for (auto& object : sources)
+    for (auto object : view<AudioSource, Transform>())
     {
         auto source = object->getComponent<AudioSource>();
 
@@ -164,8 +167,7 @@ void Scene::onSceneStart()
 
 void Scene::onSceneFinish()
 {
-    auto sources = m_rootObject.getChildrenWithComponentsRecursive<AudioSource, Transform>();
-    for (auto& object : sources)
+    for (auto object : view<AudioSource, Transform>())
     {
         if (object->getComponent<AudioSource>()->getState() == AudioSource::State::Playing)
             object->getComponent<AudioSource>()->stop();
@@ -174,28 +176,8 @@ void Scene::onSceneFinish()
 
 void Scene::onUpdateRuntime(float dt)
 {
-    // Native scripts
-    auto scripts = m_rootObject.getChildrenWithComponent<NativeScript>();
-    for (auto& object : scripts)
-    {
-        auto script = object->getComponent<NativeScript>();
-
-        if (!script->instance)
-        {
-            script->instance = script->instantiateScript();
-            script->instance->m_gameObject = object;
-            script->instance->onStart();
-        }
-
-        script->instance->onUpdate(dt);
-    }
-
-    // C# scripts
-    auto csscripts = m_rootObject.getChildrenWithComponent<ScriptInstance>();
-    for (auto& object : csscripts)
-    {
-        object->getComponent<ScriptInstance>()->getScript()->onUpdate(dt);
-    }
+    m_systems.run(*this, dt);
+    m_spatialIndex.update();
 
     // Rendering
     Camera* camera = nullptr;
@@ -210,8 +192,6 @@ void Scene::onUpdateRuntime(float dt)
 
     if (camera != nullptr)
     {
-        this->setLights();
-
         Renderer3D::beginScene(*camera, transform);
         this->render3DEntities();
         Renderer3D::endScene();
@@ -224,8 +204,7 @@ void Scene::onUpdateRuntime(float dt)
 
 GameObject* Scene::getPrimaryCameraGameObject()
 {
-    auto cameras = m_rootObject.getChildrenWithComponentRecursive<SceneCamera>();
-    for (auto& object : cameras)
+    for (auto object : view<SceneCamera>())
     {
         auto camera = object->getComponent<SceneCamera>();
         if (camera->primary)
@@ -239,8 +218,8 @@ GameObject* Scene::getPrimaryCameraGameObject()
 
 GameObject* Scene::getPhysicsWorld2D()
 {
-    auto worlds = m_rootObject.getChildrenWithComponentRecursive<PhysicsWorld2D>();
-    return worlds.size() > 0 ? worlds[0] : nullptr;
+    auto& worlds = view<PhysicsWorld2D>();
+    return !worlds.empty() ? worlds[0] : nullptr;
 }
 
 void Scene::onViewportResize(uint32_t width, uint32_t height)
@@ -248,8 +227,7 @@ void Scene::onViewportResize(uint32_t width, uint32_t height)
     m_viewportWidth = width;
     m_viewportHeight = height;
 
-    auto cameras = m_rootObject.getChildrenWithComponent<SceneCamera>();
-    for (auto& object : cameras)
+    for (auto object : view<SceneCamera>())
     {
         auto camera = object->getComponent<SceneCamera>();
         camera->setViewportSize(width, height);
@@ -22,8 +22,8 @@ void SceneSerializer::saveScene(const Reference<Scene>& scene, const std::string
     // Materials
     for (auto& material : Assets::getCache<Material>())
     {
-        auto& name = material.first;
-        auto& mat = material.second;
+        auto& name = material.getKey();
+        auto mat = material.get();
 
         if (mat->albedoMap)
             sceneNode["Materials"][name]["Albedo"] = mat->albedoMap->getPath();
@@ -66,15 +66,15 @@ void SceneSerializer::saveScene(const Reference<Scene>& scene, const std::string
 
     for (auto& texture : Assets::getCache<Texture2D>())
     {
-        if (texture.first == "white_texture")
-            sceneNode["Texture2Ds"][texture.first] = "white_texture";
+        if (texture.getKey() == "white_texture")
+            sceneNode["Texture2Ds"][texture.getKey()] = "white_texture";
         else
-            sceneNode["Texture2Ds"][texture.first] = texture.second->getPath();
+            sceneNode["Texture2Ds"][texture.getKey()] = texture.get()->getPath();
     }
 
     for (auto& shader : Assets::getCache<Shader>())
     {
-        sceneNode["Shaders"][shader.first] = shader.second->getPath();
+        sceneNode["Shaders"][shader.getKey()] = shader.get()->getPath();
     }
 
     auto& children = scene->getRootGameObject().getChildren();
@@ -235,9 +235,9 @@ void SceneSerializer::loadGameObject(YAML::Node& node, GameObject& parent, const
         {
             for (auto& model : Assets::getCache<Model>())
             {
-                if (model.second->path == mesh.filePath)
+                if (model.get()->path == mesh.filePath)
                 {
-                    mesh.mesh = model.second->meshes[mesh.meshID];
+                    mesh.mesh = model.get()->meshes[mesh.meshID];
                     needToLoad = false;
                     break;
                 }
@@ -0,0 +1,184 @@
+#include <scene/SceneSpatialIndex.h>
+#include <scene/GameObject.h>
+#include <scene/Components.h>
+#include <renderer/Mesh.h>
+#include <util/Transform.h>
+
+namespace Engine
+{
+
+namespace Utils
+{
+
+static bool isSameBox(const AABB& a, const AABB& b)
+{
+    return a.min.x == b.min.x && a.min.y == b.min.y && a.min.z == b.min.z &&
+           a.max.x == b.max.x && a.max.y == b.max.y && a.max.z == b.max.z;
+}
+
+}
+
+bool SceneSpatialIndex::dependsOn(ComponentId id) const
+{
+    return id == ComponentType::id<MeshComponent>() || id == ComponentType::id<Transform>();
+}
+
+void SceneSpatialIndex::onComponentsChanged(GameObject* object)
+{
+    if (object->hasComponents<MeshComponent, Transform>())
+    {
+        track_(object);
+    }
+    else
+    {
+        untrack_(object);
+    }
+}
+
+void SceneSpatialIndex::onTransformChanged(GameObject* object)
+{
+    auto it = m_proxies.find(object);
+
+    if (it == m_proxies.end())
+    {
+        return;
+    }
+
+    AABB bounds;
+    if (getWorldBounds_(object, bounds))
+    {
+        m_tree.move(it->second.node, bounds);
+    }
+}
+
+void SceneSpatialIndex::update()
+{
+    // Meshes replaced (the editor's mesh picker, async imports) or given new bounds since the leaf was fitted
+    for (auto it = m_proxies.begin(); it != m_proxies.end();)
+    {
+        GameObject* object = it->first;
+        Proxy& proxy = it->second;
+        auto& mesh = object->getComponent<MeshComponent>()->mesh;
+
+        if (mesh.get() == proxy.mesh && Utils::isSameBox(mesh->bounds, proxy.meshBounds))
+        {
+            it++;
+            continue;
+        }
+
+        AABB bounds;
+        if (getWorldBounds_(object, bounds))
+        {
+            m_tree.move(proxy.node, bounds);
+            proxy.mesh = mesh.get();
+            proxy.meshBounds = mesh->bounds;
+            it++;
+        }
+        else
+        {
+            m_tree.remove(proxy.node);
+            m_unbounded.push_back(object);
+            it = m_proxies.erase(it);
+        }
+    }
+
+    for (uint32_t i = 0; i < m_unbounded.size();)
+    {
+        GameObject* object = m_unbounded[i];
+        AABB bounds;
+
+        if (getWorldBounds_(object, bounds))
+        {
+            insert_(object, bounds);
+
+            m_unbounded[i] = m_unbounded.back();
+            m_unbounded.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+bool SceneSpatialIndex::getWorldBounds_(GameObject* object, AABB& bounds) const
+{
+    auto& mesh = object->getComponent<MeshComponent>()->mesh;
+
+    if (!mesh || !mesh->bounds.isValid())
+    {
+        return false;
+    }
+
+    bounds = mesh->bounds.transformed(object->getComponent<Transform>()->worldMatrix());
+    return true;
+}
+
+void SceneSpatialIndex::insert_(GameObject* object, const AABB& bounds)
+{
+    const auto& mesh = object->getComponent<MeshComponent>()->mesh;
+
+    m_proxies.emplace(object, Proxy{ m_tree.insert(bounds, object), mesh.get(), mesh->bounds });
+}
+
+void SceneSpatialIndex::track_(GameObject* object)
+{
+    if (m_proxies.count(object) || std::find(m_unbounded.begin(), m_unbounded.end(), object) != m_unbounded.end())
+    {
+        return;
+    }
+
+    AABB bounds;
+    if (getWorldBounds_(object, bounds))
+    {
+        insert_(object, bounds);
+    }
+    else
+    {
+        m_unbounded.push_back(object);
+    }
+}
+
+void SceneSpatialIndex::untrack_(GameObject* object)
+{
+    auto it = m_proxies.find(object);
+
+    if (it != m_proxies.end())
+    {
+        m_tree.remove(it->second.node);
+        m_proxies.erase(it);
+        return;
+    }
+
+    auto unbounded = std::find(m_unbounded.begin(), m_unbounded.end(), object);
+    if (unbounded != m_unbounded.end())
+    {
+        *unbounded = m_unbounded.back();
+        m_unbounded.pop_back();
+    }
+}
+
+void SceneSpatialIndex::queryFrustum(const Frustum& frustum, std::vector<GameObject*>& objects) const
+{
+    m_tree.queryFrustum(frustum, objects);
+    objects.insert(objects.end(), m_unbounded.begin(), m_unbounded.end());
+}
+
+void SceneSpatialIndex::queryBox(const AABB& box, std::vector<GameObject*>& objects) const
+{
+    m_tree.queryBox(box, objects);
+    objects.insert(objects.end(), m_unbounded.begin(), m_unbounded.end());
+}
+
+void SceneSpatialIndex::querySphere(const BoundingSphere& sphere, std::vector<GameObject*>& objects) const
+{
+    m_tree.querySphere(sphere, objects);
+    objects.insert(objects.end(), m_unbounded.begin(), m_unbounded.end());
+}
+
+GameObject* SceneSpatialIndex::raycast(const math::vec3& origin, const math::vec3& direction, float maxDistance, float* distance) const
+{
+    return m_tree.raycast(origin, direction, maxDistance, distance);
+}
+
+}
\ No newline at end of file
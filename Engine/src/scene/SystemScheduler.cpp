@@ -0,0 +1,104 @@
+#include <scene/SystemScheduler.h>
+#include <core/JobSystem.h>
+#include <util/Timer.h>
+
+namespace Engine
+{
+
+void SystemScheduler::removeSystem(System* system)
+{
+    auto it = std::find_if(m_systems.begin(), m_systems.end(), [system](const Owned<System>& s) { return s.get() == system; });
+
+    if (it != m_systems.end())
+    {
+        m_systems.erase(it);
+        m_dirty = true;
+    }
+}
+
+void SystemScheduler::buildStages_()
+{
+    m_stages.clear();
+    m_timings.resize(m_systems.size());
+
+    std::vector<uint32_t> stageOf(m_systems.size());
+
+    for (uint32_t i = 0; i < m_systems.size(); i++)
+    {
+        uint32_t stage = 0;
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+            if (m_systems[i]->conflictsWith(*m_systems[j]))
+            {
+                stage = std::max(stage, stageOf[j] + 1);
+            }
+        }
+
+        stageOf[i] = stage;
+
+        if (stage >= m_stages.size())
+        {
+            m_stages.resize(stage + 1);
+        }
+
+        m_stages[stage].push_back(i);
+        m_timings[i] = { m_systems[i].get(), stage, 0.0, 0.0 };
+    }
+
+    m_dirty = false;
+}
+
+void SystemScheduler::run(Scene& scene, float dt)
+{
+    if (m_dirty)
+    {
+        buildStages_();
+    }
+
+    auto jobs = JobSystem::getInstance();
+
+    for (auto& stage : m_stages)
+    {
+        JobCounter counter;
+
+        for (auto index : stage)
+        {
+            System* system = m_systems[index].get();
+
+            if (stage.size() > 1 && !system->isMainThreadOnly())
+            {
+                jobs->execute([this, system, index, &scene, dt]()
+                {
+                    Timer timer;
+                    system->onUpdate(scene, dt);
+                    m_timings[index].millis = timer.getMillis();
+                }, &counter);
+            }
+        }
+
+        // Main thread systems (and single-system stages) run here while the workers handle the rest
+        for (auto index : stage)
+        {
+            System* system = m_systems[index].get();
+
+            if (stage.size() == 1 || system->isMainThreadOnly())
+            {
+                Timer timer;
+                system->onUpdate(scene, dt);
+                m_timings[index].millis = timer.getMillis();
+            }
+        }
+
+        jobs->wait(counter);
+
+        for (auto index : stage)
+        {
+            Timer timer;
+            m_systems[index]->onSync(scene);
+            m_timings[index].syncMillis = timer.getMillis();
+        }
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <scene/Systems.h>
+#include <scene/Scene.h>
+#include <scene/NativeScript.h>
+#include <script/Script.h>
+#include <util/Transform.h>
+#include <audio/AudioSource.h>
+#include <audio/AudioListener.h>
+#include <renderer/Lighting.h>
+#include <renderer/Renderer3D.h>
+
+namespace Engine
+{
+
+NativeScriptSystem::NativeScriptSystem()
+    : System("Native Scripts")
+{
+    setExclusive(true);
+    setMainThreadOnly(true);
+}
+
+void NativeScriptSystem::onUpdate(Scene& scene, float dt)
+{
+    // Indexed, as scripts may add or remove components while running
+    auto& scripts = scene.view<NativeScript>();
+    for (uint32_t i = 0; i < scripts.size(); i++)
+    {
+        auto object = scripts[i];
+        auto script = object->getComponent<NativeScript>();
+
+        if (!script->instance)
+        {
+            script->instance = script->instantiateScript();
+            script->instance->m_gameObject = object->getHandle();
+            script->instance->m_objects = &object->getStorage().getObjects();
+            script->instance->onStart();
+        }
+
+        script->instance->onUpdate(dt);
+    }
+}
+
+ScriptSystem::ScriptSystem()
+    : System("Scripts")
+{
+    setExclusive(true);
+    setMainThreadOnly(true);
+}
+
+void ScriptSystem::onUpdate(Scene& scene, float dt)
+{
+    auto& scripts = scene.view<ScriptInstance>();
+    for (uint32_t i = 0; i < scripts.size(); i++)
+    {
+        scripts[i]->getComponent<ScriptInstance>()->getScript()->onUpdate(dt);
+    }
+}
+
+TransformSystem::TransformSystem()
+    : System("Transforms")
+{
+    writes<Transform>();
+}
+
+void TransformSystem::onUpdate(Scene& scene, float dt)
+{
+    m_changed.clear();
+    scene.getRootGameObject().updateTransforms(m_changed);
+}
+
+void TransformSystem::onSync(Scene& scene)
+{
+    auto& storage = scene.getRootGameObject().getStorage();
+
+    for (auto object : m_changed)
+    {
+        object->onTransformChange(*object->getComponent<Transform>());
+        storage.onTransformChanged(object);
+    }
+}
+
+LightSystem::LightSystem()
+    : System("Lights")
+{
+    reads<SkyLight, DirectionalLight, PointLight>();
+}
+
+void LightSystem::onAttach(Scene& scene)
+{
+    m_skyLights = &scene.view<SkyLight>();
+    m_directionalLights = &scene.view<DirectionalLight, Transform>();
+    m_pointLights = &scene.view<PointLight, Transform>();
+}
+
+void LightSystem::onUpdate(Scene& scene, float dt)
+{
+    m_lights.clear();
+
+    for (auto object : *m_skyLights)
+    {
+        m_lights.push_back(object->getComponent<SkyLight>());
+    }
+
+    for (auto object : *m_directionalLights)
+    {
+        m_lights.push_back(object->getComponent<DirectionalLight>());
+    }
+
+    for (auto object : *m_pointLights)
+    {
+        m_lights.push_back(object->getComponent<PointLight>());
+    }
+}
+
+void LightSystem::onSync(Scene& scene)
+{
+    Renderer3D::clearLights();
+
+    for (auto light : m_lights)
+    {
+        Renderer3D::addLight(light);
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,846 @@
+#include <util/BlockCompression.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace Engine
+{
+
+namespace Utils
+{
+    // Channel values of a block's texels, in row order
+    struct BlockTexels
+    {
+        float values[16][4];
+    };
+
+    // Bits of a block, lowest bit of the first byte first
+    struct BlockBits
+    {
+        uint8_t* data;
+        uint32_t position = 0;
+
+        void write(uint32_t value, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; i++, position++)
+            {
+                if ((value >> i) & 1)
+                {
+                    data[position / 8] |= static_cast<uint8_t>(1 << (position % 8));
+                }
+            }
+        }
+
+        uint32_t read(uint32_t count)
+        {
+            uint32_t value = 0;
+
+            for (uint32_t i = 0; i < count; i++, position++)
+            {
+                value |= static_cast<uint32_t>((data[position / 8] >> (position % 8)) & 1) << i;
+            }
+
+            return value;
+        }
+    };
+
+    static constexpr uint8_t BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    // Weight of color1 for each BC1 index in four color mode
+    static constexpr float COLOR_WEIGHTS[4] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+
+    void loadBlock_(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, BlockTexels& block)
+    {
+        for (uint32_t y = 0; y < 4; y++)
+        {
+            uint32_t row = std::min(blockY * 4 + y, height - 1);
+
+            for (uint32_t x = 0; x < 4; x++)
+            {
+                uint32_t column = std::min(blockX * 4 + x, width - 1);
+                const uint8_t* pixel = pixels + (static_cast<size_t>(row) * width + column) * 4;
+
+                for (uint32_t channel = 0; channel < 4; channel++)
+                {
+                    block.values[y * 4 + x][channel] = pixel[channel];
+                }
+            }
+        }
+    }
+
+    void storeBlock_(const uint8_t (&texels)[16][4], uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* pixels)
+    {
+        for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; y++)
+        {
+            for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; x++)
+            {
+                size_t pixel = (static_cast<size_t>(blockY * 4 + y) * width + blockX * 4 + x) * 4;
+                std::memcpy(pixels + pixel, texels[y * 4 + x], 4);
+            }
+        }
+    }
+
+    float clampChannel_(float value)
+    {
+        return std::min(std::max(value, 0.f), 255.f);
+    }
+
+    // Ends of the texels' spread along their principal axis, over 'count' channels starting at 'first'
+    void fitEndpoints_(const BlockTexels& block, uint32_t first, uint32_t count, float* low, float* high)
+    {
+        float mean[4] = {};
+        float minimum[4], maximum[4];
+
+        for (uint32_t channel = 0; channel < count; channel++)
+        {
+            minimum[channel] = 255.f;
+            maximum[channel] = 0.f;
+        }
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            for (uint32_t channel = 0; channel < count; channel++)
+            {
+                float value = block.values[i][first + channel];
+
+                mean[channel] += value / 16.f;
+                minimum[channel] = std::min(minimum[channel], value);
+                maximum[channel] = std::max(maximum[channel], value);
+            }
+        }
+
+        float covariance[4][4] = {};
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            for (uint32_t a = 0; a < count; a++)
+            {
+                for (uint32_t b = 0; b < count; b++)
+                {
+                    covariance[a][b] += (block.values[i][first + a] - mean[a]) * (block.values[i][first + b] - mean[b]);
+                }
+            }
+        }
+
+        // Power iteration, starting from the diagonal of the bounding box
+        float axis[4];
+        for (uint32_t channel = 0; channel < count; channel++)
+        {
+            axis[channel] = maximum[channel] - minimum[channel];
+        }
+
+        for (uint32_t iteration = 0; iteration < 8; iteration++)
+        {
+            float next[4] = {};
+            float largest = 0.f;
+
+            for (uint32_t a = 0; a < count; a++)
+            {
+                for (uint32_t b = 0; b < count; b++)
+                {
+                    next[a] += covariance[a][b] * axis[b];
+                }
+
+                largest = std::max(largest, std::abs(next[a]));
+            }
+
+            if (largest < 1e-6f)
+            {
+                break;
+            }
+
+            for (uint32_t channel = 0; channel < count; channel++)
+            {
+                axis[channel] = next[channel] / largest;
+            }
+        }
+
+        float length = 0.f;
+        for (uint32_t channel = 0; channel < count; channel++)
+        {
+            length += axis[channel] * axis[channel];
+        }
+
+        length = std::sqrt(length);
+
+        // Every texel is the same
+        if (length < 1e-6f)
+        {
+            for (uint32_t channel = 0; channel < count; channel++)
+            {
+                low[channel] = high[channel] = mean[channel];
+            }
+
+            return;
+        }
+
+        float lowest = 0.f, highest = 0.f;
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            float projection = 0.f;
+
+            for (uint32_t channel = 0; channel < count; channel++)
+            {
+                projection += (block.values[i][first + channel] - mean[channel]) * axis[channel] / length;
+            }
+
+            lowest = std::min(lowest, projection);
+            highest = std::max(highest, projection);
+        }
+
+        for (uint32_t channel = 0; channel < count; channel++)
+        {
+            low[channel] = clampChannel_(mean[channel] + axis[channel] / length * lowest);
+            high[channel] = clampChannel_(mean[channel] + axis[channel] / length * highest);
+        }
+    }
+
+    // Least squares endpoints for the texels, given each texel's interpolation weight of the second endpoint.
+    // False if the weights don't determine both endpoints.
+    bool refineEndpoints_(const BlockTexels& block, uint32_t first, uint32_t count, const float* weights, float* endpoint0, float* endpoint1)
+    {
+        float aa = 0.f, ab = 0.f, bb = 0.f;
+        float ax[4] = {}, bx[4] = {};
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            float a = 1.f - weights[i];
+            float b = weights[i];
+
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+
+            for (uint32_t channel = 0; channel < count; channel++)
+            {
+                ax[channel] += a * block.values[i][first + channel];
+                bx[channel] += b * block.values[i][first + channel];
+            }
+        }
+
+        float determinant = aa * bb - ab * ab;
+
+        if (std::abs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+
+        for (uint32_t channel = 0; channel < count; channel++)
+        {
+            endpoint0[channel] = clampChannel_((ax[channel] * bb - bx[channel] * ab) / determinant);
+            endpoint1[channel] = clampChannel_((bx[channel] * aa - ax[channel] * ab) / determinant);
+        }
+
+        return true;
+    }
+
+    uint16_t packColor565_(const float* color)
+    {
+        uint32_t r = static_cast<uint32_t>(std::lround(clampChannel_(color[0]) * 31.f / 255.f));
+        uint32_t g = static_cast<uint32_t>(std::lround(clampChannel_(color[1]) * 63.f / 255.f));
+        uint32_t b = static_cast<uint32_t>(std::lround(clampChannel_(color[2]) * 31.f / 255.f));
+
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackColor565_(uint16_t color, int* rgb)
+    {
+        int r = (color >> 11) & 31;
+        int g = (color >> 5) & 63;
+        int b = color & 31;
+
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    // Three color mode (color0 <= color1) only applies to BC1, BC3 color blocks always interpolate four colors
+    void getColorPalette_(uint16_t color0, uint16_t color1, bool allowThreeColors, int (&palette)[4][3])
+    {
+        unpackColor565_(color0, palette[0]);
+        unpackColor565_(color1, palette[1]);
+
+        bool threeColors = allowThreeColors && color0 <= color1;
+
+        for (uint32_t channel = 0; channel < 3; channel++)
+        {
+            if (threeColors)
+            {
+                palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2;
+                palette[3][channel] = 0;
+            }
+            else
+            {
+                palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+                palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+            }
+        }
+    }
+
+    // Picks the nearest palette color for each texel and returns the squared error. The colors are ordered so that
+    // color0 is greater, which selects four color mode, or equal with every index 0. Either way BC1 and BC3 decode
+    // the block the same.
+    float selectColorIndices_(const BlockTexels& block, uint16_t& color0, uint16_t& color1, uint8_t* indices)
+    {
+        if (color0 < color1)
+        {
+            std::swap(color0, color1);
+        }
+
+        int palette[4][3];
+        getColorPalette_(color0, color1, false, palette);
+
+        uint32_t candidates = color0 == color1 ? 1 : 4;
+        float error = 0.f;
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            float best = 0.f;
+
+            for (uint32_t candidate = 0; candidate < candidates; candidate++)
+            {
+                float distance = 0.f;
+
+                for (uint32_t channel = 0; channel < 3; channel++)
+                {
+                    float difference = block.values[i][channel] - palette[candidate][channel];
+                    distance += difference * difference;
+                }
+
+                if (candidate == 0 || distance < best)
+                {
+                    best = distance;
+                    indices[i] = static_cast<uint8_t>(candidate);
+                }
+            }
+
+            error += best;
+        }
+
+        return error;
+    }
+
+    void encodeColorBlock_(const BlockTexels& block, uint8_t* output)
+    {
+        float low[3], high[3];
+        fitEndpoints_(block, 0, 3, low, high);
+
+        uint16_t color0 = packColor565_(high);
+        uint16_t color1 = packColor565_(low);
+        uint8_t indices[16];
+
+        float error = selectColorIndices_(block, color0, color1, indices);
+
+        // One least squares pass over the chosen indices
+        float weights[16];
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            weights[i] = COLOR_WEIGHTS[indices[i]];
+        }
+
+        float endpoint0[3], endpoint1[3];
+
+        if (error > 0.f && refineEndpoints_(block, 0, 3, weights, endpoint0, endpoint1))
+        {
+            uint16_t refined0 = packColor565_(endpoint0);
+            uint16_t refined1 = packColor565_(endpoint1);
+            uint8_t refinedIndices[16];
+
+            if (selectColorIndices_(block, refined0, refined1, refinedIndices) < error)
+            {
+                color0 = refined0;
+                color1 = refined1;
+                std::memcpy(indices, refinedIndices, sizeof(indices));
+            }
+        }
+
+        uint32_t bits = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+        }
+
+        output[0] = static_cast<uint8_t>(color0);
+        output[1] = static_cast<uint8_t>(color0 >> 8);
+        output[2] = static_cast<uint8_t>(color1);
+        output[3] = static_cast<uint8_t>(color1 >> 8);
+
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            output[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+        }
+    }
+
+    void decodeColorBlock_(const uint8_t* input, bool allowThreeColors, uint8_t (&texels)[16][4])
+    {
+        uint16_t color0 = static_cast<uint16_t>(input[0] | (input[1] << 8));
+        uint16_t color1 = static_cast<uint16_t>(input[2] | (input[3] << 8));
+
+        int palette[4][3];
+        getColorPalette_(color0, color1, allowThreeColors, palette);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            uint32_t index = (input[4 + i / 4] >> ((i % 4) * 2)) & 3;
+
+            for (uint32_t channel = 0; channel < 3; channel++)
+            {
+                texels[i][channel] = static_cast<uint8_t>(palette[index][channel]);
+            }
+        }
+    }
+
+    void getAlphaPalette_(int alpha0, int alpha1, int (&palette)[8])
+    {
+        palette[0] = alpha0;
+        palette[1] = alpha1;
+
+        if (alpha0 > alpha1)
+        {
+            for (int i = 1; i <= 6; i++)
+            {
+                palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+            }
+        }
+        else
+        {
+            for (int i = 1; i <= 4; i++)
+            {
+                palette[i + 1] = ((5 - i) * alpha0 + i * alpha1) / 5;
+            }
+
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    // A single channel interpolated between its minimum and maximum, as BC3 stores alpha and BC5 each channel
+    void encodeAlphaBlock_(const BlockTexels& block, uint32_t channel, uint8_t* output)
+    {
+        int minimum = 255, maximum = 0;
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            minimum = std::min(minimum, static_cast<int>(block.values[i][channel]));
+            maximum = std::max(maximum, static_cast<int>(block.values[i][channel]));
+        }
+
+        output[0] = static_cast<uint8_t>(maximum);
+        output[1] = static_cast<uint8_t>(minimum);
+
+        uint64_t bits = 0;
+
+        // With equal ends every index 0 already decodes to the value
+        if (maximum > minimum)
+        {
+            int palette[8];
+            getAlphaPalette_(maximum, minimum, palette);
+
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                int value = static_cast<int>(block.values[i][channel]);
+                uint64_t best = 0;
+
+                for (uint32_t candidate = 1; candidate < 8; candidate++)
+                {
+                    if (std::abs(palette[candidate] - value) < std::abs(palette[best] - value))
+                    {
+                        best = candidate;
+                    }
+                }
+
+                bits |= best << (i * 3);
+            }
+        }
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            output[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+        }
+    }
+
+    void decodeAlphaBlock_(const uint8_t* input, uint32_t channel, uint8_t (&texels)[16][4])
+    {
+        int palette[8];
+        getAlphaPalette_(input[0], input[1], palette);
+
+        uint64_t bits = 0;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            bits |= static_cast<uint64_t>(input[2 + i]) << (i * 8);
+        }
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            texels[i][channel] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+        }
+    }
+
+    // Mode 6 endpoint: 7 bits per channel plus a lowest bit shared by the channels, picked to fit the color best.
+    // Opaque blocks always take a set lowest bit, which keeps their alpha at exactly 255.
+    void quantizeBC7Endpoint_(const float* color, bool opaque, uint8_t (&values)[4], uint32_t& pbit)
+    {
+        float bestError = 0.f;
+
+        for (uint32_t candidate = opaque ? 1 : 0; candidate < 2; candidate++)
+        {
+            uint8_t quantized[4];
+            float error = 0.f;
+
+            for (uint32_t channel = 0; channel < 4; channel++)
+            {
+                float value = opaque && channel == 3 ? 255.f : color[channel];
+
+                long level = std::lround((value - candidate) / 2.f);
+                quantized[channel] = static_cast<uint8_t>(std::min(std::max(level, 0l), 127l));
+
+                float difference = static_cast<float>((quantized[channel] << 1) | candidate) - value;
+                error += difference * difference;
+            }
+
+            if (candidate == (opaque ? 1u : 0u) || error < bestError)
+            {
+                bestError = error;
+                pbit = candidate;
+                std::memcpy(values, quantized, sizeof(quantized));
+            }
+        }
+    }
+
+    void getBC7Palette_(const uint8_t (&values0)[4], uint32_t pbit0, const uint8_t (&values1)[4], uint32_t pbit1, int (&palette)[16][4])
+    {
+        for (uint32_t channel = 0; channel < 4; channel++)
+        {
+            int endpoint0 = (values0[channel] << 1) | static_cast<int>(pbit0);
+            int endpoint1 = (values1[channel] << 1) | static_cast<int>(pbit1);
+
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                palette[i][channel] = ((64 - BC7_WEIGHTS[i]) * endpoint0 + BC7_WEIGHTS[i] * endpoint1 + 32) >> 6;
+            }
+        }
+    }
+
+    float selectBC7Indices_(const BlockTexels& block, const int (&palette)[16][4], uint8_t* indices)
+    {
+        float error = 0.f;
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            float best = 0.f;
+
+            for (uint32_t candidate = 0; candidate < 16; candidate++)
+            {
+                float distance = 0.f;
+
+                for (uint32_t channel = 0; channel < 4; channel++)
+                {
+                    float difference = block.values[i][channel] - palette[candidate][channel];
+                    distance += difference * difference;
+                }
+
+                if (candidate == 0 || distance < best)
+                {
+                    best = distance;
+                    indices[i] = static_cast<uint8_t>(candidate);
+                }
+            }
+
+            error += best;
+        }
+
+        return error;
+    }
+
+    // BC7 mode 6: a single RGBA line with 16 steps, which suits the whole block when it is encoded with one mode
+    void encodeBC7Block_(const BlockTexels& block, uint8_t* output)
+    {
+        bool opaque = true;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            opaque = opaque && block.values[i][3] == 255.f;
+        }
+
+        float low[4], high[4];
+        fitEndpoints_(block, 0, 4, low, high);
+
+        uint8_t values0[4], values1[4];
+        uint32_t pbit0, pbit1;
+        quantizeBC7Endpoint_(low, opaque, values0, pbit0);
+        quantizeBC7Endpoint_(high, opaque, values1, pbit1);
+
+        int palette[16][4];
+        getBC7Palette_(values0, pbit0, values1, pbit1, palette);
+
+        uint8_t indices[16];
+        float error = selectBC7Indices_(block, palette, indices);
+
+        // One least squares pass over the chosen indices
+        float weights[16];
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            weights[i] = BC7_WEIGHTS[indices[i]] / 64.f;
+        }
+
+        float endpoint0[4], endpoint1[4];
+
+        if (error > 0.f && refineEndpoints_(block, 0, 4, weights, endpoint0, endpoint1))
+        {
+            uint8_t refinedValues0[4], refinedValues1[4];
+            uint32_t refinedPbit0, refinedPbit1;
+            quantizeBC7Endpoint_(endpoint0, opaque, refinedValues0, refinedPbit0);
+            quantizeBC7Endpoint_(endpoint1, opaque, refinedValues1, refinedPbit1);
+
+            int refinedPalette[16][4];
+            getBC7Palette_(refinedValues0, refinedPbit0, refinedValues1, refinedPbit1, refinedPalette);
+
+            uint8_t refinedIndices[16];
+
+            if (selectBC7Indices_(block, refinedPalette, refinedIndices) < error)
+            {
+                std::memcpy(values0, refinedValues0, sizeof(values0));
+                std::memcpy(values1, refinedValues1, sizeof(values1));
+                pbit0 = refinedPbit0;
+                pbit1 = refinedPbit1;
+                std::memcpy(indices, refinedIndices, sizeof(indices));
+            }
+        }
+
+        // The first texel's index is stored without its highest bit, which has to be zero
+        if (indices[0] >= 8)
+        {
+            std::swap(values0, values1);
+            std::swap(pbit0, pbit1);
+
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                indices[i] = static_cast<uint8_t>(15 - indices[i]);
+            }
+        }
+
+        std::memset(output, 0, 16);
+        BlockBits bits{ output };
+
+        bits.write(1 << 6, 7);
+
+        for (uint32_t channel = 0; channel < 4; channel++)
+        {
+            bits.write(values0[channel], 7);
+            bits.write(values1[channel], 7);
+        }
+
+        bits.write(pbit0, 1);
+        bits.write(pbit1, 1);
+
+        bits.write(indices[0], 3);
+        for (uint32_t i = 1; i < 16; i++)
+        {
+            bits.write(indices[i], 4);
+        }
+    }
+
+    bool decodeBC7Block_(const uint8_t* input, uint8_t (&texels)[16][4])
+    {
+        // Mode 6 is six zero bits followed by a one
+        if ((input[0] & 0x7f) != 0x40)
+        {
+            return false;
+        }
+
+        BlockBits bits{ const_cast<uint8_t*>(input), 7 };
+
+        uint8_t values0[4], values1[4];
+
+        for (uint32_t channel = 0; channel < 4; channel++)
+        {
+            values0[channel] = static_cast<uint8_t>(bits.read(7));
+            values1[channel] = static_cast<uint8_t>(bits.read(7));
+        }
+
+        uint32_t pbit0 = bits.read(1);
+        uint32_t pbit1 = bits.read(1);
+
+        int palette[16][4];
+        getBC7Palette_(values0, pbit0, values1, pbit1, palette);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            uint32_t index = bits.read(i == 0 ? 3 : 4);
+
+            for (uint32_t channel = 0; channel < 4; channel++)
+            {
+                texels[i][channel] = static_cast<uint8_t>(palette[index][channel]);
+            }
+        }
+
+        return true;
+    }
+
+    // Rows of a color block's indices are one byte each
+    void flipColorBlock_(uint8_t* block)
+    {
+        std::swap(block[4], block[7]);
+        std::swap(block[5], block[6]);
+    }
+
+    // Rows of an alpha block's indices are 12 bits each
+    void flipAlphaBlock_(uint8_t* block)
+    {
+        uint64_t bits = 0;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            bits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+        }
+
+        uint64_t flipped = 0;
+        for (uint32_t row = 0; row < 4; row++)
+        {
+            flipped |= ((bits >> (row * 12)) & 0xfff) << ((3 - row) * 12);
+        }
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            block[2 + i] = static_cast<uint8_t>(flipped >> (i * 8));
+        }
+    }
+}
+
+uint32_t BlockCompression::getBlockSize(Format format)
+{
+    return format == Format::BC1 ? 8 : 16;
+}
+
+size_t BlockCompression::getSize(Format format, uint32_t width, uint32_t height)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+}
+
+void BlockCompression::encode(Format format, const uint8_t* pixels, uint32_t width, uint32_t height, uint8_t* blocks)
+{
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    uint32_t blockSize = getBlockSize(format);
+
+    Utils::BlockTexels block;
+
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+    {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+        {
+            Utils::loadBlock_(pixels, width, height, blockX, blockY, block);
+            uint8_t* output = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize;
+
+            switch (format)
+            {
+                case Format::BC1:
+                    Utils::encodeColorBlock_(block, output);
+                    break;
+                case Format::BC3:
+                    Utils::encodeAlphaBlock_(block, 3, output);
+                    Utils::encodeColorBlock_(block, output + 8);
+                    break;
+                case Format::BC5:
+                    Utils::encodeAlphaBlock_(block, 0, output);
+                    Utils::encodeAlphaBlock_(block, 1, output + 8);
+                    break;
+                case Format::BC7:
+                    Utils::encodeBC7Block_(block, output);
+                    break;
+            }
+        }
+    }
+}
+
+bool BlockCompression::decode(Format format, const uint8_t* blocks, uint32_t width, uint32_t height, uint8_t* pixels)
+{
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    uint32_t blockSize = getBlockSize(format);
+
+    uint8_t texels[16][4];
+
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++)
+    {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++)
+        {
+            const uint8_t* input = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize;
+
+            for (auto& texel : texels)
+            {
+                texel[2] = 0;
+                texel[3] = 255;
+            }
+
+            switch (format)
+            {
+                case Format::BC1:
+                    Utils::decodeColorBlock_(input, true, texels);
+                    break;
+                case Format::BC3:
+                    Utils::decodeAlphaBlock_(input, 3, texels);
+                    Utils::decodeColorBlock_(input + 8, false, texels);
+                    break;
+                case Format::BC5:
+                    Utils::decodeAlphaBlock_(input, 0, texels);
+                    Utils::decodeAlphaBlock_(input + 8, 1, texels);
+                    break;
+                case Format::BC7:
+                    if (!Utils::decodeBC7Block_(input, texels))
+                    {
+                        return false;
+                    }
+                    break;
+            }
+
+            Utils::storeBlock_(texels, width, height, blockX, blockY, pixels);
+        }
+    }
+
+    return true;
+}
+
+bool BlockCompression::flipVertically(Format format, uint8_t* blocks, uint32_t width, uint32_t height)
+{
+    if (format == Format::BC7)
+    {
+        return false;
+    }
+
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    size_t rowSize = static_cast<size_t>(blocksX) * getBlockSize(format);
+
+    for (uint32_t row = 0; row < blocksY / 2; row++)
+    {
+        std::swap_ranges(blocks + row * rowSize, blocks + (row + 1) * rowSize, blocks + (blocksY - 1 - row) * rowSize);
+    }
+
+    for (size_t offset = 0; offset < rowSize * blocksY; offset += getBlockSize(format))
+    {
+        uint8_t* block = blocks + offset;
+
+        switch (format)
+        {
+            case Format::BC1:
+                Utils::flipColorBlock_(block);
+                break;
+            case Format::BC3:
+                Utils::flipAlphaBlock_(block);
+                Utils::flipColorBlock_(block + 8);
+                break;
+            case Format::BC5:
+                Utils::flipAlphaBlock_(block);
+                Utils::flipAlphaBlock_(block + 8);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,511 @@
+#include <util/CompressedImage.h>
+#include <util/io/FileSystem.h>
+#include <core/Logger.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Engine
+{
+
+namespace Utils
+{
+    static constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n' };
+    static constexpr size_t KTX2_HEADER_SIZE = 80;
+    static constexpr size_t KTX2_LEVEL_SIZE = 24;
+
+    static constexpr size_t DDS_HEADER_SIZE = 128; // Including the magic
+    static constexpr size_t DDS_DX10_HEADER_SIZE = 20;
+
+    struct FormatCodes
+    {
+        BlockCompression::Format format;
+        bool isSRGB;
+        uint32_t vkFormat;
+        uint32_t dxgiFormat;
+    };
+
+    // BC1 is sampled as RGB, so files in its RGBA variants (vkFormat 133 and 134) lose their punch through alpha
+    static constexpr FormatCodes FORMAT_CODES[] = {
+        { BlockCompression::Format::BC1, false, 131, 71 },
+        { BlockCompression::Format::BC1, true,  132, 72 },
+        { BlockCompression::Format::BC1, false, 133, 0  },
+        { BlockCompression::Format::BC1, true,  134, 0  },
+        { BlockCompression::Format::BC3, false, 137, 77 },
+        { BlockCompression::Format::BC3, true,  138, 78 },
+        { BlockCompression::Format::BC5, false, 141, 83 },
+        { BlockCompression::Format::BC7, false, 145, 98 },
+        { BlockCompression::Format::BC7, true,  146, 99 }
+    };
+
+    template<typename T>
+    T readValue_(const std::vector<uint8_t>& file, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, file.data() + offset, sizeof(T));
+
+        return value;
+    }
+
+    template<typename T>
+    void writeValue_(std::vector<uint8_t>& file, size_t offset, T value)
+    {
+        std::memcpy(file.data() + offset, &value, sizeof(T));
+    }
+
+    uint32_t getFourCC_(const char* code)
+    {
+        return static_cast<uint32_t>(code[0]) | (static_cast<uint32_t>(code[1]) << 8) |
+               (static_cast<uint32_t>(code[2]) << 16) | (static_cast<uint32_t>(code[3]) << 24);
+    }
+
+    uint32_t getMaxLevelCount_(uint32_t width, uint32_t height)
+    {
+        uint32_t count = 1;
+
+        for (uint32_t size = std::max(width, height); size > 1; size /= 2)
+        {
+            count++;
+        }
+
+        return count;
+    }
+
+    size_t alignOffset_(size_t offset, size_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+}
+
+bool CompressedImage::isCompressedFile(const std::string& path)
+{
+    std::string extension = path.substr(path.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return extension == "ktx2" || extension == "dds";
+}
+
+Reference<CompressedImage> CompressedImage::create(const std::string& path, bool flipped)
+{
+    auto image = Reference<CompressedImage>(new CompressedImage());
+    image->m_path = path;
+
+    std::string extension = path.substr(path.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    // Read through the file system, so textures can come from archives
+    std::vector<uint8_t> file;
+
+    if (!FileSystem::readBytes(path, file))
+    {
+        Logger::getCoreLogger()->error("Image does not exist: %s", path.c_str());
+        return image;
+    }
+
+    bool parsed = extension == "ktx2" ? image->parseKTX2_(file) : image->parseDDS_(file);
+
+    if (!parsed)
+    {
+        Logger::getCoreLogger()->error("Unsupported or corrupted compressed image: %s", path.c_str());
+
+        image->m_levels.clear();
+        image->m_data.clear();
+        return image;
+    }
+
+    if (image->m_flipped != flipped)
+    {
+        bool flippable = true;
+
+        for (auto& level : image->m_levels)
+        {
+            flippable = BlockCompression::flipVertically(image->m_format, image->m_data.data() + level.offset, level.width, level.height) && flippable;
+        }
+
+        if (flippable)
+        {
+            image->m_flipped = flipped;
+        }
+        else
+        {
+            Logger::getCoreLogger()->warn("Rows of BC7 image %s can't be flipped on load and will be upside down, convert it with TextureTool", path.c_str());
+        }
+    }
+
+    return image;
+}
+
+Reference<CompressedImage> CompressedImage::create(Format format, uint32_t width, uint32_t height, bool isSRGB, bool flipped)
+{
+    auto image = Reference<CompressedImage>(new CompressedImage());
+
+    image->m_format = format;
+    image->m_isSRGB = isSRGB && format != Format::BC5;
+    image->m_flipped = flipped;
+    image->m_width = width;
+    image->m_height = height;
+
+    return image;
+}
+
+void CompressedImage::addLevel(const uint8_t* blocks)
+{
+    uint32_t index = getLevelCount();
+
+    Level level;
+    level.width = std::max(m_width >> index, 1u);
+    level.height = std::max(m_height >> index, 1u);
+    level.offset = m_data.size();
+    level.size = BlockCompression::getSize(m_format, level.width, level.height);
+
+    m_data.insert(m_data.end(), blocks, blocks + level.size);
+    m_levels.push_back(level);
+}
+
+bool CompressedImage::saveKTX2(const std::string& path) const
+{
+    const Utils::FormatCodes* codes = nullptr;
+
+    for (auto& entry : Utils::FORMAT_CODES)
+    {
+        if (entry.format == m_format && entry.isSRGB == m_isSRGB)
+        {
+            codes = &entry;
+            break;
+        }
+    }
+
+    if (!codes || m_levels.empty())
+    {
+        return false;
+    }
+
+    uint32_t blockSize = BlockCompression::getBlockSize(m_format);
+
+    // Data format descriptor: one basic block, with a sample per separately interpolated part of the blocks
+    struct Sample
+    {
+        uint32_t bitOffset;
+        uint32_t channel;
+    };
+
+    std::vector<Sample> samples;
+    uint32_t colorModel = 0;
+
+    switch (m_format)
+    {
+        case Format::BC1:
+            colorModel = 128;
+            samples = { { 0, 0 } };
+            break;
+        case Format::BC3:
+            colorModel = 130;
+            samples = { { 0, 15 }, { 64, 0 } };
+            break;
+        case Format::BC5:
+            colorModel = 132;
+            samples = { { 0, 0 }, { 64, 1 } };
+            break;
+        case Format::BC7:
+            colorModel = 134;
+            samples = { { 0, 0 } };
+            break;
+    }
+
+    uint32_t descriptorSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+    uint32_t dfdSize = 4 + descriptorSize;
+
+    // Key/value data, sorted by key
+    std::vector<std::pair<std::string, std::string>> keyValues = {
+        { "KTXorientation", m_flipped ? "ru" : "rd" },
+        { "KTXwriter", "GameEngine" }
+    };
+
+    uint32_t kvdSize = 0;
+    for (auto& [key, value] : keyValues)
+    {
+        kvdSize += static_cast<uint32_t>(Utils::alignOffset_(4 + key.size() + 1 + value.size() + 1, 4));
+    }
+
+    size_t dfdOffset = Utils::KTX2_HEADER_SIZE + Utils::KTX2_LEVEL_SIZE * m_levels.size();
+    size_t kvdOffset = dfdOffset + dfdSize;
+
+    // Levels are stored smallest first, so a streamed file shows something early
+    std::vector<size_t> levelOffsets(m_levels.size());
+    size_t offset = kvdOffset + kvdSize;
+
+    for (size_t level = m_levels.size(); level-- > 0;)
+    {
+        offset = Utils::alignOffset_(offset, blockSize);
+        levelOffsets[level] = offset;
+        offset += m_levels[level].size;
+    }
+
+    std::vector<uint8_t> file(offset, 0);
+
+    std::memcpy(file.data(), Utils::KTX2_IDENTIFIER, sizeof(Utils::KTX2_IDENTIFIER));
+    Utils::writeValue_<uint32_t>(file, 12, codes->vkFormat);
+    Utils::writeValue_<uint32_t>(file, 16, 1); // typeSize
+    Utils::writeValue_<uint32_t>(file, 20, m_width);
+    Utils::writeValue_<uint32_t>(file, 24, m_height);
+    Utils::writeValue_<uint32_t>(file, 36, 1); // faceCount
+    Utils::writeValue_<uint32_t>(file, 40, getLevelCount());
+    Utils::writeValue_<uint32_t>(file, 48, static_cast<uint32_t>(dfdOffset));
+    Utils::writeValue_<uint32_t>(file, 52, dfdSize);
+    Utils::writeValue_<uint32_t>(file, 56, static_cast<uint32_t>(kvdOffset));
+    Utils::writeValue_<uint32_t>(file, 60, kvdSize);
+
+    for (size_t level = 0; level < m_levels.size(); level++)
+    {
+        size_t entry = Utils::KTX2_HEADER_SIZE + Utils::KTX2_LEVEL_SIZE * level;
+
+        Utils::writeValue_<uint64_t>(file, entry, levelOffsets[level]);
+        Utils::writeValue_<uint64_t>(file, entry + 8, m_levels[level].size);
+        Utils::writeValue_<uint64_t>(file, entry + 16, m_levels[level].size);
+
+        std::memcpy(file.data() + levelOffsets[level], getLevelData(static_cast<uint32_t>(level)), m_levels[level].size);
+    }
+
+    size_t dfd = dfdOffset;
+    Utils::writeValue_<uint32_t>(file, dfd, dfdSize);
+    Utils::writeValue_<uint32_t>(file, dfd + 4, 0); // Khronos vendor, basic descriptor type
+    Utils::writeValue_<uint32_t>(file, dfd + 8, 2 | (descriptorSize << 16)); // Version 2
+    Utils::writeValue_<uint32_t>(file, dfd + 12, colorModel | (1 << 8) | ((m_isSRGB ? 2u : 1u) << 16)); // BT.709 primaries
+    Utils::writeValue_<uint32_t>(file, dfd + 16, 3 | (3 << 8)); // 4x4 texel blocks
+    Utils::writeValue_<uint32_t>(file, dfd + 20, blockSize);
+
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        size_t sample = dfd + 28 + 16 * i;
+        uint32_t bitLength = blockSize * 8 / static_cast<uint32_t>(samples.size()) - 1;
+
+        Utils::writeValue_<uint32_t>(file, sample, samples[i].bitOffset | (bitLength << 16) | (samples[i].channel << 24));
+        Utils::writeValue_<uint32_t>(file, sample + 12, 0xffffffff);
+    }
+
+    size_t keyValue = kvdOffset;
+    for (auto& [key, value] : keyValues)
+    {
+        uint32_t length = static_cast<uint32_t>(key.size() + 1 + value.size() + 1);
+
+        Utils::writeValue_<uint32_t>(file, keyValue, length);
+        std::memcpy(file.data() + keyValue + 4, key.c_str(), key.size() + 1);
+        std::memcpy(file.data() + keyValue + 4 + key.size() + 1, value.c_str(), value.size() + 1);
+
+        keyValue += Utils::alignOffset_(4 + length, 4);
+    }
+
+    // Written under a temporary name, so a failed write never leaves a truncated file behind
+    std::string temporaryPath = path + ".tmp";
+
+    std::ofstream stream(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+    stream.close();
+
+    std::error_code error;
+
+    if (!stream)
+    {
+        Logger::getCoreLogger()->error("Could not write compressed image: %s", path.c_str());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+    return !error;
+}
+
+bool CompressedImage::parseKTX2_(const std::vector<uint8_t>& file)
+{
+    if (file.size() < Utils::KTX2_HEADER_SIZE || std::memcmp(file.data(), Utils::KTX2_IDENTIFIER, sizeof(Utils::KTX2_IDENTIFIER)) != 0)
+    {
+        return false;
+    }
+
+    uint32_t vkFormat = Utils::readValue_<uint32_t>(file, 12);
+    uint32_t depth = Utils::readValue_<uint32_t>(file, 28);
+    uint32_t layers = Utils::readValue_<uint32_t>(file, 32);
+    uint32_t faces = Utils::readValue_<uint32_t>(file, 36);
+    uint32_t levelCount = std::max(Utils::readValue_<uint32_t>(file, 40), 1u);
+    uint32_t supercompression = Utils::readValue_<uint32_t>(file, 44);
+
+    auto codes = std::find_if(std::begin(Utils::FORMAT_CODES), std::end(Utils::FORMAT_CODES), [vkFormat](const Utils::FormatCodes& entry)
+    {
+        return entry.vkFormat == vkFormat;
+    });
+
+    if (codes == std::end(Utils::FORMAT_CODES) || depth > 1 || layers > 1 || faces != 1 || supercompression != 0)
+    {
+        return false;
+    }
+
+    m_format = codes->format;
+    m_isSRGB = codes->isSRGB;
+    m_width = Utils::readValue_<uint32_t>(file, 20);
+    m_height = Utils::readValue_<uint32_t>(file, 24);
+
+    if (m_width == 0 || m_height == 0 || levelCount > Utils::getMaxLevelCount_(m_width, m_height) ||
+        Utils::KTX2_HEADER_SIZE + Utils::KTX2_LEVEL_SIZE * levelCount > file.size())
+    {
+        return false;
+    }
+
+    // Without an orientation, rows are stored top first
+    uint32_t kvdOffset = Utils::readValue_<uint32_t>(file, 56);
+    uint32_t kvdSize = Utils::readValue_<uint32_t>(file, 60);
+
+    if (static_cast<uint64_t>(kvdOffset) + kvdSize <= file.size())
+    {
+        size_t keyValue = kvdOffset;
+
+        while (keyValue + 4 <= static_cast<size_t>(kvdOffset) + kvdSize)
+        {
+            uint32_t length = Utils::readValue_<uint32_t>(file, keyValue);
+
+            if (length > kvdOffset + kvdSize - keyValue - 4)
+            {
+                break;
+            }
+
+            std::string entry(reinterpret_cast<const char*>(file.data() + keyValue + 4), length);
+            size_t separator = entry.find('\0');
+
+            if (separator != std::string::npos && entry.substr(0, separator) == "KTXorientation" && separator + 2 < entry.size())
+            {
+                m_flipped = entry[separator + 2] == 'u';
+            }
+
+            keyValue += Utils::alignOffset_(4 + length, 4);
+        }
+    }
+
+    for (uint32_t index = 0; index < levelCount; index++)
+    {
+        size_t entry = Utils::KTX2_HEADER_SIZE + Utils::KTX2_LEVEL_SIZE * index;
+
+        uint64_t offset = Utils::readValue_<uint64_t>(file, entry);
+        uint64_t size = Utils::readValue_<uint64_t>(file, entry + 8);
+
+        Level level;
+        level.width = std::max(m_width >> index, 1u);
+        level.height = std::max(m_height >> index, 1u);
+        level.offset = m_data.size();
+        level.size = BlockCompression::getSize(m_format, level.width, level.height);
+
+        if (size != level.size || offset > file.size() || size > file.size() - offset)
+        {
+            return false;
+        }
+
+        m_data.insert(m_data.end(), file.begin() + offset, file.begin() + offset + size);
+        m_levels.push_back(level);
+    }
+
+    return true;
+}
+
+bool CompressedImage::parseDDS_(const std::vector<uint8_t>& file)
+{
+    if (file.size() < Utils::DDS_HEADER_SIZE || Utils::readValue_<uint32_t>(file, 0) != Utils::getFourCC_("DDS "))
+    {
+        return false;
+    }
+
+    m_height = Utils::readValue_<uint32_t>(file, 12);
+    m_width = Utils::readValue_<uint32_t>(file, 16);
+
+    uint32_t levelCount = std::max(Utils::readValue_<uint32_t>(file, 28), 1u);
+    uint32_t pixelFormatFlags = Utils::readValue_<uint32_t>(file, 80);
+    uint32_t fourCC = Utils::readValue_<uint32_t>(file, 84);
+    uint32_t caps2 = Utils::readValue_<uint32_t>(file, 112);
+
+    // Cube maps and volumes
+    if ((pixelFormatFlags & 0x4) == 0 || (caps2 & (0x200 | 0x200000)) != 0)
+    {
+        return false;
+    }
+
+    size_t dataOffset = Utils::DDS_HEADER_SIZE;
+
+    if (fourCC == Utils::getFourCC_("DX10"))
+    {
+        if (file.size() < Utils::DDS_HEADER_SIZE + Utils::DDS_DX10_HEADER_SIZE)
+        {
+            return false;
+        }
+
+        uint32_t dxgiFormat = Utils::readValue_<uint32_t>(file, 128);
+        uint32_t dimension = Utils::readValue_<uint32_t>(file, 132);
+        uint32_t miscFlags = Utils::readValue_<uint32_t>(file, 136);
+        uint32_t arraySize = Utils::readValue_<uint32_t>(file, 140);
+
+        auto codes = std::find_if(std::begin(Utils::FORMAT_CODES), std::end(Utils::FORMAT_CODES), [dxgiFormat](const Utils::FormatCodes& entry)
+        {
+            return entry.dxgiFormat != 0 && entry.dxgiFormat == dxgiFormat;
+        });
+
+        if (codes == std::end(Utils::FORMAT_CODES) || dimension != 3 || (miscFlags & 0x4) != 0 || arraySize > 1)
+        {
+            return false;
+        }
+
+        m_format = codes->format;
+        m_isSRGB = codes->isSRGB;
+        dataOffset += Utils::DDS_DX10_HEADER_SIZE;
+    }
+    else if (fourCC == Utils::getFourCC_("DXT1"))
+    {
+        m_format = Format::BC1;
+    }
+    else if (fourCC == Utils::getFourCC_("DXT5"))
+    {
+        m_format = Format::BC3;
+    }
+    else if (fourCC == Utils::getFourCC_("ATI2") || fourCC == Utils::getFourCC_("BC5U"))
+    {
+        m_format = Format::BC5;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (m_width == 0 || m_height == 0 || levelCount > Utils::getMaxLevelCount_(m_width, m_height))
+    {
+        return false;
+    }
+
+    // Rows are stored top first
+    m_flipped = false;
+
+    return readLevels_(file, dataOffset, levelCount);
+}
+
+bool CompressedImage::readLevels_(const std::vector<uint8_t>& file, size_t offset, uint32_t count)
+{
+    for (uint32_t index = 0; index < count; index++)
+    {
+        Level level;
+        level.width = std::max(m_width >> index, 1u);
+        level.height = std::max(m_height >> index, 1u);
+        level.offset = m_data.size();
+        level.size = BlockCompression::getSize(m_format, level.width, level.height);
+
+        if (offset > file.size() || level.size > file.size() - offset)
+        {
+            return false;
+        }
+
+        m_data.insert(m_data.end(), file.begin() + offset, file.begin() + offset + level.size);
+        m_levels.push_back(level);
+
+        offset += level.size;
+    }
+
+    return true;
+}
+
+}
\ No newline at end of file
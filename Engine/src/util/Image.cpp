@@ -1,4 +1,5 @@
 #include <util/Image.h>
+#include <util/io/FileSystem.h>
 #include <core/Logger.h>
 
 #include <stb_image/stb_image.h>
@@ -19,20 +20,30 @@ Image::~Image()
 
 Reference<Image> Image::create(const std::string& path, bool flipped)
 {
-    stbi_set_flip_vertically_on_load(static_cast<int>(flipped));
+    // The flag is per thread, so images can be decoded on worker threads
+    stbi_set_flip_vertically_on_load_thread(static_cast<int>(flipped));
 
-    int width, height, channels;
-    void* data;
+    int width = 0, height = 0, channels = 0;
+    void* data = nullptr;
 
     std::string ext = path.substr(path.find_last_of(".") + 1);
 
+    // Read through the file system, so images can come from archives
+    std::vector<uint8_t> file;
+
     if (ext == "png" || ext == "jpg" || ext == "tga" || ext == "jpeg")
     {
-        data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        if (FileSystem::readBytes(path, file))
+        {
+            data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0);
+        }
     }
     else if (ext == "hdr")
     {
-        data = stbi_loadf(path.c_str(), &width, &height, &channels, 0);
+        if (FileSystem::readBytes(path, file))
+        {
+            data = stbi_loadf_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &channels, 0);
+        }
     }
     else
     {
@@ -50,6 +61,7 @@ Reference<Image> Image::create(const std::string& path, bool flipped)
     image->m_width = width;
     image->m_height = height;
     image->m_channels = channels;
+    image->m_path = path;
     
     switch (channels)
     {
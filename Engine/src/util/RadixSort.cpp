@@ -0,0 +1,50 @@
+#include <util/RadixSort.h>
+
+namespace Engine
+{
+
+void radixSort(const std::vector<uint64_t>& keys, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch)
+{
+    uint32_t count = static_cast<uint32_t>(keys.size());
+
+    order.resize(count);
+    scratch.resize(count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        order[i] = i;
+    }
+
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        uint32_t histogram[256] = {};
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            histogram[(keys[i] >> shift) & 0xFF]++;
+        }
+
+        if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t bucket = histogram[i];
+            histogram[i] = offset;
+            offset += bucket;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t index = order[i];
+            scratch[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+        }
+
+        order.swap(scratch);
+    }
+}
+
+}
\ No newline at end of file
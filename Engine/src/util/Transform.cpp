@@ -17,13 +17,6 @@ Transform::Transform(const math::vec3& translation, const math::vec3& rotation,
     
 }
 
-void Transform::onTransformChange(const Transform& transform)
-{
-    m_worldTranslation = transform.getTranslation();
-    m_worldRotation = transform.getRotation();
-    m_worldScale = transform.getScale();
-}
-
 void Transform::setTranslation(const math::vec3& translation)
 {
     m_translation = translation;
@@ -98,21 +91,97 @@ void Transform::scale(float x, float y, float z)
 
 void Transform::transformChanged()
 {
-    m_owner->onTransformChange(*this);
+    m_localDirty = true;
+    invalidateWorld_();
+
+    if (GameObject* owner = getOwner())
+    {
+        owner->markTransformsDirty_();
+    }
 }
 
-math::mat4 Transform::matrix() const
+void Transform::invalidateWorld_()
 {
-    return math::translate(math::mat4(1.f), m_translation)
-         * math::to_mat4(math::quat(math::radians(m_rotation)))
-         * math::scale(math::mat4(1.f), m_scale);
+    m_changed = true;
+
+    // If this transform was already dirty, so is everything below it
+    if (m_worldDirty)
+    {
+        return;
+    }
+
+    m_worldDirty = true;
+
+    if (GameObject* owner = getOwner())
+    {
+        owner->invalidateChildTransforms_();
+    }
 }
 
-math::mat4 Transform::worldMatrix() const
+const Transform* Transform::getParentTransform_() const
 {
-    return math::translate(math::mat4(1.f), m_worldTranslation + m_translation)
-         * math::to_mat4(math::quat(math::radians(m_worldRotation + m_rotation)))
-         * math::scale(math::mat4(1.f), m_worldScale * m_scale);
+    GameObject* owner = getOwner();
+
+    if (!owner)
+    {
+        return nullptr;
+    }
+
+    for (GameObject* parent = owner->getParent(); parent != nullptr; parent = parent->getParent())
+    {
+        if (auto transform = parent->getComponent<Transform>())
+        {
+            return transform;
+        }
+    }
+
+    return nullptr;
 }
 
-}
\ No newline at end of file
+void Transform::updateWorld_() const
+{
+    if (!m_worldDirty)
+    {
+        return;
+    }
+
+    const Transform* parent = getParentTransform_();
+
+    if (parent)
+    {
+        m_worldMatrix = parent->worldMatrix() * matrix();
+        m_worldRotation = parent->getWorldRotation() + m_rotation;
+        m_worldScale = parent->getWorldScale() * m_scale;
+    }
+    else
+    {
+        m_worldMatrix = matrix();
+        m_worldRotation = m_rotation;
+        m_worldScale = m_scale;
+    }
+
+    m_worldTranslation = math::vec3(m_worldMatrix[3]);
+    m_worldDirty = false;
+}
+
+const math::mat4& Transform::matrix() const
+{
+    if (m_localDirty)
+    {
+        m_localMatrix = math::translate(math::mat4(1.f), m_translation)
+                      * math::to_mat4(math::quat(math::radians(m_rotation)))
+                      * math::scale(math::mat4(1.f), m_scale);
+
+        m_localDirty = false;
+    }
+
+    return m_localMatrix;
+}
+
+const math::mat4& Transform::worldMatrix() const
+{
+    updateWorld_();
+    return m_worldMatrix;
+}
+
+}
@@ -0,0 +1,68 @@
+#include <util/Utf8.h>
+
+namespace Engine
+{
+
+uint32_t decodeUtf8(const std::string& text, size_t& index)
+{
+    uint8_t lead = static_cast<uint8_t>(text[index++]);
+
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    uint32_t length = 0;
+    uint32_t codePoint = 0;
+    uint32_t minimum = 0;
+
+    if ((lead & 0xE0) == 0xC0)
+    {
+        length = 1;
+        codePoint = lead & 0x1F;
+        minimum = 0x80;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        length = 2;
+        codePoint = lead & 0x0F;
+        minimum = 0x800;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        length = 3;
+        codePoint = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else
+    {
+        return UTF8_REPLACEMENT_CHARACTER;
+    }
+
+    if (index + length > text.size())
+    {
+        return UTF8_REPLACEMENT_CHARACTER;
+    }
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint8_t continuation = static_cast<uint8_t>(text[index + i]);
+
+        if ((continuation & 0xC0) != 0x80)
+        {
+            return UTF8_REPLACEMENT_CHARACTER;
+        }
+
+        codePoint = (codePoint << 6) | (continuation & 0x3F);
+    }
+
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        return UTF8_REPLACEMENT_CHARACTER;
+    }
+
+    index += length;
+    return codePoint;
+}
+
+}
\ No newline at end of file
@@ -7,16 +7,17 @@
 #include <util/Transform.h>
 #include <scene/SceneCamera.h>
 #include <renderer/Lighting.h>
+#include <util/io/FileSystem.h>
 
 namespace Engine
 {
 
 Reference<Material> Deserializer::loadMaterial(const std::string& path)
 {
-    YAML::Node meta = YAML::LoadFile(path + ".meta");
+    YAML::Node meta = loadYAML(path + ".meta");
     std::string uuid = meta["uuid"].as<std::string>();
 
-    YAML::Node root = YAML::LoadFile(path);
+    YAML::Node root = loadYAML(path);
     auto matNode = root["Material"];
 
     std::string name = matNode["Name"].as<std::string>();
@@ -36,7 +37,7 @@ Reference<Material> Deserializer::loadMaterial(const std::string& path)
 
 Reference<Texture2D> Deserializer::loadTexture(const std::string& path)
 {
-    YAML::Node meta = YAML::LoadFile(path + ".meta");
+    YAML::Node meta = loadYAML(path + ".meta");
     std::string uuid = meta["uuid"].as<std::string>();
     bool clamp = meta["Texture"]["Clamp"].as<bool>();
     bool linear = meta["Texture"]["Linear"].as<bool>();
@@ -47,21 +48,21 @@ Reference<Texture2D> Deserializer::loadTexture(const std::string& path)
 
 Reference<Shader> Deserializer::loadShader(const std::string& path)
 {
-    YAML::Node meta = YAML::LoadFile(path + ".meta");
+    YAML::Node meta = loadYAML(path + ".meta");
 
     return Shader::createFromFile(path);
 }
 
 Reference<Mesh> Deserializer::loadMesh(const std::string& path)
 {
-    YAML::Node meta = YAML::LoadFile(path + ".meta");
+    YAML::Node meta = loadYAML(path + ".meta");
 
     return Mesh::load(path, 0);
 }
 
 Reference<Scene> Deserializer::loadScene(const std::string& path)
 {
-    YAML::Node node = YAML::LoadFile(path);
+    YAML::Node node = loadYAML(path);
 
     auto scene = Scene::create();
     scene->setPath(path);
@@ -135,6 +136,8 @@ void Deserializer::loadGameObject(GameObject& parent, YAML::Node& node)
         sr->textureRect.y = node["Sprite Renderer"]["Texture Rect"][1].as<float>();
         sr->textureRect.w = node["Sprite Renderer"]["Texture Rect"][2].as<float>();
         sr->textureRect.h = node["Sprite Renderer"]["Texture Rect"][3].as<float>();
+
+        sr->layer = node["Sprite Renderer"]["Layer"].as<int32_t>(0);
     }
 
     if (node["Mesh"])
@@ -154,6 +157,9 @@ void Deserializer::loadGameObject(GameObject& parent, YAML::Node& node)
         {
             meshRenderer->material = Assets::get<Material>(material);
         }
+
+        meshRenderer->castShadows = node["Mesh Renderer"]["Cast Shadows"].as<bool>(true);
+        meshRenderer->isStatic = node["Mesh Renderer"]["Static"].as<bool>(false);
     }
 
     if (node["Directional Light"])
@@ -199,4 +205,16 @@ void Deserializer::loadGameObject(GameObject& parent, YAML::Node& node)
     }
 }
 
+YAML::Node Deserializer::loadYAML(const std::string& path)
+{
+    std::vector<uint8_t> data;
+
+    if (!FileSystem::readBytes(path, data))
+    {
+        throw YAML::BadFile(path);
+    }
+
+    return YAML::Load(std::string(data.begin(), data.end()));
+}
+
 }
\ No newline at end of file
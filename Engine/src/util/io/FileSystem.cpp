@@ -1,12 +1,20 @@
 #include <util/io/FileSystem.h>
+#include <util/io/PackArchive.h>
+#include <core/Logger.h>
+#include <util/Timer.h>
 
+#include <algorithm>
 #include <filesystem>
+#include <mutex>
 
 namespace Engine
 {
 
 std::string FileSystem::m_assetDirectoryPath = "./";
 
+std::vector<Reference<PackArchive>> FileSystem::m_archives;
+std::shared_mutex FileSystem::m_archiveMutex;
+
 FileStream::FileStream(FILE* file, Mode mode)
     : m_file(file), m_mode(mode)
 {
@@ -30,6 +38,55 @@ Reference<FileStream> FileStream::create(const std::string& filepath, Mode mode)
     return Reference<FileStream>(new FileStream(file, mode));
 }
 
+bool FileSystem::mount(const std::string& archivePath)
+{
+    Timer timer;
+
+    auto archive = PackArchive::open(archivePath);
+
+    if (!archive)
+    {
+        return false;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(m_archiveMutex);
+        m_archives.push_back(archive);
+    }
+
+    Logger::getCoreLogger()->info("Mounted %s with %u files in %fms", archivePath.c_str(), archive->getEntryCount(), timer.getMillis());
+
+    return true;
+}
+
+void FileSystem::unmountAll()
+{
+    std::unique_lock<std::shared_mutex> lock(m_archiveMutex);
+    m_archives.clear();
+}
+
+void FileSystem::mountArchives(const std::string& directory)
+{
+    std::error_code error;
+    std::vector<std::string> archives;
+
+    for (auto& file : std::filesystem::directory_iterator(directory, error))
+    {
+        if (file.is_regular_file(error) && file.path().extension() == ".pak")
+        {
+            archives.push_back(file.path().string());
+        }
+    }
+
+    // Mounted in name order, so which archive wins doesn't depend on the directory's order
+    std::sort(archives.begin(), archives.end());
+
+    for (auto& archive : archives)
+    {
+        mount(archive);
+    }
+}
+
 void FileSystem::setAssetDirectoryPath(const std::string& path)
 {
     m_assetDirectoryPath = path;
@@ -60,11 +117,85 @@ void FileSystem::writeToFile(const std::string& path, const std::string& text)
 
 std::string FileSystem::readFile(const std::string& path)
 {
-    std::ifstream file(path);
+    std::vector<uint8_t> data;
+    readBytes(path, data);
+
+    return std::string(data.begin(), data.end());
+}
+
+bool FileSystem::readBytes(const std::string& path, std::vector<uint8_t>& data)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(m_archiveMutex);
+
+        for (auto archive = m_archives.rbegin(); archive != m_archives.rend(); archive++)
+        {
+            if ((*archive)->read(path, data))
+            {
+                return true;
+            }
+        }
+    }
+
+    return readLooseFile_(path, data);
+}
+
+bool FileSystem::readView(const std::string& path, FileView& view)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(m_archiveMutex);
+
+        for (auto archive = m_archives.rbegin(); archive != m_archives.rend(); archive++)
+        {
+            PackView packView;
+
+            if ((*archive)->view(path, packView, view.storage))
+            {
+                view.data = packView.data;
+                view.size = packView.size;
+                view.archive = *archive;
+                return true;
+            }
+        }
+    }
+
+    view.archive = nullptr;
+
+    bool read = readLooseFile_(path, view.storage);
+
+    view.data = view.storage.data();
+    view.size = view.storage.size();
 
-    std::ostringstream stream;
-    stream << file.rdbuf();
-    return stream.str();
+    return read;
+}
+
+bool FileSystem::readLooseFile_(const std::string& path, std::vector<uint8_t>& data)
+{
+    // Only regular files have a size, so directories and missing files are both rejected here
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(path, error);
+
+    if (error)
+    {
+        data.clear();
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+
+    data.resize(static_cast<size_t>(size));
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+    // Opening or reading can still fail, e.g. without permission or if the file was truncated meanwhile
+    if (!file)
+    {
+        Logger::getCoreLogger()->error("Could not read %s", path.c_str());
+
+        data.clear();
+        return false;
+    }
+
+    return true;
 }
 
 void FileSystem::writeToBinaryFile(const std::string& path, void* data, size_t size)
@@ -80,30 +211,32 @@ void FileSystem::writeToBinaryFile(const std::string& path, void* data, size_t s
 
 char* FileSystem::readBinaryFile(const std::string& path, size_t size)
 {
-    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::vector<uint8_t> bytes;
+    readBytes(path, bytes);
 
     char* data = new char[size];
 
-    file.read(&data[0], size);
-
-    file.close();
+    std::copy_n(bytes.begin(), std::min(size, bytes.size()), data);
 
     return data;
 }
 
 bool FileSystem::exists(const std::string& path)
 {
-    FILE* file = fopen(path.c_str(), "r");
-
-    if (file)
     {
-        fclose(file);
-        return true;
-    }
-    else
-    {
-        return false;
+        std::shared_lock<std::shared_mutex> lock(m_archiveMutex);
+
+        for (auto& archive : m_archives)
+        {
+            if (archive->contains(path))
+            {
+                return true;
+            }
+        }
     }
+
+    std::error_code error;
+    return std::filesystem::exists(path, error);
 }
 
 std::string FileSystem::getExtension(const std::string& path)
@@ -0,0 +1,293 @@
+#include <util/io/Lz4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Engine
+{
+
+namespace Utils
+{
+    static constexpr uint32_t LZ4_MIN_MATCH = 4;
+    static constexpr uint32_t LZ4_HASH_BITS = 16;
+    static constexpr size_t LZ4_LAST_LITERALS = 5; // The format requires a block to end with literals
+    static constexpr size_t LZ4_MATCH_LIMIT = 12; // No match may start closer than this to the end
+    static constexpr size_t LZ4_MAX_OFFSET = 65535;
+
+    uint32_t readLz4Word_(const uint8_t* data)
+    {
+        uint32_t word;
+        std::memcpy(&word, data, sizeof(uint32_t));
+        return word;
+    }
+
+    uint32_t hashLz4Word_(uint32_t word)
+    {
+        return (word * 2654435761u) >> (32 - LZ4_HASH_BITS);
+    }
+
+    // Lengths of 15 and above continue in extra bytes of up to 255 each
+    bool writeLz4Length_(size_t length, uint8_t*& write, const uint8_t* end)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            if (write >= end)
+            {
+                return false;
+            }
+
+            *write++ = 255;
+        }
+
+        if (write >= end)
+        {
+            return false;
+        }
+
+        *write++ = static_cast<uint8_t>(length);
+        return true;
+    }
+
+    bool readLz4Length_(const uint8_t*& read, const uint8_t* end, size_t& length)
+    {
+        uint8_t byte;
+
+        do
+        {
+            if (read >= end)
+            {
+                return false;
+            }
+
+            byte = *read++;
+            length += byte;
+        } while (byte == 255);
+
+        return true;
+    }
+
+    bool writeLz4Sequence_(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength, uint8_t*& write, const uint8_t* end)
+    {
+        if (write >= end)
+        {
+            return false;
+        }
+
+        uint8_t* token = write++;
+        *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+
+        if (literalLength >= 15 && !writeLz4Length_(literalLength - 15, write, end))
+        {
+            return false;
+        }
+
+        if (static_cast<size_t>(end - write) < literalLength)
+        {
+            return false;
+        }
+
+        std::memcpy(write, literals, literalLength);
+        write += literalLength;
+
+        // The last sequence only has literals
+        if (matchLength == 0)
+        {
+            return true;
+        }
+
+        if (end - write < 2)
+        {
+            return false;
+        }
+
+        *write++ = static_cast<uint8_t>(offset & 0xff);
+        *write++ = static_cast<uint8_t>(offset >> 8);
+
+        matchLength -= LZ4_MIN_MATCH;
+        *token |= static_cast<uint8_t>(std::min<size_t>(matchLength, 15));
+
+        return matchLength < 15 || writeLz4Length_(matchLength - 15, write, end);
+    }
+}
+
+size_t Lz4::getMaxCompressedSize(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t Lz4::getMaxDecompressedSize(size_t compressedSize)
+{
+    return compressedSize * 255 + 16;
+}
+
+size_t Lz4::compress(const uint8_t* source, size_t size, uint8_t* destination, size_t capacity)
+{
+    uint8_t* write = destination;
+    const uint8_t* end = destination + capacity;
+
+    size_t anchor = 0;
+
+    if (size > Utils::LZ4_MATCH_LIMIT)
+    {
+        // Last position each hashed 4 byte sequence was seen at
+        std::vector<uint32_t> table(static_cast<size_t>(1) << Utils::LZ4_HASH_BITS, 0);
+
+        size_t position = 0;
+        size_t limit = size - Utils::LZ4_MATCH_LIMIT;
+        size_t matchEnd = size - Utils::LZ4_LAST_LITERALS;
+
+        while (position < limit)
+        {
+            uint32_t word = Utils::readLz4Word_(source + position);
+            uint32_t hash = Utils::hashLz4Word_(word);
+
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(position);
+
+            if (candidate >= position || position - candidate > Utils::LZ4_MAX_OFFSET || Utils::readLz4Word_(source + candidate) != word)
+            {
+                position++;
+                continue;
+            }
+
+            // Grow the match backwards into pending literals, then forwards
+            while (position > anchor && candidate > 0 && source[position - 1] == source[candidate - 1])
+            {
+                position--;
+                candidate--;
+            }
+
+            size_t length = Utils::LZ4_MIN_MATCH;
+            while (position + length < matchEnd && source[candidate + length] == source[position + length])
+            {
+                length++;
+            }
+
+            if (!Utils::writeLz4Sequence_(source + anchor, position - anchor, position - candidate, length, write, end))
+            {
+                return 0;
+            }
+
+            position += length;
+            anchor = position;
+
+            if (position - 2 < limit)
+            {
+                table[Utils::hashLz4Word_(Utils::readLz4Word_(source + position - 2))] = static_cast<uint32_t>(position - 2);
+            }
+        }
+    }
+
+    if (!Utils::writeLz4Sequence_(source + anchor, size - anchor, 0, 0, write, end))
+    {
+        return 0;
+    }
+
+    return write - destination;
+}
+
+bool Lz4::decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t size)
+{
+    const uint8_t* read = source;
+    const uint8_t* readEnd = source + sourceSize;
+
+    uint8_t* write = destination;
+    const uint8_t* writeEnd = destination + size;
+
+    while (true)
+    {
+        if (read >= readEnd)
+        {
+            return false;
+        }
+
+        uint8_t token = *read++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !Utils::readLz4Length_(read, readEnd, literalLength))
+        {
+            return false;
+        }
+
+        if (literalLength > static_cast<size_t>(readEnd - read) || literalLength > static_cast<size_t>(writeEnd - write))
+        {
+            return false;
+        }
+
+        // Short runs are copied as a whole word, the bytes past the run being overwritten by what follows it
+        if (literalLength <= 16 && readEnd - read >= 16 && writeEnd - write >= 16)
+        {
+            std::memcpy(write, read, 16);
+        }
+        else
+        {
+            std::memcpy(write, read, literalLength);
+        }
+
+        read += literalLength;
+        write += literalLength;
+
+        if (read == readEnd)
+        {
+            return write == writeEnd;
+        }
+
+        if (readEnd - read < 2)
+        {
+            return false;
+        }
+
+        size_t offset = read[0] | (static_cast<size_t>(read[1]) << 8);
+        read += 2;
+
+        if (offset == 0 || offset > static_cast<size_t>(write - destination))
+        {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !Utils::readLz4Length_(read, readEnd, matchLength))
+        {
+            return false;
+        }
+
+        matchLength += Utils::LZ4_MIN_MATCH;
+
+        if (matchLength > static_cast<size_t>(writeEnd - write))
+        {
+            return false;
+        }
+
+        const uint8_t* match = write - offset;
+
+        if (matchLength <= 16 && offset >= 16 && writeEnd - write >= 16)
+        {
+            std::memcpy(write, match, 16);
+        }
+        else if (offset >= matchLength)
+        {
+            std::memcpy(write, match, matchLength);
+        }
+        else
+        {
+            // The match overlaps the bytes it produces. Copied forwards, in words while every word read lies at least
+            // 'offset' bytes back and so is already written.
+            size_t i = 0;
+
+            for (; offset >= 8 && i + 8 <= matchLength; i += 8)
+            {
+                std::memcpy(write + i, match + i, 8);
+            }
+
+            for (; i < matchLength; i++)
+            {
+                write[i] = match[i];
+            }
+        }
+
+        write += matchLength;
+    }
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,430 @@
+#include <util/io/PackArchive.h>
+#include <util/io/Lz4.h>
+#include <core/Logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+namespace Engine
+{
+
+namespace Utils
+{
+    static constexpr char PACK_MAGIC[4] = { 'E', 'P', 'A', 'K' };
+
+    // Largest file an entry may decompress to, reading one allocates all of it up front
+    static constexpr uint64_t MAX_PACK_ENTRY_SIZE = 1ull << 32;
+
+    // FNV-1a
+    uint64_t hashPackPath_(std::string_view path)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (char c : path)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Whether normalizePath() would return the path unchanged
+    bool isNormalPackPath_(std::string_view path)
+    {
+        if (!path.empty() && path.back() == '/')
+        {
+            return false;
+        }
+
+        // A leading slash is kept, every component after it must be a plain name
+        size_t start = !path.empty() && path[0] == '/' ? 1 : 0;
+
+        while (start < path.size())
+        {
+            size_t end = std::min(path.find('/', start), path.size());
+            std::string_view component = path.substr(start, end - start);
+
+            if (component.empty() || component == "." || component == ".." || component.find('\\') != std::string_view::npos)
+            {
+                return false;
+            }
+
+            start = end + 1;
+        }
+
+        return true;
+    }
+
+    bool readPackSource_(const std::string& path, std::vector<uint8_t>& data)
+    {
+        // Directories and missing files have no size, where tellg() would report garbage for a directory
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(path, error);
+
+        if (error)
+        {
+            return false;
+        }
+
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+
+        data.resize(static_cast<size_t>(size));
+        file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+        return static_cast<bool>(file);
+    }
+}
+
+Reference<PackArchive> PackArchive::open(const std::string& path)
+{
+    auto archive = createReference<PackArchive>();
+    archive->m_path = path;
+
+    if (!archive->m_file.open(path))
+    {
+        Logger::getCoreLogger()->error("Could not open archive: %s", path.c_str());
+        return nullptr;
+    }
+
+    if (!archive->validate_())
+    {
+        Logger::getCoreLogger()->error("Invalid archive: %s", path.c_str());
+        return nullptr;
+    }
+
+    return archive;
+}
+
+bool PackArchive::build(const std::string& path, const std::vector<PackSource>& sources, PackStatistics* statistics)
+{
+    struct PendingEntry
+    {
+        std::string path;
+        PackEntry entry;
+        std::vector<uint8_t> data;
+        size_t source; // Index into 'sources'
+    };
+
+    std::vector<PendingEntry> pending;
+    pending.reserve(sources.size());
+
+    std::vector<uint8_t> source;
+
+    for (auto& file : sources)
+    {
+        if (!Utils::readPackSource_(file.filePath, source))
+        {
+            Logger::getCoreLogger()->error("Could not read file to pack: %s", file.filePath.c_str());
+            return false;
+        }
+
+        PendingEntry& pendingEntry = pending.emplace_back();
+        pendingEntry.path = normalizePath(file.archivePath);
+        pendingEntry.source = pending.size() - 1;
+
+        PackEntry& entry = pendingEntry.entry;
+        std::memset(&entry, 0, sizeof(PackEntry));
+
+        entry.pathHash = Utils::hashPackPath_(pendingEntry.path);
+        entry.size = source.size();
+
+        // Compressed only if that shrinks the file fourfold, anything less reads faster as is, see PackArchive.h
+        pendingEntry.data.resize(Lz4::getMaxCompressedSize(source.size()));
+        size_t compressedSize = Lz4::compress(source.data(), source.size(), pendingEntry.data.data(), pendingEntry.data.size());
+
+        if (compressedSize > 0 && compressedSize <= source.size() / 4 && source.size() <= Utils::MAX_PACK_ENTRY_SIZE)
+        {
+            pendingEntry.data.resize(compressedSize);
+            entry.compressed = 1;
+        }
+        else
+        {
+            pendingEntry.data = source;
+        }
+
+        entry.storedSize = pendingEntry.data.size();
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry& a, const PendingEntry& b)
+    {
+        return a.entry.pathHash < b.entry.pathHash || (a.entry.pathHash == b.entry.pathHash && a.path < b.path);
+    });
+
+    for (size_t i = 1; i < pending.size(); i++)
+    {
+        if (pending[i].path == pending[i - 1].path)
+        {
+            Logger::getCoreLogger()->error("File packed twice: %s", pending[i].path.c_str());
+            return false;
+        }
+    }
+
+    std::string strings;
+
+    for (auto& pendingEntry : pending)
+    {
+        pendingEntry.entry.pathOffset = static_cast<uint32_t>(strings.size());
+        strings += pendingEntry.path;
+        strings += '\0';
+    }
+
+    PackHeader header;
+    std::memset(&header, 0, sizeof(PackHeader));
+    std::memcpy(header.magic, Utils::PACK_MAGIC, sizeof(header.magic));
+
+    header.version = VERSION;
+    header.entryCount = static_cast<uint32_t>(pending.size());
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+
+    uint64_t offset = sizeof(PackHeader) + sizeof(PackEntry) * pending.size() + strings.size();
+
+    // Entries are sorted by hash for lookups, while their data keeps the order of 'sources', which is usually the
+    // order they are loaded in, so reading them all goes through the archive front to back
+    std::vector<PendingEntry*> dataOrder(pending.size());
+
+    for (auto& pendingEntry : pending)
+    {
+        dataOrder[pendingEntry.source] = &pendingEntry;
+    }
+
+    for (auto pendingEntry : dataOrder)
+    {
+        pendingEntry->entry.offset = offset;
+        offset += pendingEntry->entry.storedSize;
+    }
+
+    // Written under a temporary name, so a failed build never replaces a working archive
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+
+    for (auto& pendingEntry : pending)
+    {
+        file.write(reinterpret_cast<const char*>(&pendingEntry.entry), sizeof(PackEntry));
+    }
+
+    file.write(strings.data(), strings.size());
+
+    for (auto pendingEntry : dataOrder)
+    {
+        file.write(reinterpret_cast<const char*>(pendingEntry->data.data()), pendingEntry->data.size());
+    }
+
+    file.close();
+
+    std::error_code error;
+
+    if (!file)
+    {
+        Logger::getCoreLogger()->error("Could not write archive: %s", path.c_str());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(temporaryPath, path, error);
+
+    if (error)
+    {
+        Logger::getCoreLogger()->error("Could not write archive: %s", path.c_str());
+        return false;
+    }
+
+    if (statistics)
+    {
+        *statistics = PackStatistics();
+        statistics->files = static_cast<uint32_t>(pending.size());
+
+        for (auto& pendingEntry : pending)
+        {
+            statistics->compressed += pendingEntry.entry.compressed;
+            statistics->size += pendingEntry.entry.size;
+            statistics->storedSize += pendingEntry.entry.storedSize;
+        }
+    }
+
+    return true;
+}
+
+std::string PackArchive::normalizePath(const std::string& path)
+{
+    std::string normalized = path;
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+    normalized = std::filesystem::path(normalized).lexically_normal().generic_string();
+
+    if (normalized == ".")
+    {
+        return "";
+    }
+
+    return normalized;
+}
+
+bool PackArchive::contains(const std::string& path) const
+{
+    return lookup_(path) != nullptr;
+}
+
+bool PackArchive::read(const std::string& path, std::vector<uint8_t>& data) const
+{
+    const PackEntry* entry = lookup_(path);
+
+    if (!entry)
+    {
+        return false;
+    }
+
+    data.resize(entry->size);
+
+    if (!entry->compressed)
+    {
+        std::memcpy(data.data(), m_file.getData() + entry->offset, entry->size);
+        return true;
+    }
+
+    if (!decompress_(*entry, data.data()))
+    {
+        data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool PackArchive::view(const std::string& path, PackView& view, std::vector<uint8_t>& storage) const
+{
+    const PackEntry* entry = lookup_(path);
+
+    if (!entry)
+    {
+        return false;
+    }
+
+    if (!entry->compressed)
+    {
+        view.data = m_file.getData() + entry->offset;
+        view.size = entry->size;
+        return true;
+    }
+
+    storage.resize(entry->size);
+
+    if (!decompress_(*entry, storage.data()))
+    {
+        storage.clear();
+        return false;
+    }
+
+    view.data = storage.data();
+    view.size = storage.size();
+
+    return true;
+}
+
+bool PackArchive::validate_() const
+{
+    size_t fileSize = m_file.getSize();
+
+    if (fileSize < sizeof(PackHeader))
+    {
+        return false;
+    }
+
+    const PackHeader& header = getHeader_();
+
+    if (std::memcmp(header.magic, Utils::PACK_MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION)
+    {
+        return false;
+    }
+
+    uint64_t tablesSize = sizeof(PackHeader) + static_cast<uint64_t>(sizeof(PackEntry)) * header.entryCount + header.stringsSize;
+
+    if (tablesSize > fileSize)
+    {
+        return false;
+    }
+
+    if (header.stringsSize > 0 && getStrings_()[header.stringsSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.entryCount; i++)
+    {
+        const PackEntry& entry = getEntries_()[i];
+
+        if (entry.pathOffset >= header.stringsSize || entry.offset > fileSize || entry.storedSize > fileSize - entry.offset)
+        {
+            return false;
+        }
+
+        if (!entry.compressed && entry.storedSize != entry.size)
+        {
+            return false;
+        }
+
+        // A corrupted size mustn't make read() allocate more than the entry could possibly hold
+        if (entry.compressed && (entry.size > Lz4::getMaxDecompressedSize(entry.storedSize) || entry.size > Utils::MAX_PACK_ENTRY_SIZE))
+        {
+            return false;
+        }
+
+        if (i > 0 && getEntries_()[i - 1].pathHash > entry.pathHash)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const PackEntry* PackArchive::lookup_(const std::string& path) const
+{
+    if (Utils::isNormalPackPath_(path))
+    {
+        return findEntry_(path);
+    }
+
+    return findEntry_(normalizePath(path));
+}
+
+const PackEntry* PackArchive::findEntry_(std::string_view path) const
+{
+    uint64_t hash = Utils::hashPackPath_(path);
+
+    const PackEntry* begin = getEntries_();
+    const PackEntry* end = begin + getEntryCount();
+
+    const PackEntry* entry = std::lower_bound(begin, end, hash, [](const PackEntry& entry, uint64_t hash)
+    {
+        return entry.pathHash < hash;
+    });
+
+    // Paths are compared as well, in case two hash the same
+    for (; entry != end && entry->pathHash == hash; entry++)
+    {
+        if (path == getStrings_() + entry->pathOffset)
+        {
+            return entry;
+        }
+    }
+
+    return nullptr;
+}
+
+bool PackArchive::decompress_(const PackEntry& entry, uint8_t* data) const
+{
+    if (!Lz4::decompress(m_file.getData() + entry.offset, entry.storedSize, data, entry.size))
+    {
+        Logger::getCoreLogger()->error("Corrupted entry %s in archive %s", getStrings_() + entry.pathOffset, m_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+}
\ No newline at end of file
@@ -141,6 +141,8 @@ void Serializer::saveGameObject(YAML::Node& node, GameObject& object)
         spriteRenderer["Texture Rect"].push_back<float>(comp->textureRect.w);
         spriteRenderer["Texture Rect"].push_back<float>(comp->textureRect.h);
         spriteRenderer["Texture Rect"].SetStyle(YAML::EmitterStyle::Flow);
+
+        spriteRenderer["Layer"] = comp->layer;
     }
 
     if (object.hasComponent<MeshComponent>())
@@ -158,6 +160,8 @@ void Serializer::saveGameObject(YAML::Node& node, GameObject& object)
         auto meshRenderer = node["Mesh Renderer"];
 
         meshRenderer["Material"] = comp->material ? comp->material->name : "";
+        meshRenderer["Cast Shadows"] = comp->castShadows;
+        meshRenderer["Static"] = comp->isStatic;
     }
 
     if (object.hasComponent<DirectionalLight>())
@@ -0,0 +1,69 @@
+#include <util/io/PackArchive.h>
+#include <util/Timer.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+using namespace Engine;
+
+// Packs directories into an archive the engine mounts with FileSystem::mount(). Files are stored under their paths
+// as given on the command line, so pack from the directory the game runs in:
+//   PackTool assets.pak Editor/assets Engine/assets
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: PackTool <archive.pak> <directory or file>...\n";
+        return 1;
+    }
+
+    std::vector<PackSource> sources;
+
+    for (int i = 2; i < argc; i++)
+    {
+        std::error_code error;
+
+        if (std::filesystem::is_regular_file(argv[i], error))
+        {
+            sources.push_back({ argv[i], argv[i] });
+            continue;
+        }
+
+        if (!std::filesystem::is_directory(argv[i], error))
+        {
+            std::cout << "No such file or directory: " << argv[i] << "\n";
+            return 1;
+        }
+
+        for (auto& file : std::filesystem::recursive_directory_iterator(argv[i], error))
+        {
+            if (file.is_regular_file(error))
+            {
+                sources.push_back({ file.path().generic_string(), file.path().string() });
+            }
+        }
+    }
+
+    // Same input, same archive
+    std::sort(sources.begin(), sources.end(), [](const PackSource& a, const PackSource& b)
+    {
+        return a.archivePath < b.archivePath;
+    });
+
+    Timer timer;
+    PackStatistics statistics;
+
+    if (!PackArchive::build(argv[1], sources, &statistics))
+    {
+        return 1;
+    }
+
+    double ratio = statistics.size > 0 ? 100.0 * statistics.storedSize / statistics.size : 100.0;
+
+    std::cout << "Packed " << statistics.files << " files (" << statistics.compressed << " compressed) into " << argv[1]
+              << ": " << statistics.size << " -> " << statistics.storedSize << " bytes (" << ratio << "%) in "
+              << timer.getMillis() << "ms\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+project "TextureTool"
+
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+    targetdir "%{wks.location}/bin/%{cfg.buildcfg}/TextureTool"
+	objdir "%{wks.location}/obj/%{cfg.buildcfg}/TextureTool"
+
+	files {
+		"src/**.cpp",
+		"src/**.h"
+	}
+	
+	includedirs {
+		"%{wks.location}/Engine/include"
+	}
+	
+	libdirs {
+		"%{wks.location}/bin/Debug"
+	}
+	
+	links {
+		"GameEngine",
+		"pthread"
+	}
+	
+	filter "configurations:Debug"
+        defines "ENGINE_DEBUG"
+        runtime "Release"
+        symbols "On"
+
+    filter "configurations:Release"
+        runtime "Release"
+        optimize "On"
\ No newline at end of file
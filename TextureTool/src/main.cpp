@@ -0,0 +1,258 @@
+#include <util/Image.h>
+#include <util/CompressedImage.h>
+#include <util/BlockCompression.h>
+#include <util/Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+static float toLinear(uint8_t value)
+{
+    float color = value / 255.f;
+    return color <= 0.04045f ? color / 12.92f : std::pow((color + 0.055f) / 1.055f, 2.4f);
+}
+
+static uint8_t toSRGB(float color)
+{
+    color = color <= 0.0031308f ? color * 12.92f : 1.055f * std::pow(color, 1.f / 2.4f) - 0.055f;
+    return static_cast<uint8_t>(std::lround(std::min(std::max(color, 0.f), 1.f) * 255.f));
+}
+
+// Expands the image's channels to RGBA: grey to RGB, and opaque alpha where there is none
+static std::vector<uint8_t> toRGBA(const Image& image)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(image.getData());
+    size_t pixels = static_cast<size_t>(image.getWidth()) * image.getHeight();
+    int channels = image.getChannels();
+
+    std::vector<uint8_t> rgba(pixels * 4);
+
+    for (size_t i = 0; i < pixels; i++)
+    {
+        const uint8_t* pixel = data + i * channels;
+        uint8_t* output = rgba.data() + i * 4;
+
+        for (int channel = 0; channel < 3; channel++)
+        {
+            output[channel] = channels >= 3 ? pixel[channel] : pixel[0];
+        }
+
+        output[3] = channels == 4 ? pixel[3] : channels == 2 ? pixel[1] : 255;
+    }
+
+    return rgba;
+}
+
+// Halves the image with a box filter. Color is averaged in linear space unless the data isn't sRGB color.
+static std::vector<uint8_t> downsample(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, bool isSRGB)
+{
+    uint32_t nextWidth = std::max(width / 2, 1u);
+    uint32_t nextHeight = std::max(height / 2, 1u);
+
+    std::vector<uint8_t> next(static_cast<size_t>(nextWidth) * nextHeight * 4);
+
+    for (uint32_t y = 0; y < nextHeight; y++)
+    {
+        for (uint32_t x = 0; x < nextWidth; x++)
+        {
+            float sums[4] = {};
+
+            for (uint32_t sample = 0; sample < 4; sample++)
+            {
+                uint32_t column = std::min(x * 2 + sample % 2, width - 1);
+                uint32_t row = std::min(y * 2 + sample / 2, height - 1);
+                const uint8_t* pixel = pixels.data() + (static_cast<size_t>(row) * width + column) * 4;
+
+                for (uint32_t channel = 0; channel < 4; channel++)
+                {
+                    sums[channel] += isSRGB && channel < 3 ? toLinear(pixel[channel]) : pixel[channel] / 255.f;
+                }
+            }
+
+            uint8_t* output = next.data() + (static_cast<size_t>(y) * nextWidth + x) * 4;
+
+            for (uint32_t channel = 0; channel < 4; channel++)
+            {
+                float average = sums[channel] / 4.f;
+                output[channel] = isSRGB && channel < 3 ? toSRGB(average) : static_cast<uint8_t>(std::lround(average * 255.f));
+            }
+        }
+    }
+
+    return next;
+}
+
+static bool parseFormat(const std::string& name, BlockCompression::Format& format)
+{
+    const std::pair<const char*, BlockCompression::Format> formats[] = {
+        { "bc1", BlockCompression::Format::BC1 },
+        { "bc3", BlockCompression::Format::BC3 },
+        { "bc5", BlockCompression::Format::BC5 },
+        { "bc7", BlockCompression::Format::BC7 }
+    };
+
+    for (auto& [formatName, value] : formats)
+    {
+        if (name == formatName)
+        {
+            format = value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Converts images into block compressed .ktx2 files with their mip chains, which Texture2D::create() and
+// Assets::loadAsync<Texture2D>() load without decoding anything. Rows are stored bottom first, the way the engine
+// flips images for OpenGL. The written file is decoded again and compared against the source:
+//   TextureTool [--format bc1|bc3|bc5|bc7] [--linear] [--no-mips] [--min-psnr <dB>] <input image> <output.ktx2>
+// --linear is for data rather than color, such as normal or roughness maps. BC5 keeps red and green and is always linear.
+// With --min-psnr, the tool fails if a compared channel of the largest level is below it.
+int main(int argc, char** argv)
+{
+    BlockCompression::Format format = BlockCompression::Format::BC7;
+    bool isSRGB = true;
+    bool mipmaps = true;
+    double minimumPSNR = 0.0;
+
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if (argument == "--format" && i + 1 < argc)
+        {
+            if (!parseFormat(argv[++i], format))
+            {
+                std::cout << "Unknown format: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+        else if (argument == "--min-psnr" && i + 1 < argc)
+        {
+            minimumPSNR = std::atof(argv[++i]);
+        }
+        else if (argument == "--linear")
+        {
+            isSRGB = false;
+        }
+        else if (argument == "--no-mips")
+        {
+            mipmaps = false;
+        }
+        else
+        {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.size() != 2 || paths[1].substr(paths[1].find_last_of(".") + 1) != "ktx2")
+    {
+        std::cout << "Usage: TextureTool [--format bc1|bc3|bc5|bc7] [--linear] [--no-mips] [--min-psnr <dB>] <input image> <output.ktx2>\n";
+        return 1;
+    }
+
+    if (format == BlockCompression::Format::BC5)
+    {
+        isSRGB = false;
+    }
+
+    Timer timer;
+
+    auto image = Image::create(paths[0], true);
+
+    if (!image->getData() || paths[0].substr(paths[0].find_last_of(".") + 1) == "hdr")
+    {
+        std::cout << "Could not load an 8 bit image from " << paths[0] << "\n";
+        return 1;
+    }
+
+    uint32_t width = image->getWidth();
+    uint32_t height = image->getHeight();
+
+    auto compressed = CompressedImage::create(format, width, height, isSRGB, true);
+
+    std::vector<uint8_t> source = toRGBA(*image);
+    std::vector<uint8_t> pixels = source;
+    std::vector<uint8_t> blocks;
+
+    uint32_t levelWidth = width, levelHeight = height;
+
+    while (true)
+    {
+        blocks.resize(BlockCompression::getSize(format, levelWidth, levelHeight));
+        BlockCompression::encode(format, pixels.data(), levelWidth, levelHeight, blocks.data());
+        compressed->addLevel(blocks.data());
+
+        if (!mipmaps || (levelWidth == 1 && levelHeight == 1))
+        {
+            break;
+        }
+
+        pixels = downsample(pixels, levelWidth, levelHeight, isSRGB);
+        levelWidth = std::max(levelWidth / 2, 1u);
+        levelHeight = std::max(levelHeight / 2, 1u);
+    }
+
+    if (!compressed->saveKTX2(paths[1]))
+    {
+        std::cout << "Could not write " << paths[1] << "\n";
+        return 1;
+    }
+
+    std::cout << "Encoded " << paths[0] << " (" << width << "x" << height << ", " << compressed->getLevelCount() << " levels) into "
+              << paths[1] << ": " << source.size() << " -> " << compressed->getSize() << " bytes in " << timer.getMillis() << "ms\n";
+
+    // Decodes the written file, not the encoder's output in memory, so a file that fails to load fails here too
+    auto written = CompressedImage::create(paths[1], true);
+    std::vector<uint8_t> decoded(source.size());
+
+    if (!written->getData() || !BlockCompression::decode(format, written->getLevelData(0), width, height, decoded.data()))
+    {
+        std::cout << "Could not decode " << paths[1] << "\n";
+        return 1;
+    }
+
+    const char* channelNames = "RGBA";
+    uint32_t channels = format == BlockCompression::Format::BC1 ? 3 : format == BlockCompression::Format::BC5 ? 2 : 4;
+    bool passed = true;
+
+    std::cout << "PSNR of the largest level:";
+
+    for (uint32_t channel = 0; channel < channels; channel++)
+    {
+        double error = 0.0;
+
+        for (size_t i = channel; i < source.size(); i += 4)
+        {
+            double difference = static_cast<double>(source[i]) - decoded[i];
+            error += difference * difference;
+        }
+
+        error /= static_cast<double>(source.size() / 4);
+
+        double psnr = error > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / error) : INFINITY;
+        passed = passed && psnr >= minimumPSNR;
+
+        std::cout << " " << channelNames[channel] << " " << psnr << "dB";
+    }
+
+    std::cout << "\n";
+
+    if (!passed)
+    {
+        std::cout << "Below the minimum of " << minimumPSNR << "dB\n";
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
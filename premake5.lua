@@ -4,4 +4,7 @@ workspace "Game_Engine"
 	
 include "Engine"
 include "Sandbox"
-include "Editor"
\ No newline at end of file
+include "Editor"
+include "PackTool"
+include "TextureTool"
+include "Benchmarks"
\ No newline at end of file